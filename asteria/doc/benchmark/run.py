@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# This script compares the CPU time of the benchmark scripts in this
+# directory, as executed by the interpreters in two or more build trees.
+# Each tree shall have been configured and built by `make`, e.g. one with
+# and one without `--enable-threaded-dispatch`. Runs are interleaved, and
+# the best of 11 runs is reported for each script and each tree.
+#
+#   ./asteria/doc/benchmark/run.py  build_loop  build_threaded
+
+import glob, os, resource, subprocess, sys
+
+if len(sys.argv) < 3:
+  sys.exit('usage: %s BUILD_DIR BUILD_DIR...' % sys.argv[0])
+
+trees = sys.argv[1:]
+scripts = sorted(glob.glob(os.path.join(os.path.dirname(os.path.abspath(__file__)), '*.ast')))
+
+def cpu_time():
+  r = resource.getrusage(resource.RUSAGE_CHILDREN)
+  return r.ru_utime + r.ru_stime
+
+for script in scripts:
+  best = [float('inf')] * len(trees)
+  for i in range(11):
+    for k, tree in enumerate(trees):
+      env = dict(os.environ, LD_LIBRARY_PATH=os.path.join(tree, 'lib/.libs'))
+      t = cpu_time()
+      subprocess.run([os.path.join(tree, 'bin/.libs/asteria'), script], env=env, check=True,
+                     stdin=subprocess.DEVNULL, stdout=subprocess.DEVNULL)
+      best[k] = min(best[k], cpu_time() - t)
+
+  print('%-12s' % os.path.basename(script),
+        '  '.join('%s=%.3fs' % (tree, v) for tree, v in zip(trees, best)))
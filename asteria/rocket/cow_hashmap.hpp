@@ -11,6 +11,9 @@
 #include "xallocator.hpp"
 #include "xhashtable.hpp"
 #include <tuple>  // std::forward_as_tuple()
+#ifdef __SSE2__
+#  include <emmintrin.h>  // _mm_cmpeq_epi8()
+#endif
 
 namespace rocket {
 
@@ -401,7 +404,7 @@ class cow_hashmap
         if(!this->m_sth.unique())
           return this->do_deallocate();
 
-        this->m_sth.erase_range_unchecked(0, this->size());
+        this->m_sth.erase_range_unchecked(0, this->bucket_count());
         return *this;
       }
 
@@ -357,9 +357,9 @@ class basic_cow_string
           return ptr;
         }
 
-        // Allocate new storage.
+        // Allocate new storage and copy [`0`,`tpos`) into it.
         storage_handle sth(this->m_sth.as_allocator());
-        ptr = sth.reallocate_more(ptr, tlen, (slen - tlen + n) | n);  // note overflow check
+        ptr = sth.reallocate_more(this->data(), tpos, (slen - tlen + n) | n);  // note overflow check
 
         // Copy [`tpos+tlen`,`size`] into the new storage.
         // Note the null terminator has to be copied as well.
@@ -367,7 +367,7 @@ class basic_cow_string
 
         // Set the new storage up.
         this->m_sth.exchange_with(sth);
-        this->m_ptr = ptr - tlen;
+        this->m_ptr = ptr - tpos;
         this->m_len -= tlen - n;
         return ptr;
       }
@@ -2016,13 +2016,25 @@ struct basic_cow_string<charT, traitsT, allocT>::hash
     using result_type    = size_t;
     using argument_type  = basic_cow_string;
 
-    constexpr
+    // The hash value of a string is cached in its storage if the storage is
+    // shared, until the string is modified. Shared storage cannot be modified
+    // without another call to `mut_data()`, which discards the hash value.
+    // Hash values are 32-bit on all paths, whether cached or not.
     result_type
     operator()(const argument_type& str)
       const noexcept
-      { return details_cow_string::basic_hasher<charT, traitsT>()
-                   .append(str.data(), str.size())
-                   .finish();  }
+      {
+        size_t hval;
+        if(str.m_sth.get_cached_hash(hval, str.m_ptr, str.m_len))
+          return hval;
+
+        hval = details_cow_string::basic_hasher<charT, traitsT>()
+                   .append(str.m_ptr, str.m_len)
+                   .finish();
+
+        str.m_sth.set_cached_hash(str.m_ptr, str.m_len, hval);
+        return hval;
+      }
 
     constexpr
     result_type
@@ -135,18 +135,33 @@ struct basic_storage
     using pointer          = typename allocator_traits<allocator_type>::pointer;
     using size_type        = typename allocator_traits<allocator_type>::size_type;
 
+    // Buckets are followed by an array of tag bytes, one for each bucket.
+    // An empty bucket has a zero tag. A non-empty bucket has a tag whose most
+    // significant bit is set, and whose other bits are taken from the hash
+    // value of its key. Tags allow probing without touching keys. The array is
+    // padded so a group of tags can be loaded from any bucket.
+    static constexpr size_t tag_group_size = 16;
+
     static constexpr
     size_type
     min_nblk_for_nbkt(size_t nbkt)
       noexcept
-      { return (nbkt * sizeof(bucket_type) + sizeof(basic_storage) - 1)
-                    / sizeof(basic_storage) + 1;  }
+      { return (nbkt * (sizeof(bucket_type) + 1) + tag_group_size
+                    + sizeof(basic_storage) - 1) / sizeof(basic_storage) + 1;  }
 
     static constexpr
     size_t
     max_nbkt_for_nblk(size_type nblk)
       noexcept
-      { return (nblk - 1) * sizeof(basic_storage) / sizeof(bucket_type);  }
+      { return ((nblk - 1) * sizeof(basic_storage) <= tag_group_size) ? 0
+                 : ((nblk - 1) * sizeof(basic_storage) - tag_group_size)
+                       / (sizeof(bucket_type) + 1);  }
+
+    static constexpr
+    unsigned char
+    make_tag(size_t hval)
+      noexcept
+      { return static_cast<unsigned char>(0x80 | (hval >> 16 & 0x7F));  }
 
     size_type nblk;
     bucket_type bkts[0];
@@ -165,6 +180,8 @@ struct basic_storage
         size_t nbkts = this->bucket_count();
         for(size_t k = 0;  k != nbkts;  ++k)
           noadl::construct_at(this->bkts + k);
+
+        ::std::memset(this->tags(), 0, nbkts + tag_group_size);
       }
 
     ~basic_storage()
@@ -204,6 +221,16 @@ struct basic_storage
       const noexcept
       { return this->max_nbkt_for_nblk(this->nblk);  }
 
+    const unsigned char*
+    tags()
+      const noexcept
+      { return reinterpret_cast<const unsigned char*>(this->bkts + this->bucket_count());  }
+
+    unsigned char*
+    tags()
+      noexcept
+      { return reinterpret_cast<unsigned char*>(this->bkts + this->bucket_count());  }
+
     template<typename... paramsT>
     pointer
     allocate_value(paramsT&&... params)
@@ -250,19 +277,31 @@ struct basic_storage
         auto eptr = this->bkts + this->bucket_count();
 
         // Find an empty bucket for the new element.
-        auto orig = noadl::get_probing_origin(bptr, eptr, this->hash(qval->first));
+        size_t hval = this->hash(qval->first);
+        auto orig = noadl::get_probing_origin(bptr, eptr, hval);
         auto qbkt = noadl::linear_probe(bptr, orig, orig, eptr,
                                         [&](const bucket_type&) { return false;  });
         ROCKET_ASSERT(qbkt);
 
         // Insert it into the new bucket.
-        return this->adopt_value_unchecked(static_cast<size_t>(qbkt - bptr), qval);
+        return this->adopt_value_unchecked(static_cast<size_t>(qbkt - bptr), qval, hval);
       }
 
     // This function does not check for duplicate keys.
     // The bucket must be empty prior to this call.
     bucket_type*
     adopt_value_unchecked(size_t k, pointer qval)
+      noexcept
+      {
+        ROCKET_ASSERT(qval);
+        return this->adopt_value_unchecked(k, qval, this->hash(qval->first));
+      }
+
+    // This function does not check for duplicate keys.
+    // The bucket must be empty prior to this call. `hval` shall be the hash
+    // value of the key of `*qval`.
+    bucket_type*
+    adopt_value_unchecked(size_t k, pointer qval, size_t hval)
       noexcept
       {
         ROCKET_ASSERT(!this->bkts[k]);
@@ -271,6 +310,7 @@ struct basic_storage
 
         // Insert the value into this bucket.
         this->bkts[k].exchange(qval);
+        this->tags()[k] = make_tag(hval);
         this->nelem += 1;
         return this->bkts + k;
       }
@@ -284,6 +324,7 @@ struct basic_storage
 
         // Try extracting an element.
         auto qval = this->bkts[k].exchange(nullptr);
+        this->tags()[k] = 0;
         this->nelem -= bool(qval);
         return qval;
       }
@@ -595,25 +636,68 @@ class storage_handle
           return nullptr;
 
         auto bptr = qstor->bkts;
-        auto eptr = qstor->bkts + qstor->bucket_count();
+        size_t nbkt = qstor->bucket_count();
+        auto tags = qstor->tags();
 
         // Find an equivalent key using linear probing.
         // The load factor is kept below 0.5 so there is always at least one bucket available.
-        auto orig = noadl::get_probing_origin(bptr, eptr, qstor->hash(ykey));
-        auto qbkt = noadl::linear_probe(bptr, orig, orig, eptr,
-                        [&](const bucket_type& r) { return this->as_key_equal()(r->first, ykey);  });
-
         static_assert(max_load_factor_reciprocal > 1, "");
-        ROCKET_ASSERT(qbkt);
-        tpos = static_cast<size_type>(qbkt - bptr);
-
-        // If probing stopped due to an empty bucket, there is no equivalent key.
-        if(!*qbkt)
-          return nullptr;
+        size_t hval = qstor->hash(ykey);
+        size_t k = static_cast<size_t>(noadl::get_probing_origin(bptr, bptr + nbkt, hval) - bptr);
+        auto tag = storage::make_tag(hval);
+
+        for(;;) {
+          // Compare a group of tags. Bits in `mmatch` denote buckets whose tags
+          // match `tag`, and bits in `mempty` denote empty buckets.
+          size_t ngrp = noadl::min(nbkt - k, storage::tag_group_size);
+          uint32_t mmatch = 0;
+          uint32_t mempty = 0;
+#ifdef __SSE2__
+          auto xtags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + k));
+          mmatch = static_cast<uint32_t>(_mm_movemask_epi8(
+                       _mm_cmpeq_epi8(xtags, _mm_set1_epi8(static_cast<char>(tag)))));
+          mempty = static_cast<uint32_t>(_mm_movemask_epi8(
+                       _mm_cmpeq_epi8(xtags, _mm_setzero_si128())));
+
+          // Discard tags past the end of the table.
+          uint32_t mlimit = static_cast<uint32_t>((1ULL << ngrp) - 1);
+          mmatch &= mlimit;
+          mempty &= mlimit;
+#else
+          for(size_t i = 0;  i != ngrp;  ++i) {
+            mmatch |= static_cast<uint32_t>(tags[k + i] == tag) << i;
+            mempty |= static_cast<uint32_t>(tags[k + i] == 0) << i;
+          }
+#endif
 
-        // Report that an element has been found.
-        // The bucket index is returned via `tpos`.
-        return qbkt;
+          // An equivalent key must precede the first empty bucket.
+          if(mempty)
+            mmatch &= (mempty & -mempty) - 1;
+
+          while(mmatch) {
+            size_t i = static_cast<size_t>(ROCKET_TZCNT32_NZ(mmatch));
+            mmatch &= mmatch - 1;
+
+            // Report that an element has been found.
+            // The bucket index is returned via `tpos`.
+            if(this->as_key_equal()(bptr[k + i]->first, ykey)) {
+              tpos = static_cast<size_type>(k + i);
+              return bptr + k + i;
+            }
+          }
+
+          // If probing stopped due to an empty bucket, there is no equivalent key.
+          // The index of the empty bucket is returned via `tpos`.
+          if(mempty) {
+            tpos = static_cast<size_type>(k + static_cast<size_t>(ROCKET_TZCNT32_NZ(mempty)));
+            return nullptr;
+          }
+
+          // Go to the next group, wrapping around as necessary.
+          k += ngrp;
+          if(k == nbkt)
+            k = 0;
+        }
       }
 
     template<typename ykeyT, typename... paramsT>
@@ -659,9 +743,8 @@ class storage_handle
           qstor->bkts + qstor->bucket_count(),
           [&](bucket_type& r) {
             // Clear this bucket temporarily.
-            auto qval = r.exchange(nullptr);
+            auto qval = qstor->extract_value_opt(static_cast<size_t>(&r - qstor->bkts));
             ROCKET_ASSERT(qval);
-            qstor->nelem -= 1;
 
             // Insert it back.
             qstor->adopt_value_unchecked(qval);
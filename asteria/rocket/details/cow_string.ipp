@@ -11,10 +11,15 @@ struct storage_header
   {
     mutable reference_counter<long> nref;
 
+    // This caches the hash value of the string which begins at the start of
+    // this storage. The high-order half is the length of the string plus one,
+    // and the low-order half is the hash value. Zero means nothing is cached.
+    mutable ::std::atomic<uint64_t> hcache;
+
     explicit
     storage_header()
       noexcept
-      : nref()
+      : nref(), hcache(0)
       { }
   };
 
@@ -238,9 +243,45 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor || !qstor->nref.unique())
           return nullptr;
+
+        // The caller may modify the string, so the hash value is discarded.
+        qstor->hcache.store(0, ::std::memory_order_relaxed);
         return qstor->data;
       }
 
+    bool
+    get_cached_hash(size_t& hval, const value_type* ptr, size_type len)
+      const noexcept
+      {
+        // Only strings which begin at the start of the storage are cached.
+        // Unique storage is not checked, as it may have been modified through
+        // pointers and iterators that were obtained earlier.
+        auto qstor = this->m_qstor;
+        if(!qstor || qstor->nref.unique() || (ptr != qstor->data))
+          return false;
+
+        uint64_t hcache = qstor->hcache.load(::std::memory_order_relaxed);
+        if((hcache >> 32) != static_cast<uint64_t>(len) + 1)
+          return false;
+
+        hval = static_cast<uint32_t>(hcache);
+        return true;
+      }
+
+    void
+    set_cached_hash(const value_type* ptr, size_type len, size_t hval)
+      const noexcept
+      {
+        // Unique storage may still be modified through pointers and iterators
+        // that were obtained earlier, so the value is not cached there.
+        auto qstor = this->m_qstor;
+        if(!qstor || qstor->nref.unique() || (ptr != qstor->data) || (len >= 0xFFFFFFFF))
+          return;
+
+        uint64_t hcache = (static_cast<uint64_t>(len) + 1) << 32 | static_cast<uint32_t>(hval);
+        qstor->hcache.store(hcache, ::std::memory_order_relaxed);
+      }
+
     ROCKET_NOINLINE
     value_type*
     reallocate_more(const value_type* src, size_type len, size_type add)
@@ -280,8 +321,13 @@ class storage_handle
       noexcept
       {
         auto qstor = other.m_qstor;
-        if(qstor)
+        if(qstor) {
+          // Unique storage may have been modified since its hash value was
+          // cached, so the hash value is discarded before it becomes shared.
+          if(qstor->nref.unique())
+            qstor->hcache.store(0, ::std::memory_order_relaxed);
           qstor->nref.increment();
+        }
         this->do_reset(qstor);
       }
 
@@ -329,15 +375,57 @@ struct comparator
       }
   };
 
-// Implement the FNV-1a hash algorithm.
+// Implement a word-at-a-time hash algorithm. Characters are packed into 64-bit
+// words, which are mixed into the state with a rotation and a multiplication.
+// The state is finalized with the MurmurHash3 mixer. The result is truncated to
+// 32 bits, so it can be cached along with the length of a string.
 template<typename charT, typename traitsT>
 class basic_hasher
   {
+    static_assert(sizeof(charT) <= 8, "Character type too large");
+
+  private:
+    static constexpr uint64_t xoffset = 0xCBF29CE484222325;
+    static constexpr uint64_t xprime = 0x9E3779B97F4A7C15;
+    static constexpr size_t xbits = sizeof(charT) * 8;
+    static constexpr uint64_t xmask = (xbits >= 64) ? UINT64_MAX : (1ULL << xbits % 64) - 1;
+    static constexpr size_t xwidth = 8 / sizeof(charT);
+
+    uint64_t m_reg = xoffset;
+    uint64_t m_word = 0;
+    size_t m_nchars = 0;  // characters in `m_word`
+    size_t m_len = 0;
+
   private:
-    static constexpr char32_t xoffset = 0x811C9DC5;
-    static constexpr char32_t xprime = 0x1000193;
+    static constexpr
+    uint64_t
+    do_pack(const charT& c, size_t k)
+      noexcept
+      { return (static_cast<uint64_t>(c) & xmask) << (k * xbits % 64);  }
 
-    char32_t m_reg = xoffset;
+    constexpr
+    void
+    do_mix(uint64_t word)
+      noexcept
+      {
+        uint64_t reg = this->m_reg;
+        reg = (reg << 5 | reg >> 59) ^ word;
+        this->m_reg = reg * xprime;
+      }
+
+    constexpr
+    void
+    do_push(const charT& c)
+      noexcept
+      {
+        this->m_word |= do_pack(c, this->m_nchars);
+        if(++(this->m_nchars) != xwidth)
+          return;
+
+        this->do_mix(this->m_word);
+        this->m_word = 0;
+        this->m_nchars = 0;
+      }
 
   public:
     constexpr
@@ -345,13 +433,8 @@ class basic_hasher
     append(const charT& c)
       noexcept
       {
-        char32_t word = static_cast<char32_t>(c);
-        char32_t reg = this->m_reg;
-
-        for(size_t k = 0;  k < sizeof(c);  ++k)
-          reg = (reg ^ ((word >> k * 8) & 0xFF)) * xprime;
-
-        this->m_reg = reg;
+        this->do_push(c);
+        this->m_len += 1;
         return *this;
       }
 
@@ -359,28 +442,61 @@ class basic_hasher
     basic_hasher&
     append(const charT* s, size_t n)
       {
-        for(auto sp = s;  sp != s + n;  ++sp)
-          this->append(*sp);
+        auto sp = s;
+        auto ep = s + n;
+
+        // Complete the current word.
+        while((this->m_nchars != 0) && (sp != ep))
+          this->do_push(*(sp++));
+
+        // Process whole words. Compilers are able to combine these characters
+        // into a single load.
+        while(static_cast<size_t>(ep - sp) >= xwidth) {
+          uint64_t word = 0;
+          for(size_t k = 0;  k != xwidth;  ++k)
+            word |= do_pack(sp[k], k);
+
+          this->do_mix(word);
+          sp += xwidth;
+        }
+
+        // Save remaining characters.
+        while(sp != ep)
+          this->do_push(*(sp++));
+
+        this->m_len += n;
         return *this;
       }
 
     constexpr
     basic_hasher&
     append(const charT* s)
-      {
-        for(auto sp = s;  !traitsT::eq(*sp, charT());  ++sp)
-          this->append(*sp);
-        return *this;
-      }
+      { return this->append(s, traitsT::length(s));  }
 
     constexpr
     size_t
     finish()
       noexcept
       {
-        char32_t reg = this->m_reg;
+        if(this->m_nchars != 0)
+          this->do_mix(this->m_word);
+
+        // Mix the length in, so trailing null characters make a difference.
+        uint64_t reg = this->m_reg ^ this->m_len;
+        reg ^= reg >> 33;
+        reg *= 0xFF51AFD7ED558CCD;
+        reg ^= reg >> 33;
+        reg *= 0xC4CEB9FE1A85EC53;
+        reg ^= reg >> 33;
+
         this->m_reg = xoffset;
-        return reg;
+        this->m_word = 0;
+        this->m_nchars = 0;
+        this->m_len = 0;
+
+        // Hash values are truncated to 32 bits, so they can be cached together
+        // with the length of the string in a single atomic word.
+        return static_cast<uint32_t>(reg);
       }
   };
 
@@ -29,6 +29,121 @@ do_generate_code_branch(const Compiler_Options& opts, PTC_Aware ptc, Analytic_Co
     return code;
   }
 
+using Escape_Operand = Expression_Unit::Escape_Operand;
+
+void
+do_mark_escaping(cow_vector<phsh_string>& names, const phsh_string& name)
+  {
+    if(::rocket::none_of(names, [&](const phsh_string& r) { return r == name;  }))
+      names.emplace_back(name);
+  }
+
+void
+do_mark_escaping(cow_vector<phsh_string>& names, const Escape_Operand& opnd)
+  {
+    for(const auto& name : opnd.names)
+      do_mark_escaping(names, name);
+  }
+
+Escape_Operand
+do_pop_operands(cow_vector<Escape_Operand>& stack, size_t count)
+  {
+    // Merge all operands that are popped, so the result is conservative.
+    Escape_Operand opnd = { { }, false };
+    while(count && !stack.empty()) {
+      for(const auto& name : stack.back().names)
+        do_mark_escaping(opnd.names, name);
+
+      opnd.modified |= stack.back().modified;
+      stack.pop_back();
+      count--;
+    }
+    return opnd;
+  }
+
+void
+do_simulate_branch(cow_vector<phsh_string>& names, cow_vector<Escape_Operand>& stack,
+                   const cow_vector<Expression_Unit>& units, bool captured)
+  {
+    // The result of a branch may be either the condition or the result of the
+    // branch itself.
+    size_t bpos = stack.size();
+    for(const auto& unit : units)
+      unit.collect_escaping_names(names, stack, captured);
+
+    auto opnd = do_pop_operands(stack, stack.size() - bpos);
+    if(stack.empty())
+      return;
+
+    for(const auto& name : opnd.names)
+      do_mark_escaping(stack.mut_back().names, name);
+
+    stack.mut_back().modified |= opnd.modified;
+  }
+
+size_t
+do_get_operand_count(Xop xop)
+  {
+    switch(xop) {
+      case xop_inc_post:
+      case xop_dec_post:
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_inc_pre:
+      case xop_dec_pre:
+      case xop_unset:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_iround:
+      case xop_ifloor:
+      case xop_iceil:
+      case xop_itrunc:
+      case xop_head:
+      case xop_tail:
+        return 1;
+
+      case xop_subscr:
+      case xop_cmp_eq:
+      case xop_cmp_ne:
+      case xop_cmp_lt:
+      case xop_cmp_gt:
+      case xop_cmp_lte:
+      case xop_cmp_gte:
+      case xop_cmp_3way:
+      case xop_add:
+      case xop_sub:
+      case xop_mul:
+      case xop_div:
+      case xop_mod:
+      case xop_sll:
+      case xop_srl:
+      case xop_sla:
+      case xop_sra:
+      case xop_andb:
+      case xop_orb:
+      case xop_xorb:
+      case xop_assign:
+        return 2;
+
+      case xop_fma:
+        return 3;
+
+      default:
+        ASTERIA_TERMINATE("invalid operator type (xop `$1`)", xop);
+    }
+  }
+
 }  // namespace
 
 cow_vector<AIR_Node>&
@@ -64,10 +179,19 @@ generate_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts,
         for(;;) {
           // Look for the name in the current context.
           qref = qctx->get_named_reference_opt(altr.name);
+          if(qref && qctx->is_analytic() && qref->is_temporary()) {
+            // This denotes an immutable variable whose value is known at compile
+            // time, so push a copy of its value.
+            AIR_Node::S_push_bound_reference xnode = { *qref };
+            code.emplace_back(::std::move(xnode));
+            return code;
+          }
+
           if(qref) {
-            // A reference declared later has been found. Record the context depth for
-            // later lookups.
-            AIR_Node::S_push_local_reference xnode = { altr.sloc, depth, altr.name };
+            // A reference declared later has been found. Record the context depth and
+            // its slot index for later lookups.
+            uint32_t slot = qctx->get_named_reference_slot(altr.name);
+            AIR_Node::S_push_local_reference xnode = { altr.sloc, depth, slot, altr.name };
             code.emplace_back(::std::move(xnode));
             return code;
           }
@@ -144,7 +268,13 @@ generate_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts,
 
         // Encode arguments.
         AIR_Node::S_apply_operator xnode = { altr.sloc, altr.xop, altr.assign };
-        code.emplace_back(::std::move(xnode));
+        AIR_Node node = ::std::move(xnode);
+
+        // If all operands are constants, try evaluating it at compile time.
+        if((opts.optimization_level >= 2) && node.fold_constant(code))
+          return code;
+
+        code.emplace_back(::std::move(node));
         return code;
       }
 
@@ -227,4 +357,153 @@ generate_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts,
     }
   }
 
+cow_vector<phsh_string>&
+Expression_Unit::
+collect_escaping_names(cow_vector<phsh_string>& names, cow_vector<Escape_Operand>& stack,
+                       bool captured)
+  const
+  {
+    switch(this->index()) {
+      case index_literal:
+      case index_global_reference:
+        // These never refer to local references.
+        stack.push_back({ { }, false });
+        return names;
+
+      case index_local_reference: {
+        const auto& altr = this->m_stor.as<index_local_reference>();
+
+        // Record the name for later use.
+        if(captured)
+          do_mark_escaping(names, altr.name);
+
+        stack.push_back({ { altr.name }, false });
+        return names;
+      }
+
+      case index_closure_function: {
+        const auto& altr = this->m_stor.as<index_closure_function>();
+
+        // All names that are referenced by the closure may be captured.
+        for(const auto& stmt : altr.body)
+          stmt.collect_escaping_names(names, true);
+
+        stack.push_back({ { }, false });
+        return names;
+      }
+
+      case index_branch: {
+        const auto& altr = this->m_stor.as<index_branch>();
+
+        // Either branch may be evaluated.
+        auto temp = stack;
+        do_simulate_branch(names, stack, altr.branch_true, captured);
+        do_simulate_branch(names, temp, altr.branch_false, captured);
+        if(!stack.empty() && !temp.empty()) {
+          for(const auto& name : temp.back().names)
+            do_mark_escaping(stack.mut_back().names, name);
+
+          stack.mut_back().modified |= temp.back().modified;
+        }
+        return names;
+      }
+
+      case index_function_call: {
+        const auto& altr = this->m_stor.as<index_function_call>();
+
+        // Arguments have been handled by `S_argument_finish`. If the target
+        // is a member or an element, its parent will be bound to `this`.
+        do_pop_operands(stack, altr.nargs);
+        auto opnd = do_pop_operands(stack, 1);
+        if(opnd.modified)
+          do_mark_escaping(names, opnd);
+
+        stack.push_back({ { }, false });
+        return names;
+      }
+
+      case index_member_access:
+        // The result refers to a member of the operand.
+        if(!stack.empty())
+          stack.mut_back().modified = true;
+        return names;
+
+      case index_operator_rpn: {
+        const auto& altr = this->m_stor.as<index_operator_rpn>();
+
+        // Some operators return references to their first operands. For
+        // simplicity, this is assumed for all operators.
+        size_t nops = do_get_operand_count(altr.xop);
+        do_pop_operands(stack, nops - 1);
+        if(!stack.empty())
+          stack.mut_back().modified |= ::rocket::is_any_of(altr.xop,
+                                          { xop_subscr, xop_head, xop_tail });
+        return names;
+      }
+
+      case index_unnamed_array: {
+        const auto& altr = this->m_stor.as<index_unnamed_array>();
+
+        // Elements are copied.
+        do_pop_operands(stack, altr.nelems);
+        stack.push_back({ { }, false });
+        return names;
+      }
+
+      case index_unnamed_object: {
+        const auto& altr = this->m_stor.as<index_unnamed_object>();
+
+        // Values are copied.
+        do_pop_operands(stack, altr.keys.size());
+        stack.push_back({ { }, false });
+        return names;
+      }
+
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+
+        // The branch may be evaluated.
+        do_simulate_branch(names, stack, altr.branch_null, captured);
+        return names;
+      }
+
+      case index_variadic_call: {
+        // The generator is called with no argument, and the target is called
+        // with `this` like a normal function call.
+        auto opnd = do_pop_operands(stack, 2);
+        if(opnd.modified)
+          do_mark_escaping(names, opnd);
+
+        stack.push_back({ { }, false });
+        return names;
+      }
+
+      case index_argument_finish: {
+        const auto& altr = this->m_stor.as<index_argument_finish>();
+
+        // Arguments that are passed by reference may be bound to anything.
+        if(stack.empty())
+          return names;
+
+        if(altr.by_ref)
+          do_mark_escaping(names, stack.back());
+        else
+          stack.mut_back() = { { }, false };
+        return names;
+      }
+
+      case index_import_call: {
+        const auto& altr = this->m_stor.as<index_import_call>();
+
+        // Arguments have been handled by `S_argument_finish`.
+        do_pop_operands(stack, altr.nargs);
+        stack.push_back({ { }, false });
+        return names;
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid expression unit type (index `$1`)", this->index());
+    }
+  }
+
 }  // namespace asteria
@@ -101,6 +101,13 @@ class Expression_Unit
         uint32_t nargs;
       };
 
+    // This is an element in a simulated stack for escape analysis.
+    struct Escape_Operand
+      {
+        cow_vector<phsh_string> names;  // local references it may refer to
+        bool modified;  // whether it refers to a member or an element
+      };
+
     enum Index : uint8_t
       {
         index_literal           =  0,
@@ -177,6 +184,14 @@ class Expression_Unit
     generate_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts,
                   Analytic_Context& ctx, PTC_Aware ptc)
       const;
+
+    // Simulates the evaluation of this unit on `stack`. Names of local references
+    // that may escape from the current function are appended to `names`. If
+    // `captured` is set, all names that are referenced are considered escaping.
+    cow_vector<phsh_string>&
+    collect_escaping_names(cow_vector<phsh_string>& names, cow_vector<Escape_Operand>& stack,
+                           bool captured)
+      const;
   };
 
 inline
@@ -25,8 +25,9 @@ do_user_declare(cow_vector<phsh_string>* names_opt, Analytic_Context& ctx,
     if(names_opt && !::rocket::find(*names_opt, name))
       names_opt->emplace_back(name);
 
-    // Just ensure the name exists.
-    ctx.open_named_reference(name) /*= Reference::S_uninit()*/;
+    // Ensure the name exists. If a constant has been recorded for it, it is
+    // overwritten.
+    ctx.open_named_reference(name).set_uninit();
   }
 
 cow_vector<AIR_Node>&
@@ -121,6 +122,30 @@ do_generate_block(const Compiler_Options& opts, PTC_Aware ptc, Analytic_Context&
     return code;
   }
 
+void
+do_collect_escaping_names(cow_vector<phsh_string>& names, bool captured, bool by_ref,
+                          const Statement::S_expression& expr)
+  {
+    // Simulate the evaluation of the expression.
+    cow_vector<Expression_Unit::Escape_Operand> stack;
+    for(const auto& unit : expr.units)
+      unit.collect_escaping_names(names, stack, captured);
+
+    // If the result is bound by reference, it escapes.
+    if(by_ref && !stack.empty())
+      for(const auto& name : stack.back().names)
+        if(!::rocket::find(names, name))
+          names.emplace_back(name);
+  }
+
+void
+do_collect_escaping_names(cow_vector<phsh_string>& names, bool captured,
+                          const Statement::S_block& block)
+  {
+    for(const auto& stmt : block.stmts)
+      stmt.collect_escaping_names(names, captured);
+  }
+
 }  // namespace
 
 cow_vector<AIR_Node>&
@@ -190,7 +215,8 @@ generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
             // If no initializer is provided, no further initialization is required.
             for(size_t k = bpos;  k < epos;  ++k) {
               AIR_Node::S_define_null_variable xnode = { altr.immutable, altr.slocs[i],
-                                                         altr.decls[i][k] };
+                                                         altr.decls[i][k],
+                                                         ctx.is_escaping(altr.decls[i][k]) };
               code.emplace_back(::std::move(xnode));
             }
           }
@@ -200,12 +226,14 @@ generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
 
             // Push uninitialized variables from left to right.
             for(size_t k = bpos;  k < epos;  ++k) {
-              AIR_Node::S_declare_variable xnode = { altr.slocs[i], altr.decls[i][k] };
+              AIR_Node::S_declare_variable xnode = { altr.slocs[i], altr.decls[i][k],
+                                                     ctx.is_escaping(altr.decls[i][k]) };
               code.emplace_back(::std::move(xnode));
             }
 
             // Generate code for the initializer.
             // Note: Do not destroy the stack.
+            size_t cpos = code.size();
             do_generate_subexpression(code, opts, ptc_aware_none, ctx, altr.inits[i]);
 
             // Initialize variables.
@@ -222,6 +250,15 @@ generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
             else {
               AIR_Node::S_initialize_variable xnode = { altr.slocs[i], altr.immutable };
               code.emplace_back(::std::move(xnode));
+
+              // If an immutable variable is initialized with a constant, record its
+              // value, so references to it can be replaced with copies of it. This
+              // is not done in `switch` clauses, where its initialization may be
+              // bypassed.
+              if(altr.immutable && !names_opt && (opts.optimization_level >= 2)
+                 && (code.size() == cpos + 2))
+                if(auto qval = code[cpos].get_constant_opt())
+                  ctx.open_named_reference(altr.decls[i][bpos]).set_temporary(*qval);
             }
           }
         }
@@ -235,7 +272,8 @@ generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
         do_user_declare(names_opt, ctx, altr.name);
 
         // Declare the function, which is effectively an immutable variable.
-        AIR_Node::S_declare_variable xnode_decl = { altr.sloc, altr.name };
+        AIR_Node::S_declare_variable xnode_decl = { altr.sloc, altr.name,
+                                                    ctx.is_escaping(altr.name) };
         code.emplace_back(::std::move(xnode_decl));
 
         // Generate code
@@ -295,10 +333,12 @@ generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
         ROCKET_ASSERT(nclauses == altr.bodies.size());
 
         for(size_t i = 0;  i < nclauses;  ++i) {
-          // Generate code for the label.
+          // Generate code for the label. The `default` label is denoted by empty
+          // code, as it shall not be evaluated.
           // Note labels are not part of the body.
-          do_generate_expression(code_labels.emplace_back(), opts, ptc_aware_none, ctx,
-                                 altr.labels[i]);
+          auto& code_label = code_labels.emplace_back();
+          if(!altr.labels[i].units.empty())
+            do_generate_expression(code_label, opts, ptc_aware_none, ctx, altr.labels[i]);
 
           // Generate code for the clause and accumulate names.
           // This cannot be PTC'd.
@@ -585,4 +625,152 @@ generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
     }
   }
 
+cow_vector<phsh_string>&
+Statement::
+collect_escaping_names(cow_vector<phsh_string>& names, bool captured)
+  const
+  {
+    switch(this->index()) {
+      case index_expression: {
+        const auto& altr = this->m_stor.as<index_expression>();
+
+        do_collect_escaping_names(names, captured, false, altr);
+        return names;
+      }
+
+      case index_block: {
+        const auto& altr = this->m_stor.as<index_block>();
+
+        do_collect_escaping_names(names, captured, altr);
+        return names;
+      }
+
+      case index_variables: {
+        const auto& altr = this->m_stor.as<index_variables>();
+
+        // Initializers are copied into variables.
+        for(const auto& init : altr.inits)
+          do_collect_escaping_names(names, captured, false, init);
+        return names;
+      }
+
+      case index_function: {
+        const auto& altr = this->m_stor.as<index_function>();
+
+        // All names that are referenced by the function may be captured.
+        for(const auto& stmt : altr.body)
+          stmt.collect_escaping_names(names, true);
+        return names;
+      }
+
+      case index_if: {
+        const auto& altr = this->m_stor.as<index_if>();
+
+        do_collect_escaping_names(names, captured, false, altr.cond);
+        do_collect_escaping_names(names, captured, altr.branch_true);
+        do_collect_escaping_names(names, captured, altr.branch_false);
+        return names;
+      }
+
+      case index_switch: {
+        const auto& altr = this->m_stor.as<index_switch>();
+
+        do_collect_escaping_names(names, captured, false, altr.ctrl);
+        for(const auto& label : altr.labels)
+          do_collect_escaping_names(names, captured, false, label);
+        for(const auto& body : altr.bodies)
+          do_collect_escaping_names(names, captured, body);
+        return names;
+      }
+
+      case index_do_while: {
+        const auto& altr = this->m_stor.as<index_do_while>();
+
+        do_collect_escaping_names(names, captured, altr.body);
+        do_collect_escaping_names(names, captured, false, altr.cond);
+        return names;
+      }
+
+      case index_while: {
+        const auto& altr = this->m_stor.as<index_while>();
+
+        do_collect_escaping_names(names, captured, false, altr.cond);
+        do_collect_escaping_names(names, captured, altr.body);
+        return names;
+      }
+
+      case index_for_each: {
+        const auto& altr = this->m_stor.as<index_for_each>();
+
+        // The mapped reference may refer to an element of the range.
+        do_collect_escaping_names(names, captured, true, altr.init);
+        do_collect_escaping_names(names, captured, altr.body);
+        return names;
+      }
+
+      case index_for: {
+        const auto& altr = this->m_stor.as<index_for>();
+
+        do_collect_escaping_names(names, captured, altr.init);
+        do_collect_escaping_names(names, captured, false, altr.cond);
+        do_collect_escaping_names(names, captured, false, altr.step);
+        do_collect_escaping_names(names, captured, altr.body);
+        return names;
+      }
+
+      case index_try: {
+        const auto& altr = this->m_stor.as<index_try>();
+
+        do_collect_escaping_names(names, captured, altr.body_try);
+        do_collect_escaping_names(names, captured, altr.body_catch);
+        return names;
+      }
+
+      case index_break:
+      case index_continue:
+        return names;
+
+      case index_throw: {
+        const auto& altr = this->m_stor.as<index_throw>();
+
+        do_collect_escaping_names(names, captured, false, altr.expr);
+        return names;
+      }
+
+      case index_return: {
+        const auto& altr = this->m_stor.as<index_return>();
+
+        // A reference that is returned may be bound by the caller.
+        do_collect_escaping_names(names, captured, altr.by_ref, altr.expr);
+        return names;
+      }
+
+      case index_assert: {
+        const auto& altr = this->m_stor.as<index_assert>();
+
+        do_collect_escaping_names(names, captured, false, altr.expr);
+        return names;
+      }
+
+      case index_defer: {
+        const auto& altr = this->m_stor.as<index_defer>();
+
+        do_collect_escaping_names(names, captured, false, altr.expr);
+        return names;
+      }
+
+      case index_references: {
+        const auto& altr = this->m_stor.as<index_references>();
+
+        // Named references are bound by reference.
+        for(const auto& init : altr.inits)
+          do_collect_escaping_names(names, captured, true, init);
+        return names;
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid statement type (index `$1`)", this->index());
+    }
+  }
+
 }  // namespace asteria
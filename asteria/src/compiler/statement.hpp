@@ -233,6 +233,13 @@ class Statement
     generate_code(cow_vector<AIR_Node>& code, cow_vector<phsh_string>* names_opt,
                   Analytic_Context& ctx, const Compiler_Options& opts, PTC_Aware ptc)
       const;
+
+    // Appends names of local variables that may escape from the current function
+    // to `names`. If `captured` is set, all names that are referenced are
+    // considered escaping.
+    cow_vector<phsh_string>&
+    collect_escaping_names(cow_vector<phsh_string>& names, bool captured)
+      const;
   };
 
 inline
@@ -45,34 +45,84 @@ struct Metadata
     Relocator* reloc_opt;  // if null then bitwise copy is performed
     Destructor* dtor_opt;  // if null then no cleanup is performed
     Enumerator* enum_opt;  // if null then no variable shall exist
-    Executor* exec;        // executor function, must not be null
 
     // Version 2
     Source_Location syms;  // symbols
   };
 
+// These are ways to dispatch a node. The status of a node is only checked if
+// it may divert control flow.
+enum Dispatch : uint8_t
+  {
+    dispatch_end      = 0,  // no node
+    dispatch_plain    = 1,  // always returns `air_status_next`
+    dispatch_checked  = 2,  // may return other status codes
+  };
+
 // This is the header of each variable-length element that is stored in an AVMC
 // queue. User-defined data may immediate follow this struct, so the size of
 // this struct has to be a multiple of `alignof(max_align_t)`.
+// The executor is always stored in the header, so nodes can be dispatched
+// without looking at their metadata. If `meta_ver` is non-zero, a pointer to
+// the metadata is stored in the last bytes of the node, after `sparam`.
+// An executor may replace itself with another one that takes the same `uparam`
+// and `sparam`, so nodes can be specialized according to what they see. As the
+// node may be executed by other threads at the same time, the executor is only
+// loaded and stored atomically after the node has been appended.
+// Each node also denotes how its successor shall be dispatched, so threaded
+// execution needn't compare against the end of the queue.
 struct Header
   {
     union {
       struct {
         uint8_t nheaders;  // size of `sparam`, in number of headers [!]
-        uint8_t meta_ver;  // version of `Metadata`; `pv_meta` active
+        uint8_t meta_ver : 2;  // version of `Metadata`; zero if none
+        uint8_t disp : 2;  // how this node is dispatched
+        uint8_t disp_next : 2;  // how the next node is dispatched
       };
       Uparam uparam;
     };
 
-    union {
-      Executor* pv_exec;  // executor function
-      Metadata* pv_meta;
-    };
+    mutable Executor* exec;  // executor function, must not be null
 
     max_align_t align[0];
     char sparam[0];
   };
 
+inline
+Executor*
+do_load_executor(const Header* head)
+  noexcept
+  {
+    return __atomic_load_n(&(head->exec), __ATOMIC_RELAXED);
+  }
+
+inline
+void
+do_store_executor(const Header* head, Executor* exec)
+  noexcept
+  {
+    __atomic_store_n(&(head->exec), exec, __ATOMIC_RELAXED);
+  }
+
+inline
+Metadata*&
+do_get_metadata(Header* head)
+  noexcept
+  {
+    ROCKET_ASSERT(head->meta_ver);
+    return reinterpret_cast<Metadata**>(head + 1 + head->nheaders)[-1];
+  }
+
+inline
+Metadata*
+do_get_metadata(const Header* head)
+  noexcept
+  {
+    ROCKET_ASSERT(head->meta_ver);
+    return reinterpret_cast<Metadata* const*>(head + 1 + head->nheaders)[-1];
+  }
+
 template<typename SparamT>
 inline
 void
@@ -105,6 +155,8 @@ do_call_enumerate_variables(Variable_Callback& callback, const Header* head)
 template<typename SparamT, typename = void>
 struct select_enumerate_variables
   {
+    static constexpr bool value = false;
+
     constexpr operator
     Enumerator*()
       const noexcept
@@ -117,6 +169,8 @@ struct select_enumerate_variables<SparamT,
         ::std::declval<const SparamT&>().enumerate_variables(
             ::std::declval<Variable_Callback&>())))>
   {
+    static constexpr bool value = true;
+
     constexpr operator
     Enumerator*()
       const noexcept
@@ -138,6 +192,12 @@ struct Sparam_traits
 
     static constexpr Enumerator* enum_opt =
         select_enumerate_variables<SparamT>();
+
+    // This is tested instead of the pointers above, as comparing the address
+    // of a function against null causes warnings.
+    static constexpr bool trivial =
+        ::std::is_trivial<SparamT>::value
+        && !select_enumerate_variables<SparamT>::value;
   };
 
 template<typename XSparamT>
@@ -8,24 +8,46 @@
 namespace asteria {
 namespace details_reference_dictionary {
 
-struct Bucket
+struct Slot
   {
-    Bucket* next;  // the next bucket in the [non-circular] list
-    Bucket* prev;  // the previous bucket in the [circular] list
-    union { phsh_string kstor[1];  };  // initialized iff `prev` is non-null
-    union { Reference vstor[1];  };  // initialized iff `prev` is non-null
+    phsh_string name;
+    Reference ref;
 
-    Bucket()
+    explicit
+    Slot(const phsh_string& xname)
+      : name(xname)
       { }
+  };
 
-    ~Bucket()
-      { }
+struct Bucket
+  {
+    uint32_t ind1;  // one plus the index of the slot; zero if empty
 
     explicit operator
     bool()
       const noexcept
-      { return this->prev != nullptr;  }
+      { return this->ind1 != 0;  }
   };
 
+inline
+bool
+do_name_equals(const phsh_string& lhs, const phsh_string& rhs)
+  noexcept
+  {
+    // This handwritten bytewise comparison prevents unnecessary pushs and
+    // pops in the prolog and epilog of callers.
+    if(lhs.length() != rhs.length())
+      return false;
+
+    if(lhs.data() == rhs.data())
+      return true;
+
+    if(lhs.rdhash() != rhs.rdhash())
+      return false;
+
+    return ::std::equal(lhs.data(), lhs.data() + lhs.length(),
+                        static_cast<const volatile char*>(rhs.data()));
+  }
+
 }  // namespace details_reference_dictionary
 }  // namespace asteria
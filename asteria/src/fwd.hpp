@@ -147,6 +147,7 @@ class Simple_Script;
 
 // Low-level data structures
 class Variable_HashSet;
+class Variable_Pool;
 class Reference_Dictionary;
 class Reference_Stack;
 class AVMC_Queue;
@@ -169,9 +170,14 @@ class Global_Context;
 class Genius_Collector;
 class Random_Engine;
 class Loader_Lock;
+class Module_Cache;
+class Thread_Pool;
 class Variadic_Arguer;
 class Instantiated_Function;
+class Prepared_Call;
 class AIR_Node;
+class AIR_Bytecode_Writer;
+class AIR_Bytecode_Reader;
 class Backtrace_Frame;
 class Argument_Reader;
 
@@ -411,6 +417,12 @@ class cow_opaque
       const noexcept
       { return this->m_sptr.use_count();  }
 
+    // This is used to identify shared instances during garbage collection.
+    const Abstract_Opaque*
+    get_ptr_opt()
+      const noexcept
+      { return this->m_sptr.get();  }
+
     cow_opaque&
     reset()
       noexcept
@@ -564,6 +576,12 @@ class cow_function
       const noexcept
       { return this->m_sptr.use_count();  }
 
+    // This is used to identify shared instances during garbage collection.
+    const Abstract_Function*
+    get_ptr_opt()
+      const noexcept
+      { return this->m_sptr.get();  }
+
     cow_function&
     reset()
       noexcept
@@ -597,6 +615,14 @@ class cow_function
         return callback;
       }
 
+    // This returns a null pointer if this is a static function, or the dynamic
+    // function is not of type `FunctionT`.
+    template<typename FunctionT = Abstract_Function>
+    rcptr<const FunctionT>
+    get_opt()
+      const
+      { return dynamic_pointer_cast<const FunctionT>(this->m_sptr);  }
+
     Reference&
     invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stack)
       const;
@@ -5,7 +5,8 @@
 #include "array.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/global_context.hpp"
-#include "../llds/reference_stack.hpp"
+#include "../runtime/thread_pool.hpp"
+#include "../runtime/prepared_call.hpp"
 #include "../utils.hpp"
 
 namespace asteria {
@@ -73,19 +74,12 @@ do_find_opt(IterT begin, IterT end, const Value& target)
 
 template<typename IterT>
 opt<IterT>
-do_find_if_opt(Global_Context& global, IterT begin, IterT end, const V_function& pred, bool match)
+do_find_if_opt(IterT begin, IterT end, Prepared_Call& pred, bool match)
   {
-    Reference self;
-    Reference_Stack stack;
     for(auto it = ::std::move(begin);  it != end;  ++it) {
-      // Set up arguments for the user-defined predictor.
-      stack.clear();
-      stack.emplace_back_uninit().set_temporary(*it);
-
       // Call the predictor function and check the return value.
-      self.set_temporary(nullopt);
-      pred.invoke(self, global, ::std::move(stack));
-      if(self.dereference_readonly().test() == match)
+      pred.push_argument(*it);
+      if(pred.invoke().dereference_readonly().test() == match)
         return ::std::move(it);
     }
     // Fail to find an element.
@@ -93,29 +87,21 @@ do_find_if_opt(Global_Context& global, IterT begin, IterT end, const V_function&
   }
 
 Compare
-do_compare(Global_Context& global, Reference_Stack& stack,
-           const Opt_function& kcomp, const Value& lhs, const Value& rhs)
+do_compare(Prepared_Call& kcomp, const Value& lhs, const Value& rhs)
   {
     // Use the builtin 3-way comparison operator if no comparator is provided.
-    if(ROCKET_EXPECT(!kcomp))
+    if(ROCKET_EXPECT(!kcomp.target()))
       return lhs.compare(rhs);
 
-    // Set up arguments for the user-defined comparator.
-    stack.clear();
-    stack.emplace_back_uninit().set_temporary(lhs);
-    stack.emplace_back_uninit().set_temporary(rhs);
-
-    // Call the predictor function and compare the result with `0`.
-    Reference self;
-    self.set_temporary(nullopt);
-    kcomp.invoke(self, global, ::std::move(stack));
-    return self.dereference_readonly().compare(V_integer(0));
+    // Call the user-defined comparator and compare the result with `0`.
+    kcomp.push_argument(lhs);
+    kcomp.push_argument(rhs);
+    return kcomp.invoke().dereference_readonly().compare(V_integer(0));
   }
 
 template<typename IterT>
 pair<IterT, bool>
-do_bsearch(Global_Context& global, Reference_Stack& stack, IterT begin, IterT end,
-           const Opt_function& kcomp, const Value& target)
+do_bsearch(IterT begin, IterT end, Prepared_Call& kcomp, const Value& target)
   {
     auto bpos = ::std::move(begin);
     auto epos = ::std::move(end);
@@ -126,7 +112,7 @@ do_bsearch(Global_Context& global, Reference_Stack& stack, IterT begin, IterT en
 
       // Compare `target` to the element in the middle.
       auto mpos = bpos + dist / 2;
-      auto cmp = do_compare(global, stack, kcomp, target, *mpos);
+      auto cmp = do_compare(kcomp, target, *mpos);
       if(cmp == compare_unordered)
         ASTERIA_THROW("Unordered elements (operands were `$1` and `$2`)", target, *mpos);
 
@@ -142,8 +128,7 @@ do_bsearch(Global_Context& global, Reference_Stack& stack, IterT begin, IterT en
 
 template<typename IterT, typename PredT>
 IterT
-do_bound(Global_Context& global, Reference_Stack& stack, IterT begin, IterT end,
-         const Opt_function& kcomp, const Value& target, PredT&& pred)
+do_bound(IterT begin, IterT end, Prepared_Call& kcomp, const Value& target, PredT&& pred)
   {
     auto bpos = ::std::move(begin);
     auto epos = ::std::move(end);
@@ -154,7 +139,7 @@ do_bound(Global_Context& global, Reference_Stack& stack, IterT begin, IterT end,
 
       // Compare `target` to the element in the middle.
       auto mpos = bpos + dist / 2;
-      auto cmp = do_compare(global, stack, kcomp, target, *mpos);
+      auto cmp = do_compare(kcomp, target, *mpos);
       if(cmp == compare_unordered)
         ASTERIA_THROW("Unordered elements (operands were `$1` and `$2`)", target, *mpos);
 
@@ -166,19 +151,18 @@ do_bound(Global_Context& global, Reference_Stack& stack, IterT begin, IterT end,
   }
 
 V_array::iterator&
-do_merge_range(V_array::iterator& opos, Global_Context& global, Reference_Stack& stack,
-               const Opt_function& kcomp, V_array::iterator ibegin, V_array::iterator iend,
-               bool unique)
+do_merge_range(V_array::iterator& opos, Prepared_Call& kcomp, V_array::iterator ibegin,
+               V_array::iterator iend, bool unique)
   {
     for(auto ipos = ibegin;  ipos != iend;  ++ipos)
-      if(!unique || (do_compare(global, stack, kcomp, ipos[0], opos[-1]) != compare_equal))
+      if(!unique || (do_compare(kcomp, ipos[0], opos[-1]) != compare_equal))
         *(opos++) = ::std::move(*ipos);
     return opos;
   }
 
 V_array::iterator
-do_merge_blocks(V_array& output, Global_Context& global, Reference_Stack& stack,
-                const Opt_function& kcomp, V_array&& input, ptrdiff_t bsize, bool unique)
+do_merge_blocks(V_array& output, Prepared_Call& kcomp, V_array&& input, ptrdiff_t bsize,
+                bool unique)
   {
     ROCKET_ASSERT(output.size() >= input.size());
 
@@ -205,7 +189,7 @@ do_merge_blocks(V_array& output, Global_Context& global, Reference_Stack& stack,
       // of it here.
       size_t bi;
       for(;;) {
-        auto cmp = do_compare(global, stack, kcomp, *(bpos[0]), *(bpos[1]));
+        auto cmp = do_compare(kcomp, *(bpos[0]), *(bpos[1]));
         if(cmp == compare_unordered)
           ASTERIA_THROW("Unordered elements (operands were `$1` and `$2`)",
                         *(bpos[0]), *(bpos[1]));
@@ -217,7 +201,7 @@ do_merge_blocks(V_array& output, Global_Context& global, Reference_Stack& stack,
         // Move this element unless uniqueness is requested and it is equal to the previous
         // output.
         bool discard = unique && (opos != output.begin())
-                       && (do_compare(global, stack, kcomp, *(bpos[bi]), opos[-1]) == compare_equal);
+                       && (do_compare(kcomp, *(bpos[bi]), opos[-1]) == compare_equal);
         if(!discard)
           *(opos++) = ::std::move(*(bpos[bi]));
         bpos[bi]++;
@@ -240,14 +224,309 @@ do_merge_blocks(V_array& output, Global_Context& global, Reference_Stack& stack,
       // Move all elements from the other block.
       ROCKET_ASSERT(opos != output.begin());
       bi ^= 1;
-      do_merge_range(opos, global, stack, kcomp, bpos[bi], bend[bi], unique);
+      do_merge_range(opos, kcomp, bpos[bi], bend[bi], unique);
     }
     // Copy all remaining elements.
     ROCKET_ASSERT(opos != output.begin());
-    do_merge_range(opos, global, stack, kcomp, ipos, iend, unique);
+    do_merge_range(opos, kcomp, ipos, iend, unique);
     return opos;
   }
 
+void
+do_radix_sort(cow_vector<uint64_t>& keys)
+  {
+    size_t nkeys = keys.size();
+    auto kptr = keys.mut_data();
+
+    // Count occurrences of each byte value in each byte position.
+    size_t counts[8][256] = { };
+    for(size_t i = 0;  i != nkeys;  ++i)
+      for(size_t b = 0;  b != 8;  ++b)
+        counts[b][kptr[i] >> b * 8 & 0xFF] ++;
+
+    // Distribute keys by each byte, starting from the least significant one.
+    // This is stable.
+    cow_vector<uint64_t> temp(nkeys);
+    auto tptr = temp.mut_data();
+    for(size_t b = 0;  b != 8;  ++b) {
+      // If all keys have the same byte here, skip it.
+      if(counts[b][kptr[0] >> b * 8 & 0xFF] == nkeys)
+        continue;
+
+      size_t offsets[256];
+      size_t sum = 0;
+      for(size_t d = 0;  d != 256;  ++d)
+        offsets[d] = ::std::exchange(sum, sum + counts[b][d]);
+
+      for(size_t i = 0;  i != nkeys;  ++i)
+        tptr[offsets[kptr[i] >> b * 8 & 0xFF]++] = kptr[i];
+
+      ::std::swap(kptr, tptr);
+      keys.swap(temp);
+    }
+  }
+
+bool
+do_sort_homogeneous(V_array& data)
+  {
+    constexpr uint64_t sign_bit = UINT64_C(1) << 63;
+
+    // Check whether all elements are of the same type.
+    auto qtype = data[0].type();
+    if((qtype != type_integer) && (qtype != type_real) && (qtype != type_string))
+      return false;
+
+    for(const auto& elem : data)
+      if(elem.type() != qtype)
+        return false;
+
+    if(qtype == type_string) {
+      // Strings that compare equal are indistinguishable, so the sort needn't
+      // be stable.
+      ::std::sort(data.mut_begin(), data.mut_end(),
+          [](const Value& lhs, const Value& rhs) { return lhs.as_string() < rhs.as_string();  });
+      return true;
+    }
+
+    // Map integers and reals to unsigned keys which sort in the same order.
+    cow_vector<uint64_t> keys;
+    keys.reserve(data.size());
+    bool has_zeroes = false;
+
+    if(qtype == type_integer) {
+      for(const auto& elem : data)
+        keys.emplace_back(static_cast<uint64_t>(elem.as_integer()) ^ sign_bit);
+    }
+    else {
+      for(const auto& elem : data) {
+        // NaNs are unordered, which the generic implementation reports.
+        double val = elem.as_real();
+        if(::std::isnan(val))
+          return false;
+
+        // Positive and negative zeroes are equivalent, but distinguishable.
+        // They are mapped to the same key, and restored below.
+        has_zeroes |= (val == 0);
+        if(val == 0)
+          val = 0;
+
+        uint64_t bits;
+        ::std::memcpy(&bits, &val, sizeof(val));
+        keys.emplace_back((static_cast<int64_t>(bits) < 0) ? ~bits : (bits ^ sign_bit));
+      }
+    }
+
+    do_radix_sort(keys);
+    auto dptr = data.mut_data();
+
+    if(qtype == type_integer) {
+      for(size_t i = 0;  i != keys.size();  ++i)
+        dptr[i] = static_cast<V_integer>(keys[i] ^ sign_bit);
+      return true;
+    }
+
+    // Collect zeroes in their original order, as the sort is stable.
+    cow_vector<double> zeroes;
+    if(has_zeroes)
+      for(const auto& elem : data)
+        if(elem.as_real() == 0)
+          zeroes.emplace_back(elem.as_real());
+
+    size_t nzeroes = 0;
+    for(size_t i = 0;  i != keys.size();  ++i) {
+      uint64_t bits = (static_cast<int64_t>(keys[i]) < 0) ? (keys[i] ^ sign_bit) : ~keys[i];
+      double val;
+      ::std::memcpy(&val, &bits, sizeof(val));
+      if(val == 0)
+        val = zeroes[nzeroes++];
+      dptr[i] = val;
+    }
+    return true;
+  }
+
+void
+do_sort_serial(Global_Context& global, V_array& data, const Opt_function& comparator)
+  {
+    // If no comparator is given, try sorting natively.
+    if(!comparator && do_sort_homogeneous(data))
+      return;
+
+    // Merge blocks of exponential sizes.
+    V_array temp(data.size());
+    Prepared_Call kcomp(global, comparator);
+    ptrdiff_t bsize = 1;
+    while(bsize < data.ssize()) {
+      do_merge_blocks(temp, kcomp, ::std::move(data), bsize, false);
+      data.swap(temp);
+      bsize *= 2;
+    }
+  }
+
+// These functions split a range into chunks which are processed in parallel.
+// This returns the offset of the `k`-th chunk, or the end of the range if `k`
+// equals `nchunks`.
+constexpr
+size_t
+do_chunk_offset(size_t size, size_t nchunks, size_t k)
+  noexcept
+  {
+    return static_cast<size_t>(static_cast<unsigned long long>(size) * k / nchunks);
+  }
+
+opt<V_array::const_iterator>
+do_find_parallel_opt(Thread_Pool& tpool, V_array::const_iterator begin,
+                     V_array::const_iterator end, const Value& target)
+  {
+    size_t size = static_cast<size_t>(end - begin);
+    size_t nchunks = (tpool.get_thread_count() + 1) * 4;
+    ::std::atomic<size_t> first(SIZE_MAX);
+
+    tpool.run_tasks(nchunks,
+      [&](size_t k) {
+        size_t eoff = do_chunk_offset(size, nchunks, k + 1);
+        for(size_t i = do_chunk_offset(size, nchunks, k);  i != eoff;  ++i) {
+          // Stop if a preceding element has been found.
+          size_t cur = first.load(::std::memory_order_relaxed);
+          if(i >= cur)
+            return;
+
+          if(begin[static_cast<ptrdiff_t>(i)].compare(target) != compare_equal)
+            continue;
+
+          // Record the index of this element if it precedes all others.
+          while((i < cur) && !first.compare_exchange_weak(cur, i, ::std::memory_order_relaxed));
+          return;
+        }
+      });
+
+    size_t index = first.load(::std::memory_order_relaxed);
+    if(index == SIZE_MAX)
+      return nullopt;
+    return begin + static_cast<ptrdiff_t>(index);
+  }
+
+size_t
+do_count_parallel(Thread_Pool& tpool, V_array::const_iterator begin,
+                  V_array::const_iterator end, const Value& target)
+  {
+    size_t size = static_cast<size_t>(end - begin);
+    size_t nchunks = (tpool.get_thread_count() + 1) * 4;
+    ::std::atomic<size_t> total(0);
+
+    tpool.run_tasks(nchunks,
+      [&](size_t k) {
+        size_t count = 0;
+        size_t eoff = do_chunk_offset(size, nchunks, k + 1);
+        for(size_t i = do_chunk_offset(size, nchunks, k);  i != eoff;  ++i)
+          count += (begin[static_cast<ptrdiff_t>(i)].compare(target) == compare_equal);
+        total.fetch_add(count, ::std::memory_order_relaxed);
+      });
+
+    return total.load(::std::memory_order_relaxed);
+  }
+
+V_array
+do_exclude_parallel(Thread_Pool& tpool, const V_array& data, V_array::const_iterator begin,
+                    V_array::const_iterator end, const Value& target)
+  {
+    size_t size = static_cast<size_t>(end - begin);
+    size_t nchunks = (tpool.get_thread_count() + 1) * 4;
+    cow_vector<V_array> kept(nchunks);
+    auto kptr = kept.mut_data();
+
+    // Copy elements that are not equal to `target` from each chunk.
+    tpool.run_tasks(nchunks,
+      [&](size_t k) {
+        size_t eoff = do_chunk_offset(size, nchunks, k + 1);
+        for(size_t i = do_chunk_offset(size, nchunks, k);  i != eoff;  ++i)
+          if(begin[static_cast<ptrdiff_t>(i)].compare(target) != compare_equal)
+            kptr[k].emplace_back(begin[static_cast<ptrdiff_t>(i)]);
+      });
+
+    // Concatenate them, with elements outside the range.
+    V_array res;
+    res.append(data.begin(), begin);
+    for(size_t k = 0;  k != nchunks;  ++k)
+      res.append(kptr[k].begin(), kptr[k].end());
+    res.append(end, data.end());
+    return res;
+  }
+
+void
+do_merge_runs(V_array& output, V_array& lhs, V_array& rhs)
+  {
+    output.reserve(lhs.size() + rhs.size());
+    auto lpos = lhs.mut_begin();
+    auto lend = lhs.mut_end();
+    auto rpos = rhs.mut_begin();
+    auto rend = rhs.mut_end();
+
+    while((lpos != lend) && (rpos != rend)) {
+      auto cmp = lpos->compare(*rpos);
+      if(cmp == compare_unordered)
+        ASTERIA_THROW("Unordered elements (operands were `$1` and `$2`)", *lpos, *rpos);
+
+      // For the merge to be stable, an element from `rhs` is taken only if it is
+      // less than the one from `lhs`.
+      if(cmp == compare_greater)
+        output.emplace_back(::std::move(*(rpos++)));
+      else
+        output.emplace_back(::std::move(*(lpos++)));
+    }
+
+    while(lpos != lend)
+      output.emplace_back(::std::move(*(lpos++)));
+    while(rpos != rend)
+      output.emplace_back(::std::move(*(rpos++)));
+  }
+
+V_array
+do_sort_parallel(Global_Context& global, Thread_Pool& tpool, const V_array& data, bool unique)
+  {
+    // Sort a run on each thread.
+    size_t size = data.size();
+    size_t nruns = tpool.get_thread_count() + 1;
+    cow_vector<V_array> runs(nruns);
+    auto rptr = runs.mut_data();
+
+    tpool.run_tasks(nruns,
+      [&](size_t k) {
+        rptr[k].append(data.begin() + static_cast<ptrdiff_t>(do_chunk_offset(size, nruns, k)),
+                       data.begin() + static_cast<ptrdiff_t>(do_chunk_offset(size, nruns, k + 1)));
+        do_sort_serial(global, rptr[k], nullptr);
+      });
+
+    // Merge adjacent runs in parallel, until there is only one.
+    while(nruns > 1) {
+      size_t npairs = nruns / 2;
+      tpool.run_tasks(npairs,
+        [&](size_t k) {
+          V_array output;
+          do_merge_runs(output, rptr[k * 2], rptr[k * 2 + 1]);
+          rptr[k * 2].swap(output);
+          rptr[k * 2 + 1].clear();
+        });
+
+      for(size_t k = 1;  k != npairs;  ++k)
+        rptr[k].swap(rptr[k * 2]);
+      if(nruns % 2 != 0)
+        rptr[npairs].swap(rptr[nruns - 1]);
+      nruns = npairs + nruns % 2;
+    }
+
+    V_array res = ::std::move(rptr[0]);
+    if(!unique)
+      return res;
+
+    // Remove elements that have preceding equivalents.
+    auto opos = res.mut_begin();
+    for(auto ipos = opos + 1;  ipos != res.end();  ++ipos)
+      if(ipos->compare(*opos) != compare_equal)
+        *(++opos) = ::std::move(*ipos);
+    res.erase(opos + 1, res.end());
+    return res;
+  }
+
 }  // namespace
 
 V_array
@@ -296,10 +575,14 @@ std_array_replace_slice(V_array data, V_integer from, Opt_integer length,
   }
 
 Opt_integer
-std_array_find(V_array data, V_integer from, Opt_integer length, Value target)
+std_array_find(Global_Context& global, V_array data, V_integer from, Opt_integer length,
+               Value target)
   {
     auto range = do_slice(data, from, length);
-    auto qit = do_find_opt(range.first, range.second, target);
+    auto tpool = global.thread_pool();
+    auto qit = tpool->should_parallelize(static_cast<size_t>(range.second - range.first))
+                 ? do_find_parallel_opt(*tpool, range.first, range.second, target)
+                 : do_find_opt(range.first, range.second, target);
     if(!qit)
       return nullopt;
     return *qit - data.begin();
@@ -309,8 +592,9 @@ Opt_integer
 std_array_find_if(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                   V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     auto range = do_slice(data, from, length);
-    auto qit = do_find_if_opt(global, range.first, range.second, predictor, true);
+    auto qit = do_find_if_opt(range.first, range.second, pred, true);
     if(!qit)
       return nullopt;
     return *qit - data.begin();
@@ -320,8 +604,9 @@ Opt_integer
 std_array_find_if_not(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                       V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     auto range = do_slice(data, from, length);
-    auto qit = do_find_if_opt(global, range.first, range.second, predictor, false);
+    auto qit = do_find_if_opt(range.first, range.second, pred, false);
     if(!qit)
       return nullopt;
     return *qit - data.begin();
@@ -342,9 +627,10 @@ Opt_integer
 std_array_rfind_if(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                    V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     auto range = do_slice(data, from, length);
-    auto qit = do_find_if_opt(global, ::std::make_reverse_iterator(range.second),
-                                      ::std::make_reverse_iterator(range.first), predictor, true);
+    auto qit = do_find_if_opt(::std::make_reverse_iterator(range.second),
+                              ::std::make_reverse_iterator(range.first), pred, true);
     if(!qit)
       return nullopt;
     return data.rend() - *qit - 1;
@@ -354,19 +640,25 @@ Opt_integer
 std_array_rfind_if_not(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                        V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     auto range = do_slice(data, from, length);
-    auto qit = do_find_if_opt(global, ::std::make_reverse_iterator(range.second),
-                                      ::std::make_reverse_iterator(range.first), predictor, false);
+    auto qit = do_find_if_opt(::std::make_reverse_iterator(range.second),
+                              ::std::make_reverse_iterator(range.first), pred, false);
     if(!qit)
       return nullopt;
     return data.rend() - *qit - 1;
   }
 
 V_integer
-std_array_count(V_array data, V_integer from, Opt_integer length, Value target)
+std_array_count(Global_Context& global, V_array data, V_integer from, Opt_integer length,
+                Value target)
   {
     int64_t count = 0;
     auto range = do_slice(data, from, length);
+    auto tpool = global.thread_pool();
+    if(tpool->should_parallelize(static_cast<size_t>(range.second - range.first)))
+      return static_cast<int64_t>(do_count_parallel(*tpool, range.first, range.second, target));
+
     while(auto qit = do_find_opt(range.first, range.second, target)) {
       ++count;
       range.first = ::std::move(++*qit);
@@ -378,9 +670,10 @@ V_integer
 std_array_count_if(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                    V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     int64_t count = 0;
     auto range = do_slice(data, from, length);
-    while(auto qit = do_find_if_opt(global, range.first, range.second, predictor, true)) {
+    while(auto qit = do_find_if_opt(range.first, range.second, pred, true)) {
       ++count;
       range.first = ::std::move(++*qit);
     }
@@ -391,9 +684,10 @@ V_integer
 std_array_count_if_not(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                        V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     int64_t count = 0;
     auto range = do_slice(data, from, length);
-    while(auto qit = do_find_if_opt(global, range.first, range.second, predictor, false)) {
+    while(auto qit = do_find_if_opt(range.first, range.second, pred, false)) {
       ++count;
       range.first = ::std::move(++*qit);
     }
@@ -401,9 +695,14 @@ std_array_count_if_not(Global_Context& global, V_array data, V_integer from, Opt
   }
 
 V_array
-std_array_exclude(V_array data, V_integer from, Opt_integer length, Value target)
+std_array_exclude(Global_Context& global, V_array data, V_integer from, Opt_integer length,
+                  Value target)
   {
     auto range = do_slice(data, from, length);
+    auto tpool = global.thread_pool();
+    if(tpool->should_parallelize(static_cast<size_t>(range.second - range.first)))
+      return do_exclude_parallel(*tpool, data, range.first, range.second, target);
+
     ptrdiff_t dist = data.end() - range.second;
     while(auto qit = do_find_opt(range.first, range.second, target)) {
       range.first = data.erase(*qit);
@@ -416,9 +715,10 @@ V_array
 std_array_exclude_if(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                      V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     auto range = do_slice(data, from, length);
     ptrdiff_t dist = data.end() - range.second;
-    while(auto qit = do_find_if_opt(global, range.first, range.second, predictor, true)) {
+    while(auto qit = do_find_if_opt(range.first, range.second, pred, true)) {
       range.first = data.erase(*qit);
       range.second = data.end() - dist;
     }
@@ -429,9 +729,10 @@ V_array
 std_array_exclude_if_not(Global_Context& global, V_array data, V_integer from, Opt_integer length,
                          V_function predictor)
   {
+    Prepared_Call pred(global, predictor);
     auto range = do_slice(data, from, length);
     ptrdiff_t dist = data.end() - range.second;
-    while(auto qit = do_find_if_opt(global, range.first, range.second, predictor, false)) {
+    while(auto qit = do_find_if_opt(range.first, range.second, pred, false)) {
       range.first = data.erase(*qit);
       range.second = data.end() - dist;
     }
@@ -445,10 +746,10 @@ std_array_is_sorted(Global_Context& global, V_array data, Opt_function comparato
       // If `data` contains no more than 2 elements, it is considered sorted.
       return true;
 
-    Reference_Stack stack;
+    Prepared_Call kcomp(global, comparator);
     for(auto it = data.begin() + 1;  it != data.end();  ++it) {
       // Compare the two elements.
-      auto cmp = do_compare(global, stack, comparator, it[-1], it[0]);
+      auto cmp = do_compare(kcomp, it[-1], it[0]);
       if((cmp == compare_greater) || (cmp == compare_unordered))
         return false;
     }
@@ -458,8 +759,8 @@ std_array_is_sorted(Global_Context& global, V_array data, Opt_function comparato
 Opt_integer
 std_array_binary_search(Global_Context& global, V_array data, Value target, Opt_function comparator)
   {
-    Reference_Stack stack;
-    auto pair = do_bsearch(global, stack, data.begin(), data.end(), comparator, target);
+    Prepared_Call kcomp(global, comparator);
+    auto pair = do_bsearch(data.begin(), data.end(), kcomp, target);
     if(!pair.second)
       return nullopt;
     return pair.first - data.begin();
@@ -468,8 +769,8 @@ std_array_binary_search(Global_Context& global, V_array data, Value target, Opt_
 V_integer
 std_array_lower_bound(Global_Context& global, V_array data, Value target, Opt_function comparator)
   {
-    Reference_Stack stack;
-    auto lpos = do_bound(global, stack, data.begin(), data.end(), comparator, target,
+    Prepared_Call kcomp(global, comparator);
+    auto lpos = do_bound(data.begin(), data.end(), kcomp, target,
                          [](Compare cmp) { return cmp != compare_greater;  });
     return lpos - data.begin();
   }
@@ -477,8 +778,8 @@ std_array_lower_bound(Global_Context& global, V_array data, Value target, Opt_fu
 V_integer
 std_array_upper_bound(Global_Context& global, V_array data, Value target, Opt_function comparator)
   {
-    Reference_Stack stack;
-    auto upos = do_bound(global, stack, data.begin(), data.end(), comparator, target,
+    Prepared_Call kcomp(global, comparator);
+    auto upos = do_bound(data.begin(), data.end(), kcomp, target,
                          [](Compare cmp) { return cmp == compare_less;  });
     return upos - data.begin();
   }
@@ -486,11 +787,11 @@ std_array_upper_bound(Global_Context& global, V_array data, Value target, Opt_fu
 pair<V_integer, V_integer>
 std_array_equal_range(Global_Context& global, V_array data, Value target, Opt_function comparator)
   {
-    Reference_Stack stack;
-    auto pair = do_bsearch(global, stack, data.begin(), data.end(), comparator, target);
-    auto lpos = do_bound(global, stack, data.begin(), pair.first, comparator, target,
+    Prepared_Call kcomp(global, comparator);
+    auto pair = do_bsearch(data.begin(), data.end(), kcomp, target);
+    auto lpos = do_bound(data.begin(), pair.first, kcomp, target,
                          [](Compare cmp) { return cmp != compare_greater;  });
-    auto upos = do_bound(global, stack, pair.first, data.end(), comparator, target,
+    auto upos = do_bound(pair.first, data.end(), kcomp, target,
                          [](Compare cmp) { return cmp == compare_less;  });
     return ::std::make_pair(lpos - data.begin(), upos - lpos);
   }
@@ -502,15 +803,12 @@ std_array_sort(Global_Context& global, V_array data, Opt_function comparator)
       // Use reference counting as our advantage.
       return ::std::move(data);
 
-    // Merge blocks of exponential sizes.
-    V_array temp(data.size());
-    Reference_Stack stack;
-    ptrdiff_t bsize = 1;
-    while(bsize < data.ssize()) {
-      do_merge_blocks(temp, global, stack, comparator, ::std::move(data), bsize, false);
-      data.swap(temp);
-      bsize *= 2;
-    }
+    // Large arrays without comparators may be sorted in parallel.
+    auto tpool = global.thread_pool();
+    if(!comparator && tpool->should_parallelize(data.size()))
+      return do_sort_parallel(global, *tpool, data, false);
+
+    do_sort_serial(global, data, comparator);
     return ::std::move(data);
   }
 
@@ -521,16 +819,21 @@ std_array_sortu(Global_Context& global, V_array data, Opt_function comparator)
       // Use reference counting as our advantage.
       return ::std::move(data);
 
+    // Large arrays without comparators may be sorted in parallel.
+    auto tpool = global.thread_pool();
+    if(!comparator && tpool->should_parallelize(data.size()))
+      return do_sort_parallel(global, *tpool, data, true);
+
     // Merge blocks of exponential sizes.
     V_array temp(data.size());
-    Reference_Stack stack;
+    Prepared_Call kcomp(global, comparator);
     ptrdiff_t bsize = 1;
     while(bsize * 2 < data.ssize()) {
-      do_merge_blocks(temp, global, stack, comparator, ::std::move(data), bsize, false);
+      do_merge_blocks(temp, kcomp, ::std::move(data), bsize, false);
       data.swap(temp);
       bsize *= 2;
     }
-    auto epos = do_merge_blocks(temp, global, stack, comparator, ::std::move(data), bsize, true);
+    auto epos = do_merge_blocks(temp, kcomp, ::std::move(data), bsize, true);
     temp.erase(epos, temp.end());
     data.swap(temp);
     return ::std::move(data);
@@ -545,9 +848,9 @@ std_array_max_of(Global_Context& global, V_array data, Opt_function comparator)
       return nullopt;
 
     // Compare `*qmax` with the other elements, ignoring unordered elements.
-    Reference_Stack stack;
+    Prepared_Call kcomp(global, comparator);
     for(auto it = qmax + 1;  it != data.end();  ++it)
-      if(do_compare(global, stack, comparator, *qmax, *it) == compare_less)
+      if(do_compare(kcomp, *qmax, *it) == compare_less)
         qmax = it;
     return *qmax;
   }
@@ -561,9 +864,9 @@ std_array_min_of(Global_Context& global, V_array data, Opt_function comparator)
       return nullopt;
 
     // Compare `*qmin` with the other elements, ignoring unordered elements.
-    Reference_Stack stack;
+    Prepared_Call kcomp(global, comparator);
     for(auto it = qmin + 1;  it != data.end();  ++it)
-      if(do_compare(global, stack, comparator, *qmin, *it) == compare_greater)
+      if(do_compare(kcomp, *qmin, *it) == compare_greater)
         qmin = it;
     return *qmin;
   }
@@ -580,21 +883,17 @@ std_array_generate(Global_Context& global, V_function generator, V_integer lengt
   {
     V_array data;
     data.reserve(static_cast<size_t>(length));
-    Reference self;
-    Reference_Stack stack;
+    Prepared_Call gen(global, generator);
     for(int64_t i = 0;  i < length;  ++i) {
       // Set up arguments for the user-defined generator.
-      stack.clear();
-      stack.emplace_back_uninit().set_temporary(i);
+      gen.push_argument(i);
       if(data.empty())
-        stack.emplace_back_uninit().set_temporary(nullopt);
+        gen.push_argument(nullopt);
       else
-        stack.emplace_back_uninit().set_temporary(data.back());
+        gen.push_argument(data.back());
 
       // Call the generator function and push the return value.
-      self.set_temporary(nullopt);
-      generator.invoke(self, global, ::std::move(stack));
-      data.emplace_back(self.dereference_readonly());
+      data.emplace_back(gen.invoke().dereference_readonly());
     }
     return data;
   }
@@ -727,7 +1026,7 @@ create_bindings_array(V_object& result, API_Version /*version*/)
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_find, data, 0, nullopt, targ);
+                    std_array_find, global, data, 0, nullopt, targ);
 
         reader.load_state(0);      // data
         reader.required(from);     // from
@@ -735,14 +1034,14 @@ create_bindings_array(V_object& result, API_Version /*version*/)
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_find, data, from, nullopt, targ);
+                    std_array_find, global, data, from, nullopt, targ);
 
         reader.load_state(0);      // data, from
         reader.optional(len);      // [length]
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_find, data, from, len, targ);
+                    std_array_find, global, data, from, len, targ);
       }
       ASTERIA_BINDING_END);
 
@@ -919,7 +1218,7 @@ create_bindings_array(V_object& result, API_Version /*version*/)
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_count, data, 0, nullopt, targ);
+                    std_array_count, global, data, 0, nullopt, targ);
 
         reader.load_state(0);      // data
         reader.required(from);     // from
@@ -927,14 +1226,14 @@ create_bindings_array(V_object& result, API_Version /*version*/)
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_count, data, from, nullopt, targ);
+                    std_array_count, global, data, from, nullopt, targ);
 
         reader.load_state(0);      // data, from
         reader.optional(len);      // [length]
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_count, data, from, len, targ);
+                    std_array_count, global, data, from, len, targ);
       }
       ASTERIA_BINDING_END);
 
@@ -1015,7 +1314,7 @@ create_bindings_array(V_object& result, API_Version /*version*/)
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_exclude, data, 0, nullopt, targ);
+                    std_array_exclude, global, data, 0, nullopt, targ);
 
         reader.load_state(0);      // data
         reader.required(from);     // from
@@ -1023,14 +1322,14 @@ create_bindings_array(V_object& result, API_Version /*version*/)
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_exclude, data, from, nullopt, targ);
+                    std_array_exclude, global, data, from, nullopt, targ);
 
         reader.load_state(0);      // data, from
         reader.optional(len);      // [length]
         reader.optional(targ);     // [target]
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
-                    std_array_exclude, data, from, len, targ);
+                    std_array_exclude, global, data, from, len, targ);
       }
       ASTERIA_BINDING_END);
 
@@ -19,7 +19,8 @@ std_array_replace_slice(V_array data, V_integer from, Opt_integer length,
 
 // `std.array.find`
 Opt_integer
-std_array_find(V_array data, V_integer from, Opt_integer length, Value target);
+std_array_find(Global_Context& global, V_array data, V_integer from, Opt_integer length,
+               Value target);
 
 // `std.array.find_if`
 Opt_integer
@@ -47,7 +48,8 @@ std_array_rfind_if_not(Global_Context& global, V_array data, V_integer from, Opt
 
 // `std.array.count`
 V_integer
-std_array_count(V_array data, V_integer from, Opt_integer length, Value target);
+std_array_count(Global_Context& global, V_array data, V_integer from, Opt_integer length,
+                Value target);
 
 // `std.array.count_if`
 V_integer
@@ -61,7 +63,8 @@ std_array_count_if_not(Global_Context& global, V_array data, V_integer from, Opt
 
 // `std.array.exclude`
 V_array
-std_array_exclude(V_array data, V_integer from, Opt_integer length, Value target);
+std_array_exclude(Global_Context& global, V_array data, V_integer from, Opt_integer length,
+                  Value target);
 
 // `std.array.exclude_if`
 V_array
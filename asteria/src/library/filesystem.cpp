@@ -5,7 +5,7 @@
 #include "filesystem.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/global_context.hpp"
-#include "../llds/reference_stack.hpp"
+#include "../runtime/prepared_call.hpp"
 #include "../utils.hpp"
 #include <sys/stat.h>  // ::stat(), ::fstat(), ::lstat(), ::mkdir(), ::fchmod()
 #include <dirent.h>  // ::opendir(), ::closedir()
@@ -457,8 +457,7 @@ std_filesystem_file_stream(Global_Context& global, V_string path, V_function cal
                     format_errno(errno), path);
 
     // We return data that have been read as a byte string.
-    Reference self;
-    Reference_Stack stack;
+    Prepared_Call call(global, callback);
     V_string data;
     int64_t roffset = offset.value_or(0);
     int64_t rlimit = limit.value_or(INT64_MAX);
@@ -497,11 +496,9 @@ std_filesystem_file_stream(Global_Context& global, V_string path, V_function cal
         break;
 
       // Call the function but discard its return value.
-      stack.clear();
-      stack.emplace_back_uninit().set_temporary(roffset);
-      stack.emplace_back_uninit().set_temporary(::std::move(data));
-      self.set_temporary(nullopt);
-      callback.invoke(self, global, ::std::move(stack));
+      call.push_argument(roffset);
+      call.push_argument(::std::move(data));
+      call.invoke();
     }
     return roffset - offset.value_or(0);
   }
@@ -47,31 +47,6 @@ do_recover(::FILE* fp)
     return err;
   }
 
-constexpr
-int
-do_normalize_fwide(int wide)
-  noexcept
-  {
-    return (wide == 0) ? 0 : ((wide >> (WORD_BIT - 1)) | 1);
-  }
-
-bool
-do_set_wide(::FILE* fp, const char* mode, int wide)
-  {
-    // Get the current orientation.
-    int wcomp = do_normalize_fwide(wide);
-    if(do_normalize_fwide(::fwide(fp, wide)) != wcomp) {
-      // Clear the current orientation and try resetting it.
-      // XXX: Is it safe to do so when the file has been locked?
-      if(!::freopen(nullptr, mode, fp))
-        ::abort();
-
-      if(do_normalize_fwide(::fwide(fp, wide)) != wcomp)
-        return false;
-    }
-    return true;
-  }
-
 size_t
 do_write_utf8_common(::FILE* fp, const cow_string& text)
   {
@@ -126,7 +101,7 @@ std_io_getc()
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard input failure (error bit set)");
 
-    if(!do_set_wide(fp, "r", +1))
+    if(!set_file_orientation(fp, "r", +1))
       ASTERIA_THROW("Invalid text read from binary-oriented input");
 
     // Read a UTF code point.
@@ -156,7 +131,7 @@ std_io_getln()
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard input failure (error bit set)");
 
-    if(!do_set_wide(fp, "r", +1))
+    if(!set_file_orientation(fp, "r", +1))
       ASTERIA_THROW("Invalid text read from binary-oriented input");
 
     // Read a UTF-8 string.
@@ -200,7 +175,7 @@ std_io_putc(V_integer value)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard output failure (error bit set)");
 
-    if(!do_set_wide(fp, "w", +1))
+    if(!set_file_orientation(fp, "w", +1))
       ASTERIA_THROW("Invalid text write to binary-oriented output");
 
     // Validate the code point.
@@ -235,7 +210,7 @@ std_io_putc(V_string value)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard output failure (error bit set)");
 
-    if(!do_set_wide(fp, "w", +1))
+    if(!set_file_orientation(fp, "w", +1))
       ASTERIA_THROW("Invalid text write to binary-oriented output");
 
     // Write only the string.
@@ -254,7 +229,7 @@ std_io_putln(V_string value)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard output failure (error bit set)");
 
-    if(!do_set_wide(fp, "w", +1))
+    if(!set_file_orientation(fp, "w", +1))
       ASTERIA_THROW("Invalid text write to binary-oriented output");
 
     // Write the string itself.
@@ -280,7 +255,7 @@ std_io_putf(V_string templ, cow_vector<Value> values)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard output failure (error bit set)");
 
-    if(!do_set_wide(fp, "w", +1))
+    if(!set_file_orientation(fp, "w", +1))
       ASTERIA_THROW("Invalid text write to binary-oriented output");
 
     // Write the string itself.
@@ -299,7 +274,7 @@ std_io_putlnf(V_string templ, cow_vector<Value> values)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard output failure (error bit set)");
 
-    if(!do_set_wide(fp, "w", +1))
+    if(!set_file_orientation(fp, "w", +1))
       ASTERIA_THROW("Invalid text write to binary-oriented output");
 
     // Write the string itself.
@@ -325,7 +300,7 @@ std_io_read(Opt_integer limit)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard input failure (error bit set)");
 
-    if(!do_set_wide(fp, "r", -1))
+    if(!set_file_orientation(fp, "r", -1))
       ASTERIA_THROW("Invalid binary read from text-oriented input");
 
     V_string data;
@@ -367,7 +342,7 @@ std_io_write(V_string data)
     if(::ferror_unlocked(fp))
       ASTERIA_THROW("Standard output failure (error bit set)");
 
-    if(!do_set_wide(fp, "w", -1))
+    if(!set_file_orientation(fp, "w", -1))
       ASTERIA_THROW("Invalid binary write to text-oriented output");
 
     size_t ntotal = 0;
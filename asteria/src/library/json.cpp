@@ -5,10 +5,15 @@
 #include "json.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/global_context.hpp"
-#include "../compiler/token_stream.hpp"
+#include "../runtime/prepared_call.hpp"
 #include "../compiler/parser_error.hpp"
 #include "../compiler/enums.hpp"
 #include "../utils.hpp"
+#include "../../rocket/tinyfmt_file.hpp"
+#include <fcntl.h>  // ::open()
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
 
 namespace asteria {
 namespace {
@@ -149,6 +154,28 @@ class Indenter_spaces
       { return this->m_add;  }
   };
 
+// These are escape sequences of ASCII characters in JSON strings. Characters
+// that are mapped to empty strings can be written verbatim.
+constexpr char s_json_escapes[][8] =
+  {
+    "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+    "\\b",     "\\t",     "\\n",     "\\u000B", "\\f",     "\\r",     "\\u000E", "\\u000F",
+    "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+    "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D", "\\u001E", "\\u001F",
+    "",        "",        "\\\"",    "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "\\\\",    "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "",
+    "",        "",        "",        "",        "",        "",        "",        "\\u007F",
+  };
+
 tinyfmt&
 do_quote_string(tinyfmt& fmt, const cow_string& str)
   {
@@ -156,64 +183,41 @@ do_quote_string(tinyfmt& fmt, const cow_string& str)
     fmt << '\"';
     size_t offset = 0;
     while(offset < str.size()) {
+      // Write characters that require no escaping in bulk.
+      size_t tpos = offset;
+      while((tpos < str.size()) && !(str[tpos] & 0x80) && !s_json_escapes[size_t(str[tpos])][0])
+        tpos++;
+
+      fmt.putn(str.data() + offset, tpos - offset);
+      offset = tpos;
+      if(offset == str.size())
+        break;
+
+      if(!(str[offset] & 0x80)) {
+        // Escape double quotes, backslashes, and control characters.
+        fmt << s_json_escapes[size_t(str[offset])];
+        offset++;
+        continue;
+      }
+
       // Convert UTF-8 to UTF-16.
       char32_t cp;
       if(!utf8_decode(cp, str, offset))
         // Invalid UTF-8 code units are replaced with the replacement character.
         cp = 0xFFFD;
 
-      // Escape double quotes, backslashes, and control characters.
-      switch(cp) {
-        case '\"':
-          fmt << "\\\"";
-          break;
-
-        case '\\':
-          fmt << "\\\\";
-          break;
-
-        case '\b':
-          fmt << "\\b";
-          break;
-
-        case '\f':
-          fmt << "\\f";
-          break;
-
-        case '\n':
-          fmt << "\\n";
-          break;
-
-        case '\r':
-          fmt << "\\r";
-          break;
-
-        case '\t':
-          fmt << "\\t";
-          break;
-
-        default: {
-          if((0x20 <= cp) && (cp <= 0x7E)) {
-            // Write printable characters as is.
-            fmt << static_cast<char>(cp);
-            break;
-          }
-
-          // Encode the character in UTF-16.
-          char16_t ustr[2];
-          char16_t* epos = ustr;
-          utf16_encode(epos, cp);
-
-          // Write code units.
-          ::rocket::ascii_numput nump;
-          for(auto p = ustr;  p != epos;  ++p) {
-            nump.put_XU(*p, 4);
-            char seq[8] = { "\\u" };
-            ::std::memcpy(seq + 2, nump.data() + 2, 4);
-            fmt << sref(seq, 6);
-          }
-          break;
-        }
+      // Encode the character in UTF-16.
+      char16_t ustr[2];
+      char16_t* epos = ustr;
+      utf16_encode(epos, cp);
+
+      // Write code units.
+      ::rocket::ascii_numput nump;
+      for(auto p = ustr;  p != epos;  ++p) {
+        nump.put_XU(*p, 4);
+        char seq[8] = { "\\u" };
+        ::std::memcpy(seq + 2, nump.data() + 2, 4);
+        fmt << sref(seq, 6);
       }
     }
     fmt << '\"';
@@ -268,11 +272,9 @@ struct S_xformat_object
 
 using Xformat = ::rocket::variant<S_xformat_array, S_xformat_object>;
 
-V_string
-do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
+tinyfmt&
+do_format_nonrecursive(tinyfmt& fmt, const Value& value, bool json5, Indenter& indent)
   {
-    ::rocket::tinyfmt_str fmt;
-
     // Transform recursion to iteration using a handwritten stack.
     auto qval = &value;
     cow_vector<Xformat> stack;
@@ -371,7 +373,7 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
       for(;;) {
         if(stack.empty())
           // Finish the root value.
-          return fmt.extract_string();
+          return fmt;
 
         // Advance to the next element.
         if(stack.back().index() == 0) {
@@ -420,179 +422,704 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
     }
   }
 
-V_string
-do_format_nonrecursive(const Value& value, bool json5, Indenter&& indent)
+tinyfmt&
+do_format_nonrecursive(tinyfmt& fmt, const Value& value, bool json5, Indenter&& indent)
   {
-    return do_format_nonrecursive(value, json5, indent);
+    return do_format_nonrecursive(fmt, value, json5, indent);
   }
 
-opt<Punctuator>
-do_accept_punctuator_opt(Token_Stream& tstrm, initializer_list<Punctuator> accept)
+tinyfmt&
+do_format_with_indent(tinyfmt& fmt, const Value& value, bool json5, const Opt_string& indent)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok)
-      return nullopt;
+    // No line break is inserted if `indent` is null or empty.
+    return (!indent || indent->empty())
+               ? do_format_nonrecursive(fmt, value, json5, Indenter_none())
+               : do_format_nonrecursive(fmt, value, json5, Indenter_string(*indent));
+  }
 
-    if(!qtok->is_punctuator())
-      return nullopt;
+tinyfmt&
+do_format_with_indent(tinyfmt& fmt, const Value& value, bool json5, V_integer indent)
+  {
+    // No line break is inserted if `indent` is non-positive.
+    return (indent <= 0)
+               ? do_format_nonrecursive(fmt, value, json5, Indenter_none())
+               : do_format_nonrecursive(fmt, value, json5, Indenter_spaces(indent));
+  }
 
-    auto punct = qtok->as_punctuator();
-    if(::rocket::is_none_of(punct, accept))
-      return nullopt;
+template<typename IndentT>
+V_string
+do_format_to_string(const Value& value, bool json5, const IndentT& indent)
+  {
+    ::rocket::tinyfmt_str fmt;
+    do_format_with_indent(fmt, value, json5, indent);
+    return fmt.extract_string();
+  }
 
-    tstrm.shift();
-    return punct;
+template<typename IndentT>
+void
+do_format_to_file(::FILE* fp, const Value& value, const IndentT& indent)
+  {
+    // Characters are buffered by the C library.
+    ::rocket::tinyfmt_file fmt(fp, nullptr);
+    do_format_with_indent(fmt, value, false, indent);
+    if(::fflush(fp) == EOF)
+      ASTERIA_THROW("Error flushing file\n"
+                    "[`fflush()` failed: $1]",
+                    format_errno(errno));
   }
 
-phsh_string
-do_accept_object_key(Token_Stream& tstrm)
+// This is thrown when the end of a partial input is reached. More characters
+// shall be appended before parsing can be retried.
+struct JSON_Partial
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok)
-      throw Parser_Error(parser_status_closed_brace_or_json5_key_expected, tstrm);
+  };
 
-    cow_string name;
-    switch(weaken_enum(qtok->index())) {
-      case Token::index_identifier:
-        name = qtok->as_identifier();
-        break;
+class JSON_Parser
+  {
+  private:
+    const char* m_bptr;
+    const char* m_eptr;
+    const char* m_rptr;
+    bool m_final = true;
 
-      case Token::index_string_literal:
-        name = qtok->as_string_literal();
-        break;
+    // These are the line and column numbers of `m_bptr`.
+    int m_line = 1;
+    int m_column = 1;
 
-      default:
-        throw Parser_Error(parser_status_closed_brace_or_json5_key_expected, tstrm);
-    }
-    tstrm.shift();
+    // Object keys are usually repeated, so their storage is shared.
+    cow_dictionary<bool> m_keys;
 
-    auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_colon });
-    if(!kpunct)
-      throw Parser_Error(parser_status_colon_expected, tstrm);
+  public:
+    explicit
+    JSON_Parser(const char* bptr, const char* eptr)
+      noexcept
+      : m_bptr(bptr), m_eptr(eptr), m_rptr(bptr)
+      { }
 
-    return name;
-  }
+  private:
+    void
+    do_count_lines(int& line, int& column, const char* tptr)
+      const noexcept
+      {
+        auto lptr = this->m_bptr;
+        for(auto qnl = lptr;  (qnl = static_cast<const char*>(
+                  ::std::memchr(qnl, '\n', static_cast<size_t>(tptr - qnl))));  ) {
+          line += 1;
+          column = 1;
+          lptr = ++qnl;
+        }
+        column += static_cast<int>(tptr - lptr);
+      }
 
-struct S_xparse_array
-  {
-    V_array array;
-  };
+    void
+    do_check_partial()
+      const
+      {
+        if(!this->m_final)
+          throw JSON_Partial();
+      }
 
-struct S_xparse_object
-  {
-    V_object object;
-    phsh_string key;
-  };
+    size_t
+    do_mask_length(const char* tptr, uint8_t mask)
+      const noexcept
+      {
+        auto sptr = tptr;
+        while((sptr != this->m_eptr) && is_cctype(*sptr, mask))
+          sptr++;
+        return static_cast<size_t>(sptr - tptr);
+      }
 
-using Xparse = ::rocket::variant<S_xparse_array, S_xparse_object>;
+    const char*
+    do_skip_digits(const char* tptr, uint8_t mask)
+      const noexcept
+      {
+        // Digit separators are accepted and will be removed later.
+        auto sptr = tptr;
+        while((sptr != this->m_eptr) && ((*sptr == '`') || is_cctype(*sptr, mask)))
+          sptr++;
+        return sptr;
+      }
 
-Value
-do_json_parse_nonrecursive(Token_Stream& tstrm)
-  {
-    Value value;
+    const char*
+    do_find_string_special(const char* tptr, char head)
+      const noexcept
+      {
+        // Look for a quotation mark, a backslash, a line feed, a null character
+        // or a non-ASCII character, which requires special handling.
+        auto sptr = tptr;
+#ifdef __SSE2__
+        auto t_head = _mm_set1_epi8(head);
+        auto t_bsl = _mm_set1_epi8('\\');
+        auto t_lf = _mm_set1_epi8('\n');
+        auto t_nul = _mm_setzero_si128();
+        while(this->m_eptr - sptr >= 16) {
+          auto t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr));
+          auto r = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(t, t_head), _mm_cmpeq_epi8(t, t_bsl)),
+                                _mm_or_si128(_mm_cmpeq_epi8(t, t_lf), _mm_cmpeq_epi8(t, t_nul)));
+          uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(r, t)));
+          if(mask != 0)
+            return sptr + __builtin_ctz(mask);
+          sptr += 16;
+        }
+#endif
+        while(sptr != this->m_eptr) {
+          char c = *sptr;
+          if((c == head) || (c == '\\') || (c == '\n') || (c == 0) || (c & 0x80))
+            break;
+          sptr++;
+        }
+        return sptr;
+      }
 
-    // Implement a non-recursive descent parser.
-    cow_vector<Xparse> stack;
+  public:
+    // Skips spaces and comments, then returns the next character, or `-1` if
+    // the end of input has been reached.
+    int
+    peek_nonspace()
+      {
+        for(;;) {
+          if(this->m_rptr == this->m_eptr) {
+            this->do_check_partial();
+            return -1;
+          }
 
-    for(;;) {
-      // Accept a value. No other things such as closed brackets are allowed.
-      auto qtok = tstrm.peek_opt();
-      if(!qtok)
-        throw Parser_Error(parser_status_expression_expected, tstrm);
-
-      switch(weaken_enum(qtok->index())) {
-        case Token::index_punctuator: {
-          // Accept an `[` or `{`.
-          auto punct = qtok->as_punctuator();
-          switch(weaken_enum(punct)) {
-            case punctuator_bracket_op: {
-              tstrm.shift();
-
-              // Open an array.
-              auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl });
-              if(!kpunct) {
-                // Descend into the new array.
-                S_xparse_array ctxa = { V_array() };
-                stack.emplace_back(::std::move(ctxa));
-                continue;
-              }
+          char c = *(this->m_rptr);
+          if(is_cctype(c, cctype_space)) {
+            this->m_rptr++;
+            continue;
+          }
 
-              // Accept an empty array.
-              value = V_array();
-              break;
-            }
+          if(c != '/')
+            return static_cast<unsigned char>(c);
 
-            case punctuator_brace_op: {
-              tstrm.shift();
+          if(this->m_eptr - this->m_rptr < 2) {
+            this->do_check_partial();
+            return '/';
+          }
 
-              // Open an object.
-              auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl });
-              if(!kpunct) {
-                // Descend into the new object.
-                S_xparse_object ctxo = { V_object(), do_accept_object_key(tstrm) };
-                stack.emplace_back(::std::move(ctxo));
-                continue;
-              }
+          if(this->m_rptr[1] == '/') {
+            // Discard all remaining characters in this line.
+            auto tptr = static_cast<const char*>(::std::memchr(this->m_rptr, '\n',
+                                  static_cast<size_t>(this->m_eptr - this->m_rptr)));
+            if(!tptr)
+              this->do_check_partial();
 
-              // Accept an empty object.
-              value = V_object();
-              break;
+            this->m_rptr = tptr ? tptr : this->m_eptr;
+            continue;
+          }
+
+          if(this->m_rptr[1] == '*') {
+            // Search for the terminator of this block comment.
+            auto tptr = ::std::search(this->m_rptr + 2, this->m_eptr, "*/", "*/" + 2);
+            if(tptr == this->m_eptr) {
+              this->do_check_partial();
+              this->throw_error(parser_status_block_comment_unclosed, this->m_rptr, 2);
             }
 
-            default:
-              throw Parser_Error(parser_status_expression_expected, tstrm);
+            this->m_rptr = tptr + 2;
+            continue;
           }
-          break;
+          return '/';
         }
+      }
 
-        case Token::index_identifier: {
-          // Accept a literal.
-          const auto& name = qtok->as_identifier();
-          if(::rocket::is_none_of(name, { "null", "true", "false", "Infinity", "NaN" }))
-            throw Parser_Error(parser_status_expression_expected, tstrm);
+    bool
+    accept_punctuator(char punct)
+      {
+        if(this->peek_nonspace() != punct)
+          return false;
+
+        this->m_rptr++;
+        return true;
+      }
+
+    [[noreturn]]
+    void
+    throw_error(Parser_Status status, const char* tptr, size_t tlen)
+      const
+      {
+        // Calculate the line and column numbers, which are 1-based.
+        int line = this->m_line;
+        int column = this->m_column;
+        this->do_count_lines(line, column, tptr);
+        throw Parser_Error(status, Source_Location(sref("[JSON text]"), line, column), tlen);
+      }
+
+    [[noreturn]]
+    void
+    throw_error(Parser_Status status)
+      const
+      {
+        this->throw_error(status, this->m_rptr, (this->m_rptr != this->m_eptr));
+      }
+
+    // These are used for streaming. The input is treated as partial until
+    // `reload()` is called with `final` set. Once a value has been accepted,
+    // `commit()` shall be called to mark the beginning of the next one.
+    const char*
+    begin()
+      const noexcept
+      { return this->m_bptr;  }
+
+    void
+    reload(const char* bptr, const char* eptr, bool final)
+      noexcept
+      {
+        this->m_bptr = bptr;
+        this->m_eptr = eptr;
+        this->m_rptr = bptr;
+        this->m_final = final;
+      }
+
+    void
+    commit()
+      noexcept
+      {
+        this->do_count_lines(this->m_line, this->m_column, this->m_rptr);
+        this->m_bptr = this->m_rptr;
+
+        // Don't let the key cache grow indefinitely.
+        if(this->m_keys.size() > 1000)
+          this->m_keys.clear();
+      }
+
+    void
+    rewind()
+      noexcept
+      { this->m_rptr = this->m_bptr;  }
+
+    // Parses a string literal, whose opening quotation mark is `*m_rptr`.
+    cow_string
+    parse_string()
+      {
+        auto qptr = this->m_rptr;
+        char head = *qptr;
+        auto sptr = qptr + 1;
+        cow_string val;
+
+        for(;;) {
+          // Copy characters that require no special handling in bulk.
+          auto tptr = this->do_find_string_special(sptr, head);
+          val.append(sptr, tptr);
+          sptr = tptr;
+
+          if(sptr == this->m_eptr)
+            this->do_check_partial();
+
+          if((sptr == this->m_eptr) || (*sptr == '\n'))
+            this->throw_error(parser_status_string_literal_unclosed, qptr,
+                                 static_cast<size_t>(sptr - qptr));
+
+          char next = *sptr;
+          if(next == 0)
+            this->throw_error(parser_status_null_character_disallowed, sptr, 1);
+
+          if(next & 0x80) {
+            // Validate a multi-byte UTF-8 sequence and copy it verbatim.
+            char32_t cp;
+            tptr = sptr;
+            if(!utf8_decode(cp, tptr, static_cast<size_t>(this->m_eptr - sptr))) {
+              if(this->m_eptr - sptr < 4)
+                this->do_check_partial();
+
+              this->throw_error(parser_status_utf8_sequence_invalid, sptr,
+                                   static_cast<size_t>(this->m_eptr - sptr));
+            }
+
+            val.append(sptr, tptr);
+            sptr = tptr;
+            continue;
+          }
+
+          sptr++;
+          if(next == head) {
+            // The end of this string is encountered. Finish.
+            break;
+          }
+
+          // Translate this escape sequence.
+          if(sptr == this->m_eptr)
+            this->do_check_partial();
+
+          if((sptr == this->m_eptr) || (*sptr == '\n'))
+            this->throw_error(parser_status_escape_sequence_incomplete, qptr,
+                                 static_cast<size_t>(sptr - qptr));
+
+          next = *(sptr++);
+          int xcnt = 0;
+          switch(next) {
+            case '\'':
+            case '\"':
+            case '\\':
+            case '?':
+            case '/':
+              val.push_back(next);
+              break;
+
+            case 'a':
+              val.push_back('\a');
+              break;
+
+            case 'b':
+              val.push_back('\b');
+              break;
+
+            case 'f':
+              val.push_back('\f');
+              break;
 
-          switch(name[0]) {
             case 'n':
-              value = nullopt;
+              val.push_back('\n');
+              break;
+
+            case 'r':
+              val.push_back('\r');
               break;
 
             case 't':
-              value = true;
+              val.push_back('\t');
               break;
 
-            case 'f':
-              value = false;
+            case 'v':
+              val.push_back('\v');
+              break;
+
+            case '0':
+              val.push_back('\0');
               break;
 
-            case 'I':
-              value = ::std::numeric_limits<double>::infinity();
+            case 'Z':
+              val.push_back('\x1A');
               break;
 
-            case 'N':
-              value = ::std::numeric_limits<double>::quiet_NaN();
+            case 'e':
+              val.push_back('\x1B');
               break;
 
+            case 'U':
+              xcnt += 2;
+              // Fallthrough
+            case 'u':
+              xcnt += 2;
+              // Fallthrough
+            case 'x': {
+              // How many hex digits are there?
+              xcnt += 2;
+
+              // Read hex digits.
+              char32_t cp = 0;
+              for(int i = 0;  i < xcnt;  ++i) {
+                // Read a hex digit.
+                if(sptr == this->m_eptr)
+                  this->do_check_partial();
+
+                if((sptr == this->m_eptr) || (*sptr == '\n'))
+                  this->throw_error(parser_status_escape_sequence_incomplete, qptr,
+                                       static_cast<size_t>(sptr - qptr));
+
+                char c = *sptr;
+                if(!is_cctype(c, cctype_xdigit))
+                  this->throw_error(parser_status_escape_sequence_invalid_hex, qptr,
+                                       static_cast<size_t>(sptr - qptr));
+
+                // Accumulate this digit.
+                sptr++;
+                uint32_t dval = static_cast<uint8_t>(c);
+                dval |= 0x20;
+
+                cp *= 16;
+                cp += (dval <= '9') ? (dval - '0') : (dval - 'a' + 10);
+              }
+
+              if(next == 'x') {
+                // Write the character verbatim.
+                val.push_back(static_cast<char>(cp));
+              }
+              else {
+                // Write a Unicode code point.
+                if(!utf8_encode(val, cp))
+                  this->throw_error(parser_status_escape_utf_code_point_invalid, qptr,
+                                       static_cast<size_t>(sptr - qptr));
+              }
+              break;
+            }
+
             default:
-              ROCKET_ASSERT(false);
+              this->throw_error(parser_status_escape_sequence_unknown, qptr,
+                                   static_cast<size_t>(sptr - qptr));
           }
-          tstrm.shift();
-          break;
         }
 
-        case Token::index_real_literal:
-          // Accept a number.
-          value = qtok->as_real_literal();
-          tstrm.shift();
+        this->m_rptr = sptr;
+        return val;
+      }
+
+    // Parses an identifier, whose first character is `*m_rptr`.
+    pair<const char*, size_t>
+    parse_identifier()
+      {
+        auto tptr = this->m_rptr;
+        size_t tlen = this->do_mask_length(tptr, cctype_namei | cctype_digit);
+        if(tptr + tlen == this->m_eptr)
+          this->do_check_partial();
+
+        this->m_rptr += tlen;
+        return ::std::make_pair(tptr, tlen);
+      }
+
+    // Parses a numeric literal, whose first character is `*m_rptr`. This
+    // function returns `false` if no number can be accepted, which also means
+    // nothing has been consumed.
+    bool
+    parse_number(V_real& val)
+      {
+        auto tptr = this->m_rptr;
+        auto sptr = tptr;
+        double sign = 1;
+
+        // Look for an explicit sign symbol.
+        switch(*sptr) {
+          case '+':
+            sptr++;
+            break;
+
+          case '-':
+            sptr++;
+            sign = -1;
+            break;
+        }
+        if(sptr == this->m_eptr) {
+          this->do_check_partial();
+          return false;
+        }
+
+        uint8_t mmask = cctype_digit;
+        char expch = 'e';
+        switch(*sptr) {
+          case 'n':
+          case 'N': {
+            size_t tlen = this->do_mask_length(sptr, cctype_namei | cctype_digit);
+            if(sptr + tlen == this->m_eptr)
+              this->do_check_partial();
+
+            if(tlen != 3)
+              return false;
+
+            if((sptr[1] != 'a') || (sptr[2] != sptr[0]))  // `nan` or `NaN`
+              return false;
+
+            val = ::std::copysign(::std::numeric_limits<V_real>::quiet_NaN(), sign);
+            this->m_rptr = sptr + 3;
+            return true;
+          }
+
+          case 'i':
+          case 'I': {
+            size_t tlen = this->do_mask_length(sptr, cctype_namei | cctype_digit);
+            if(sptr + tlen == this->m_eptr)
+              this->do_check_partial();
+
+            if(tlen != 8)
+              return false;
+
+            if(::std::memcmp(sptr + 1, "nfinity", 7) != 0)  // `infinity` or `Infinity`
+              return false;
+
+            val = ::std::copysign(::std::numeric_limits<V_real>::infinity(), sign);
+            this->m_rptr = sptr + 8;
+            return true;
+          }
+
+          case '0':
+            sptr++;
+
+            // Check the radix identifier.
+            if((sptr != this->m_eptr) && ::rocket::is_any_of(*sptr | 0x20, { 'b', 'x' })) {
+              sptr++;
+
+              // Accept the radix identifier.
+              mmask = cctype_xdigit;
+              expch = 'p';
+            }
+
+            // Fallthrough
+          case '1':
+          case '2':
+          case '3':
+          case '4':
+          case '5':
+          case '6':
+          case '7':
+          case '8':
+          case '9':
+            break;
+
+          default:
+            return false;
+        }
+
+        // Accept the longest string composing the integral part.
+        sptr = this->do_skip_digits(sptr, mmask);
+
+        // Check for a radix point. If one exists, the fractional part shall follow.
+        if((sptr != this->m_eptr) && (*sptr == '.'))
+          sptr = this->do_skip_digits(sptr + 1, mmask);
+
+        // Check for the exponent.
+        if((sptr != this->m_eptr) && ((*sptr | 0x20) == expch)) {
+          sptr++;
+
+          // Check for an optional sign symbol.
+          if((sptr != this->m_eptr) && ::rocket::is_any_of(*sptr, { '+', '-' }))
+            sptr++;
+
+          sptr = this->do_skip_digits(sptr, cctype_digit);
+        }
+
+        // Accept numeric suffixes, which will definitely cause errors.
+        sptr = this->do_skip_digits(sptr, cctype_alpha | cctype_digit);
+        if(sptr == this->m_eptr)
+          this->do_check_partial();
+
+        size_t tlen = static_cast<size_t>(sptr - tptr);
+
+        // Digit separators are rare. If there are any, remove them.
+        const char* bp = tptr;
+        const char* ep = sptr;
+        cow_string tstr;
+        if(::std::find(bp, ep, '`') != ep) {
+          ::std::remove_copy(bp, ep, ::std::back_inserter(tstr), '`');
+          bp = tstr.data();
+          ep = tstr.data() + tstr.size();
+        }
+
+        // Convert the token to a real number.
+        ::rocket::ascii_numget numg;
+        if(!numg.parse_F(bp, ep))
+          this->throw_error(parser_status_numeric_literal_invalid, tptr, tlen);
+
+        if(bp != ep)
+          this->throw_error(parser_status_numeric_literal_suffix_invalid, tptr, tlen);
+
+        numg.cast_F(val, -DBL_MAX, DBL_MAX);
+        if(numg.overflowed())
+          this->throw_error(parser_status_real_literal_overflow, tptr, tlen);
+
+        if(numg.underflowed())
+          this->throw_error(parser_status_real_literal_underflow, tptr, tlen);
+
+        if(!numg)
+          this->throw_error(parser_status_numeric_literal_invalid, tptr, tlen);
+
+        this->m_rptr = sptr;
+        return true;
+      }
+
+    phsh_string
+    parse_object_key()
+      {
+        cow_string name;
+        int next = this->peek_nonspace();
+        if((next == '\"') || (next == '\''))
+          name = this->parse_string();
+        else if((next != -1) && is_cctype(static_cast<char>(next), cctype_namei)) {
+          auto ident = this->parse_identifier();
+          name.assign(ident.first, ident.second);
+        }
+        else
+          this->throw_error(parser_status_closed_brace_or_json5_key_expected);
+
+        if(!this->accept_punctuator(':'))
+          this->throw_error(parser_status_colon_expected);
+
+        return this->m_keys.try_emplace(::std::move(name)).first->first;
+      }
+  };
+
+struct S_xparse_array
+  {
+    V_array array;
+  };
+
+struct S_xparse_object
+  {
+    V_object object;
+    phsh_string key;
+  };
+
+using Xparse = ::rocket::variant<S_xparse_array, S_xparse_object>;
+
+Value
+do_json_parse_nonrecursive(JSON_Parser& parser)
+  {
+    Value value;
+
+    // Implement a non-recursive descent parser.
+    cow_vector<Xparse> stack;
+
+    for(;;) {
+      // Accept a value. No other things such as closed brackets are allowed.
+      int next = parser.peek_nonspace();
+      switch(next) {
+        case '[':
+          parser.accept_punctuator('[');
+
+          // Open an array.
+          if(!parser.accept_punctuator(']')) {
+            // Descend into the new array.
+            S_xparse_array ctxa = { V_array() };
+            stack.emplace_back(::std::move(ctxa));
+            continue;
+          }
+
+          // Accept an empty array.
+          value = V_array();
+          break;
+
+        case '{':
+          parser.accept_punctuator('{');
+
+          // Open an object.
+          if(!parser.accept_punctuator('}')) {
+            // Descend into the new object.
+            S_xparse_object ctxo = { V_object(), parser.parse_object_key() };
+            stack.emplace_back(::std::move(ctxo));
+            continue;
+          }
+
+          // Accept an empty object.
+          value = V_object();
           break;
 
-        case Token::index_string_literal:
+        case '\"':
+        case '\'':
           // Accept a UTF-8 string.
-          value = qtok->as_string_literal();
-          tstrm.shift();
+          value = parser.parse_string();
           break;
 
-        default:
-          throw Parser_Error(parser_status_expression_expected, tstrm);
+        default: {
+          // Accept a number.
+          V_real real;
+          if(parser.parse_number(real)) {
+            value = real;
+            break;
+          }
+
+          // Accept a literal.
+          if((next == -1) || !is_cctype(static_cast<char>(next), cctype_namei))
+            parser.throw_error(parser_status_expression_expected);
+
+          auto ident = parser.parse_identifier();
+          if((ident.second == 4) && (::std::memcmp(ident.first, "null", 4) == 0))
+            value = nullopt;
+          else if((ident.second == 4) && (::std::memcmp(ident.first, "true", 4) == 0))
+            value = true;
+          else if((ident.second == 5) && (::std::memcmp(ident.first, "false", 5) == 0))
+            value = false;
+          else
+            parser.throw_error(parser_status_expression_expected, ident.first, ident.second);
+          break;
+        }
       }
 
       // A complete value has been accepted. Insert it into its parent array or object.
@@ -606,17 +1133,14 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
           ctxa.array.emplace_back(::std::move(value));
 
           // Look for the next element.
-          auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl, punctuator_comma });
-          if(!kpunct)
-            throw Parser_Error(parser_status_closed_bracket_or_comma_expected, tstrm);
+          bool comma = parser.accept_punctuator(',');
+          if(!comma && (parser.peek_nonspace() != ']'))
+            parser.throw_error(parser_status_closed_bracket_or_comma_expected);
 
           // Check for termination of this array.
-          if(*kpunct != punctuator_bracket_cl) {
-            kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl });
-            if(!kpunct) {
-              // Look for the next element.
-              break;
-            }
+          if(!parser.accept_punctuator(']')) {
+            // Look for the next element.
+            break;
           }
 
           // Close this array.
@@ -627,18 +1151,15 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
           ctxo.object.insert_or_assign(::std::move(ctxo.key), ::std::move(value));
 
           // Look for the next element.
-          auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl, punctuator_comma });
-          if(!kpunct)
-            throw Parser_Error(parser_status_closed_brace_or_comma_expected, tstrm);
-
-          // Check for termination of this array.
-          if(*kpunct != punctuator_brace_cl) {
-            kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl });
-            if(!kpunct) {
-              // Look for the next element.
-              ctxo.key = do_accept_object_key(tstrm);
-              break;
-            }
+          bool comma = parser.accept_punctuator(',');
+          if(!comma && (parser.peek_nonspace() != '}'))
+            parser.throw_error(parser_status_closed_brace_or_comma_expected);
+
+          // Check for termination of this object.
+          if(!parser.accept_punctuator('}')) {
+            // Look for the next element.
+            ctxo.key = parser.parse_object_key();
+            break;
           }
 
           // Close this object.
@@ -650,23 +1171,18 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
   }
 
 Value
-do_json_parse(tinybuf& cbuf)
+do_json_parse(const char* bptr, const char* eptr)
   try {
-    // We reuse the lexer of Asteria here, allowing quite a few extensions e.g. binary numeric
-    // literals and comments.
-    Compiler_Options opts;
-    opts.escapable_single_quotes = true;
-    opts.keywords_as_identifiers = true;
-    opts.integers_as_reals = true;
-
-    Token_Stream tstrm(opts);
-    tstrm.reload(sref("[JSON text]"), 1, cbuf);
-    if(tstrm.empty())
+    // Scan the text directly. This accepts the same syntax as the lexer of Asteria
+    // with `escapable_single_quotes`, `keywords_as_identifiers` and `integers_as_reals`
+    // set, allowing quite a few extensions e.g. binary numeric literals and comments.
+    JSON_Parser parser(bptr, eptr);
+    if(parser.peek_nonspace() == -1)
       ASTERIA_THROW("Empty JSON string");
 
     // Parse a single value.
-    auto value = do_json_parse_nonrecursive(tstrm);
-    if(!tstrm.empty())
+    auto value = do_json_parse_nonrecursive(parser);
+    if(parser.peek_nonspace() != -1)
       ASTERIA_THROW("Excess text at end of JSON string");
     return value;
   }
@@ -675,51 +1191,178 @@ do_json_parse(tinybuf& cbuf)
                   except.line(), except.column(), describe_parser_status(except.status()));
   }
 
+enum Stream_State : uint8_t
+  {
+    stream_state_initial   = 0,
+    stream_state_array     = 1,
+    stream_state_values    = 2,
+    stream_state_trailing  = 3,
+  };
+
+template<typename ReadT>
+V_integer
+do_json_parse_stream(Global_Context& global, V_function callback, cow_string& buf, bool final,
+                     ReadT&& read_more)
+  try {
+    // If the text starts with an open bracket, elements of this array are taken
+    // as records. Otherwise, the text is a sequence of values, such as NDJSON.
+    // Only the current record is kept in `buf`, together with characters that
+    // haven't been parsed.
+    Prepared_Call call(global, callback);
+    JSON_Parser parser(nullptr, nullptr);
+    parser.reload(buf.data(), buf.data() + buf.size(), final);
+    Stream_State state = stream_state_initial;
+    V_integer count = 0;
+
+    for(;;)
+      try {
+        Value value;
+        switch(state) {
+          case stream_state_initial: {
+            int next = parser.peek_nonspace();
+            if(next == -1)
+              return count;
+
+            if(next != '[') {
+              state = stream_state_values;
+              continue;
+            }
+
+            // Open the top-level array, which may be empty.
+            parser.accept_punctuator('[');
+            state = parser.accept_punctuator(']') ? stream_state_trailing : stream_state_array;
+            parser.commit();
+            continue;
+          }
+
+          case stream_state_array: {
+            // Accept an element, then look for the next one.
+            value = do_json_parse_nonrecursive(parser);
+            bool comma = parser.accept_punctuator(',');
+            if(!comma && (parser.peek_nonspace() != ']'))
+              parser.throw_error(parser_status_closed_bracket_or_comma_expected);
+
+            if(parser.accept_punctuator(']'))
+              state = stream_state_trailing;
+            break;
+          }
+
+          case stream_state_values:
+            if(parser.peek_nonspace() == -1)
+              return count;
+
+            // Accept a value.
+            value = do_json_parse_nonrecursive(parser);
+            break;
+
+          case stream_state_trailing:
+            if(parser.peek_nonspace() != -1)
+              ASTERIA_THROW("Excess text at end of JSON stream");
+            return count;
+
+          default:
+            ASTERIA_TERMINATE("invalid JSON stream state (state `$1`)", state);
+        }
+
+        // Pass this record to the callback but discard its return value.
+        parser.commit();
+        call.push_argument(count);
+        call.push_argument(::std::move(value));
+        call.invoke();
+        count ++;
+      }
+      catch(JSON_Partial&) {
+        // Discard characters that have been consumed, then read more and retry.
+        parser.rewind();
+        buf.erase(0, static_cast<size_t>(parser.begin() - buf.data()));
+        final = !read_more(buf);
+        parser.reload(buf.data(), buf.data() + buf.size(), final);
+      }
+  }
+  catch(Parser_Error& except) {
+    ASTERIA_THROW("Invalid JSON stream: $3 (line $1, column $2)",
+                  except.line(), except.column(), describe_parser_status(except.status()));
+  }
+
 }  // namespace
 
 V_string
 std_json_format(Value value, Opt_string indent)
   {
-    // No line break is inserted if `indent` is null or empty.
-    return (!indent || indent->empty())
-               ? do_format_nonrecursive(value, false, Indenter_none())
-               : do_format_nonrecursive(value, false, Indenter_string(*indent));
+    return do_format_to_string(value, false, indent);
   }
 
 V_string
 std_json_format(Value value, V_integer indent)
   {
-    // No line break is inserted if `indent` is non-positive.
-    return (indent <= 0)
-               ? do_format_nonrecursive(value, false, Indenter_none())
-               : do_format_nonrecursive(value, false, Indenter_spaces(indent));
+    return do_format_to_string(value, false, indent);
   }
 
 V_string
 std_json_format5(Value value, Opt_string indent)
   {
-    // No line break is inserted if `indent` is null or empty.
-    return (!indent || indent->empty())
-               ? do_format_nonrecursive(value, true, Indenter_none())
-               : do_format_nonrecursive(value, true, Indenter_string(*indent));
+    return do_format_to_string(value, true, indent);
   }
 
 V_string
 std_json_format5(Value value, V_integer indent)
   {
-    // No line break is inserted if `indent` is non-positive.
-    return (indent <= 0)
-               ? do_format_nonrecursive(value, true, Indenter_none())
-               : do_format_nonrecursive(value, true, Indenter_spaces(indent));
+    return do_format_to_string(value, true, indent);
+  }
+
+void
+std_json_format_to_file(V_string path, Value value, Opt_string indent)
+  {
+    // Try opening the file.
+    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "wb"), ::fclose);
+    if(!fp)
+      ASTERIA_THROW("Could not open file '$2'\n"
+                    "[`fopen()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Write characters into the file directly.
+    do_format_to_file(fp, value, indent);
+  }
+
+void
+std_json_format_to_file(V_string path, Value value, V_integer indent)
+  {
+    // Try opening the file.
+    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "wb"), ::fclose);
+    if(!fp)
+      ASTERIA_THROW("Could not open file '$2'\n"
+                    "[`fopen()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Write characters into the file directly.
+    do_format_to_file(fp, value, indent);
+  }
+
+void
+std_json_format_to_stdout(Value value, Opt_string indent)
+  {
+    // Standard output must be byte-oriented.
+    if(!set_file_orientation(stdout, "w", -1))
+      ASTERIA_THROW("Invalid binary write to text-oriented output");
+
+    do_format_to_file(stdout, value, indent);
+  }
+
+void
+std_json_format_to_stdout(Value value, V_integer indent)
+  {
+    // Standard output must be byte-oriented.
+    if(!set_file_orientation(stdout, "w", -1))
+      ASTERIA_THROW("Invalid binary write to text-oriented output");
+
+    do_format_to_file(stdout, value, indent);
   }
 
 Value
 std_json_parse(V_string text)
   {
     // Parse characters from the string.
-    ::rocket::tinybuf_str cbuf;
-    cbuf.set_string(text, tinybuf::open_read);
-    return do_json_parse(cbuf);
+    return do_json_parse(text.data(), text.data() + text.size());
   }
 
 Value
@@ -732,10 +1375,61 @@ std_json_parse_file(V_string path)
                     "[`fopen()` failed: $1]",
                     format_errno(errno), path);
 
-    // Parse characters from the file.
+    // Read the entire file, then parse it as a string.
+    cow_string text;
     ::setbuf(fp, nullptr);
-    ::rocket::tinybuf_file cbuf(::std::move(fp));
-    return do_json_parse(cbuf);
+    for(;;) {
+      size_t off = text.size();
+      text.append(0x10000, '\0');
+      size_t nread = ::fread(text.mut_data() + off, 1, 0x10000, fp);
+      text.erase(off + nread);
+      if(nread == 0) {
+        if(::ferror(fp))
+          ASTERIA_THROW("Error reading file '$2'\n"
+                        "[`fread()` failed: $1]",
+                        format_errno(errno), path);
+        break;
+      }
+    }
+    return do_json_parse(text.data(), text.data() + text.size());
+  }
+
+V_integer
+std_json_parse_stream(Global_Context& global, V_string text, V_function callback)
+  {
+    // The string is complete, so no more characters will be read.
+    return do_json_parse_stream(global, ::std::move(callback), text, true,
+                                [](cow_string&) { return false;  });
+  }
+
+V_integer
+std_json_parse_file_stream(Global_Context& global, V_string path, V_function callback)
+  {
+    // Open the file for reading.
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY), ::close);
+    if(!fd)
+      ASTERIA_THROW("Could not open file '$2'\n"
+                    "[`open()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Read the file in chunks. If a record is longer than a chunk, the buffer
+    // will grow exponentially.
+    V_string buf;
+    return do_json_parse_stream(global, ::std::move(callback), buf, false,
+      [&](cow_string& data) {
+        size_t off = data.size();
+        size_t nbatch = ::rocket::max(off, size_t(0x100000));
+        data.append(nbatch, '/');
+
+        ::ssize_t nread = ::read(fd, data.mut_data() + off, nbatch);
+        if(nread < 0)
+          ASTERIA_THROW("Error reading file '$2'\n"
+                        "[`read()` failed: $1]",
+                        format_errno(errno), path);
+
+        data.erase(off + static_cast<size_t>(nread));
+        return nread != 0;
+      });
   }
 
 void
@@ -783,6 +1477,52 @@ create_bindings_json(V_object& result, API_Version /*version*/)
       }
       ASTERIA_BINDING_END);
 
+    result.insert_or_assign(sref("format_to_file"),
+      ASTERIA_BINDING_BEGIN("std.json.format_to_file", self, global, reader) {
+        V_string path;
+        Value value;
+        Opt_string sind;
+        V_integer iind;
+
+        reader.start_overload();
+        reader.required(path);    // path
+        reader.optional(value);   // [value]
+        reader.save_state(0);
+        reader.optional(sind);    // [indent]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_json_format_to_file, path, value, sind);
+
+        reader.load_state(0);     // path, [value]
+        reader.required(iind);    // indent
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_json_format_to_file, path, value, iind);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("format_to_stdout"),
+      ASTERIA_BINDING_BEGIN("std.json.format_to_stdout", self, global, reader) {
+        Value value;
+        Opt_string sind;
+        V_integer iind;
+
+        reader.start_overload();
+        reader.optional(value);   // [value]
+        reader.save_state(0);
+        reader.optional(sind);    // [indent]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_json_format_to_stdout, value, sind);
+
+        reader.load_state(0);     // [value]
+        reader.required(iind);    // indent
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_json_format_to_stdout, value, iind);
+      }
+      ASTERIA_BINDING_END);
+
     result.insert_or_assign(sref("parse"),
       ASTERIA_BINDING_BEGIN("std.json.parse", self, global, reader) {
         V_string text;
@@ -806,6 +1546,34 @@ create_bindings_json(V_object& result, API_Version /*version*/)
                     std_json_parse_file, path);
       }
       ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("parse_stream"),
+      ASTERIA_BINDING_BEGIN("std.json.parse_stream", self, global, reader) {
+        V_string text;
+        V_function func;
+
+        reader.start_overload();
+        reader.required(text);    // text
+        reader.required(func);    // callback
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_json_parse_stream, global, text, func);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("parse_file_stream"),
+      ASTERIA_BINDING_BEGIN("std.json.parse_file_stream", self, global, reader) {
+        V_string path;
+        V_function func;
+
+        reader.start_overload();
+        reader.required(path);    // path
+        reader.required(func);    // callback
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_json_parse_file_stream, global, path, func);
+      }
+      ASTERIA_BINDING_END);
   }
 
 }  // namespace asteria
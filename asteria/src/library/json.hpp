@@ -22,6 +22,20 @@ std_json_format5(Value value, Opt_string indent);
 V_string
 std_json_format5(Value value, V_integer indent);
 
+// `std.json.format_to_file`
+void
+std_json_format_to_file(V_string path, Value value, Opt_string indent);
+
+void
+std_json_format_to_file(V_string path, Value value, V_integer indent);
+
+// `std.json.format_to_stdout`
+void
+std_json_format_to_stdout(Value value, Opt_string indent);
+
+void
+std_json_format_to_stdout(Value value, V_integer indent);
+
 // `std.json.parse`
 Value
 std_json_parse(V_string text);
@@ -30,6 +44,14 @@ std_json_parse(V_string text);
 Value
 std_json_parse_file(V_string path);
 
+// `std.json.parse_stream`
+V_integer
+std_json_parse_stream(Global_Context& global, V_string text, V_function callback);
+
+// `std.json.parse_file_stream`
+V_integer
+std_json_parse_file_stream(Global_Context& global, V_string path, V_function callback);
+
 // Create an object that is to be referenced as `std.json`.
 void
 create_bindings_json(V_object& result, API_Version version);
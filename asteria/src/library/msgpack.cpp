@@ -0,0 +1,857 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "msgpack.hpp"
+#include "../runtime/argument_reader.hpp"
+#include "../runtime/global_context.hpp"
+#include "../runtime/prepared_call.hpp"
+#include "../utils.hpp"
+#include "../../rocket/tinyfmt_file.hpp"
+#include <fcntl.h>  // ::open()
+
+namespace asteria {
+namespace {
+
+// This is the format of MessagePack, as described in
+//   https://github.com/msgpack/msgpack/blob/master/spec.md
+// All multi-byte values are stored in big-endian byte order.
+void
+do_write_header(tinyfmt& fmt, uint8_t tag, uint64_t value, size_t nbytes)
+  {
+    char sbuf[16];
+    sbuf[0] = static_cast<char>(tag);
+    for(size_t k = 0;  k != nbytes;  ++k)
+      sbuf[1 + k] = static_cast<char>(value >> (nbytes - 1 - k) * 8);
+    fmt.putn(sbuf, 1 + nbytes);
+  }
+
+void
+do_write_length(tinyfmt& fmt, uint8_t fixtag, size_t fixmax, uint8_t tag8, uint8_t tag16,
+                uint8_t tag32, size_t len)
+  {
+    // `tag8` is zero if there is no such form.
+    if(len <= fixmax)
+      do_write_header(fmt, static_cast<uint8_t>(fixtag | len), 0, 0);
+    else if(tag8 && (len <= UINT8_MAX))
+      do_write_header(fmt, tag8, len, 1);
+    else if(len <= UINT16_MAX)
+      do_write_header(fmt, tag16, len, 2);
+    else if(len <= UINT32_MAX)
+      do_write_header(fmt, tag32, len, 4);
+    else
+      ASTERIA_THROW("Length too large for MessagePack (length `$1`)", len);
+  }
+
+void
+do_write_string(tinyfmt& fmt, const cow_string& str)
+  {
+    // Strings in Asteria are byte strings, which are not necessarily valid
+    // UTF-8 text, but they are always encoded as `str`.
+    do_write_length(fmt, 0xA0, 31, 0xD9, 0xDA, 0xDB, str.size());
+    fmt.putn(str.data(), str.size());
+  }
+
+void
+do_write_integer(tinyfmt& fmt, int64_t ival)
+  {
+    // Use the shortest form.
+    uint64_t bits = static_cast<uint64_t>(ival);
+    if(ival >= 0) {
+      if(ival <= INT8_MAX)
+        do_write_header(fmt, static_cast<uint8_t>(ival), 0, 0);
+      else if(ival <= UINT8_MAX)
+        do_write_header(fmt, 0xCC, bits, 1);
+      else if(ival <= UINT16_MAX)
+        do_write_header(fmt, 0xCD, bits, 2);
+      else if(ival <= UINT32_MAX)
+        do_write_header(fmt, 0xCE, bits, 4);
+      else
+        do_write_header(fmt, 0xCF, bits, 8);
+    }
+    else {
+      if(ival >= -32)
+        do_write_header(fmt, static_cast<uint8_t>(bits), 0, 0);
+      else if(ival >= INT8_MIN)
+        do_write_header(fmt, 0xD0, bits, 1);
+      else if(ival >= INT16_MIN)
+        do_write_header(fmt, 0xD1, bits, 2);
+      else if(ival >= INT32_MIN)
+        do_write_header(fmt, 0xD2, bits, 4);
+      else
+        do_write_header(fmt, 0xD3, bits, 8);
+    }
+  }
+
+void
+do_write_real(tinyfmt& fmt, double real)
+  {
+    // If the value can be stored as a `float` without loss of precision, do
+    // so. Infinities and NaNs are always stored as `double`s.
+    if((::std::fabs(real) <= static_cast<double>(FLT_MAX))
+       && (static_cast<double>(static_cast<float>(real)) == real)) {
+      float flt = static_cast<float>(real);
+      uint32_t bits;
+      ::std::memcpy(&bits, &flt, 4);
+      do_write_header(fmt, 0xCA, bits, 4);
+    }
+    else {
+      uint64_t bits;
+      ::std::memcpy(&bits, &real, 8);
+      do_write_header(fmt, 0xCB, bits, 8);
+    }
+  }
+
+struct S_xencode_array
+  {
+    const V_array* refa;
+    V_array::const_iterator curp;
+  };
+
+struct S_xencode_object
+  {
+    const V_object* refo;
+    V_object::const_iterator curp;
+  };
+
+using Xencode = ::rocket::variant<S_xencode_array, S_xencode_object>;
+
+tinyfmt&
+do_encode_nonrecursive(tinyfmt& fmt, const Value& value)
+  {
+    // Transform recursion to iteration using a handwritten stack.
+    auto qval = &value;
+    cow_vector<Xencode> stack;
+
+    for(;;) {
+      // Encode a value. `qval` must always point to a valid value here.
+      switch(weaken_enum(qval->type())) {
+        case type_boolean:
+          do_write_header(fmt, qval->as_boolean() ? 0xC3 : 0xC2, 0, 0);
+          break;
+
+        case type_integer:
+          do_write_integer(fmt, qval->as_integer());
+          break;
+
+        case type_real:
+          do_write_real(fmt, qval->as_real());
+          break;
+
+        case type_string:
+          do_write_string(fmt, qval->as_string());
+          break;
+
+        case type_array: {
+          const auto& array = qval->as_array();
+          do_write_length(fmt, 0x90, 15, 0, 0xDC, 0xDD, array.size());
+
+          // Open an array.
+          S_xencode_array ctxa = { ::std::addressof(array), array.begin() };
+          if(ctxa.curp != array.end()) {
+            // Descend into the array.
+            qval = &(ctxa.curp[0]);
+            stack.emplace_back(::std::move(ctxa));
+            continue;
+          }
+          break;
+        }
+
+        case type_object: {
+          const auto& object = qval->as_object();
+          do_write_length(fmt, 0x80, 15, 0, 0xDE, 0xDF, object.size());
+
+          // Open an object.
+          S_xencode_object ctxo = { ::std::addressof(object), object.begin() };
+          if(ctxo.curp != object.end()) {
+            // Write the key, then descend into the object.
+            do_write_string(fmt, ctxo.curp->first);
+            qval = &(ctxo.curp->second);
+            stack.emplace_back(::std::move(ctxo));
+            continue;
+          }
+          break;
+        }
+
+        default:
+          // Anything else is censored to `nil`.
+          do_write_header(fmt, 0xC0, 0, 0);
+          break;
+      }
+
+      // A complete value has been written. Advance to the next element if any.
+      for(;;) {
+        if(stack.empty())
+          // Finish the root value.
+          return fmt;
+
+        // Advance to the next element.
+        if(stack.back().index() == 0) {
+          auto& ctxa = stack.mut_back().as<0>();
+          if(++(ctxa.curp) != ctxa.refa->end()) {
+            // Encode the next element.
+            qval = &(ctxa.curp[0]);
+            break;
+          }
+        }
+        else {
+          auto& ctxo = stack.mut_back().as<1>();
+          if(++(ctxo.curp) != ctxo.refo->end()) {
+            // Write the key, then encode the next value.
+            do_write_string(fmt, ctxo.curp->first);
+            qval = &(ctxo.curp->second);
+            break;
+          }
+        }
+        stack.pop_back();
+      }
+    }
+  }
+
+// This is thrown when the end of a partial input is reached. More bytes shall
+// be appended before decoding can be retried.
+struct MsgPack_Partial
+  {
+  };
+
+struct S_xdecode_array
+  {
+    V_array array;
+    size_t nrem;
+  };
+
+struct S_xdecode_object
+  {
+    V_object object;
+    size_t nrem;
+    phsh_string key;
+  };
+
+using Xdecode = ::rocket::variant<S_xdecode_array, S_xdecode_object>;
+
+class MsgPack_Decoder
+  {
+  private:
+    const char* m_bptr;
+    const char* m_eptr;
+    const char* m_rptr;
+    bool m_final = true;
+
+    // This is the offset of `m_bptr` from the beginning of input.
+    int64_t m_offset = 0;
+
+    // Object keys are usually repeated, so their storage is shared.
+    cow_dictionary<bool> m_keys;
+
+  public:
+    explicit
+    MsgPack_Decoder(const char* bptr, const char* eptr)
+      noexcept
+      : m_bptr(bptr), m_eptr(eptr), m_rptr(bptr)
+      { }
+
+  private:
+    [[noreturn]]
+    void
+    do_throw_error(const char* msg, const char* tptr)
+      const
+      {
+        ASTERIA_THROW("Invalid MessagePack data: $1 (offset `$2`)",
+                      msg, this->m_offset + (tptr - this->m_bptr));
+      }
+
+    const char*
+    do_consume(size_t nbytes)
+      {
+        if(static_cast<size_t>(this->m_eptr - this->m_rptr) < nbytes) {
+          if(!this->m_final)
+            throw MsgPack_Partial();
+
+          this->do_throw_error("unexpected end of data", this->m_eptr);
+        }
+        auto tptr = this->m_rptr;
+        this->m_rptr += nbytes;
+        return tptr;
+      }
+
+    uint64_t
+    do_consume_be(size_t nbytes)
+      {
+        auto tptr = this->do_consume(nbytes);
+        uint64_t value = 0;
+        for(size_t k = 0;  k != nbytes;  ++k)
+          value = value << 8 | static_cast<uint8_t>(tptr[k]);
+        return value;
+      }
+
+    int64_t
+    do_consume_be_signed(size_t nbytes)
+      {
+        // Sign-extend the value.
+        uint64_t value = this->do_consume_be(nbytes);
+        int shift = static_cast<int>(64 - nbytes * 8);
+        return static_cast<int64_t>(value << shift) >> shift;
+      }
+
+    size_t
+    do_consume_length(size_t nbytes)
+      {
+        return static_cast<size_t>(this->do_consume_be(nbytes));
+      }
+
+    cow_string
+    do_consume_string(size_t len)
+      {
+        auto tptr = this->do_consume(len);
+        return cow_string(tptr, len);
+      }
+
+    // Decodes a scalar value, or the header of an array or object. If an
+    // array or object is encountered, `count` is set to the number of its
+    // elements, and `1` or `2` is returned respectively. Otherwise, `value`
+    // is set and `0` is returned.
+    int
+    do_decode_header(Value& value, size_t& count)
+      {
+        auto tptr = this->m_rptr;
+        uint8_t tag = static_cast<uint8_t>(*(this->do_consume(1)));
+
+        // Check for fixed-length forms, where lengths are encoded in tags.
+        if(tag <= 0x7F) {
+          value = static_cast<int64_t>(tag);
+          return 0;
+        }
+
+        if(tag >= 0xE0) {
+          value = static_cast<int64_t>(static_cast<int8_t>(tag));
+          return 0;
+        }
+
+        if(tag <= 0x8F) {
+          count = tag & 0x0FU;
+          return 2;
+        }
+
+        if(tag <= 0x9F) {
+          count = tag & 0x0FU;
+          return 1;
+        }
+
+        if(tag <= 0xBF) {
+          value = this->do_consume_string(tag & 0x1FU);
+          return 0;
+        }
+
+        switch(tag) {
+          case 0xC0:
+            value = nullopt;
+            return 0;
+
+          case 0xC2:
+            value = false;
+            return 0;
+
+          case 0xC3:
+            value = true;
+            return 0;
+
+          case 0xC4:
+          case 0xD9:
+            value = this->do_consume_string(this->do_consume_length(1));
+            return 0;
+
+          case 0xC5:
+          case 0xDA:
+            value = this->do_consume_string(this->do_consume_length(2));
+            return 0;
+
+          case 0xC6:
+          case 0xDB:
+            value = this->do_consume_string(this->do_consume_length(4));
+            return 0;
+
+          case 0xCA: {
+            uint32_t bits = static_cast<uint32_t>(this->do_consume_be(4));
+            float flt;
+            ::std::memcpy(&flt, &bits, 4);
+            value = static_cast<double>(flt);
+            return 0;
+          }
+
+          case 0xCB: {
+            uint64_t bits = this->do_consume_be(8);
+            double real;
+            ::std::memcpy(&real, &bits, 8);
+            value = real;
+            return 0;
+          }
+
+          case 0xCC:
+            value = static_cast<int64_t>(this->do_consume_be(1));
+            return 0;
+
+          case 0xCD:
+            value = static_cast<int64_t>(this->do_consume_be(2));
+            return 0;
+
+          case 0xCE:
+            value = static_cast<int64_t>(this->do_consume_be(4));
+            return 0;
+
+          case 0xCF: {
+            uint64_t ival = this->do_consume_be(8);
+            if(ival > INT64_MAX)
+              this->do_throw_error("integer out of range", tptr);
+
+            value = static_cast<int64_t>(ival);
+            return 0;
+          }
+
+          case 0xD0:
+            value = this->do_consume_be_signed(1);
+            return 0;
+
+          case 0xD1:
+            value = this->do_consume_be_signed(2);
+            return 0;
+
+          case 0xD2:
+            value = this->do_consume_be_signed(4);
+            return 0;
+
+          case 0xD3:
+            value = this->do_consume_be_signed(8);
+            return 0;
+
+          case 0xDC:
+            count = this->do_consume_length(2);
+            return 1;
+
+          case 0xDD:
+            count = this->do_consume_length(4);
+            return 1;
+
+          case 0xDE:
+            count = this->do_consume_length(2);
+            return 2;
+
+          case 0xDF:
+            count = this->do_consume_length(4);
+            return 2;
+
+          case 0xC7:
+          case 0xC8:
+          case 0xC9:
+          case 0xD4:
+          case 0xD5:
+          case 0xD6:
+          case 0xD7:
+          case 0xD8:
+            this->do_throw_error("extension types not supported", tptr);
+
+          default:
+            this->do_throw_error("invalid type byte", tptr);
+        }
+      }
+
+    phsh_string
+    do_decode_key()
+      {
+        auto tptr = this->m_rptr;
+        uint8_t tag = static_cast<uint8_t>(*(this->do_consume(1)));
+        size_t len;
+        if((tag >= 0xA0) && (tag <= 0xBF))
+          len = tag & 0x1FU;
+        else if((tag == 0xD9) || (tag == 0xC4))
+          len = this->do_consume_length(1);
+        else if((tag == 0xDA) || (tag == 0xC5))
+          len = this->do_consume_length(2);
+        else if((tag == 0xDB) || (tag == 0xC6))
+          len = this->do_consume_length(4);
+        else
+          this->do_throw_error("object key not a string", tptr);
+
+        return this->m_keys.try_emplace(this->do_consume_string(len)).first->first;
+      }
+
+    size_t
+    do_clamp_reserve(size_t count)
+      const noexcept
+      {
+        // Each element takes at least one byte, so don't let malformed data
+        // allocate too much memory.
+        return ::rocket::min(count, static_cast<size_t>(this->m_eptr - this->m_rptr));
+      }
+
+  public:
+    // Returns whether all input has been consumed.
+    bool
+    at_end()
+      const
+      {
+        if(this->m_rptr != this->m_eptr)
+          return false;
+
+        if(!this->m_final)
+          throw MsgPack_Partial();
+        return true;
+      }
+
+    [[noreturn]]
+    void
+    throw_excess()
+      const
+      {
+        this->do_throw_error("excess data after value", this->m_rptr);
+      }
+
+    // These are used for streaming. The input is treated as partial until
+    // `reload()` is called with `final` set. Once a value has been accepted,
+    // `commit()` shall be called to mark the beginning of the next one.
+    const char*
+    begin()
+      const noexcept
+      { return this->m_bptr;  }
+
+    void
+    reload(const char* bptr, const char* eptr, bool final)
+      noexcept
+      {
+        this->m_bptr = bptr;
+        this->m_eptr = eptr;
+        this->m_rptr = bptr;
+        this->m_final = final;
+      }
+
+    void
+    commit()
+      noexcept
+      {
+        this->m_offset += this->m_rptr - this->m_bptr;
+        this->m_bptr = this->m_rptr;
+
+        // Don't let the key cache grow indefinitely.
+        if(this->m_keys.size() > 1000)
+          this->m_keys.clear();
+      }
+
+    void
+    rewind()
+      noexcept
+      { this->m_rptr = this->m_bptr;  }
+
+    Value
+    decode_value()
+      {
+        Value value;
+
+        // Implement a non-recursive descent decoder.
+        cow_vector<Xdecode> stack;
+
+        for(;;) {
+          size_t count;
+          int kind = this->do_decode_header(value, count);
+          switch(kind) {
+            case 0:
+              break;
+
+            case 1: {
+              // Open an array.
+              if(count != 0) {
+                // Descend into the new array.
+                S_xdecode_array ctxa = { V_array(), count };
+                ctxa.array.reserve(this->do_clamp_reserve(count));
+                stack.emplace_back(::std::move(ctxa));
+                continue;
+              }
+
+              // Accept an empty array.
+              value = V_array();
+              break;
+            }
+
+            case 2: {
+              // Open an object.
+              if(count != 0) {
+                // Descend into the new object.
+                S_xdecode_object ctxo = { V_object(), count, this->do_decode_key() };
+                ctxo.object.reserve(this->do_clamp_reserve(count));
+                stack.emplace_back(::std::move(ctxo));
+                continue;
+              }
+
+              // Accept an empty object.
+              value = V_object();
+              break;
+            }
+
+            default:
+              ASTERIA_TERMINATE("invalid MessagePack header kind (kind `$1`)", kind);
+          }
+
+          // A complete value has been accepted. Insert it into its parent array or object.
+          for(;;) {
+            if(stack.empty())
+              // Accept the root value.
+              return value;
+
+            if(stack.back().index() == 0) {
+              auto& ctxa = stack.mut_back().as<0>();
+              ctxa.array.emplace_back(::std::move(value));
+
+              // Look for the next element.
+              if(--(ctxa.nrem) != 0)
+                break;
+
+              // Close this array.
+              value = ::std::move(ctxa.array);
+            }
+            else {
+              auto& ctxo = stack.mut_back().as<1>();
+              ctxo.object.insert_or_assign(::std::move(ctxo.key), ::std::move(value));
+
+              // Look for the next element.
+              if(--(ctxo.nrem) != 0) {
+                ctxo.key = this->do_decode_key();
+                break;
+              }
+
+              // Close this object.
+              value = ::std::move(ctxo.object);
+            }
+            stack.pop_back();
+          }
+        }
+      }
+  };
+
+Value
+do_msgpack_decode(const char* bptr, const char* eptr)
+  {
+    MsgPack_Decoder decoder(bptr, eptr);
+    auto value = decoder.decode_value();
+    if(!decoder.at_end())
+      decoder.throw_excess();
+    return value;
+  }
+
+template<typename ReadT>
+V_integer
+do_msgpack_decode_stream(Global_Context& global, V_function callback, cow_string& buf,
+                         bool final, ReadT&& read_more)
+  {
+    // The input is a sequence of values, each of which is a record. Only the
+    // current record is kept in `buf`, together with bytes that haven't been
+    // decoded.
+    Prepared_Call call(global, callback);
+    MsgPack_Decoder decoder(nullptr, nullptr);
+    decoder.reload(buf.data(), buf.data() + buf.size(), final);
+    V_integer count = 0;
+
+    for(;;)
+      try {
+        if(decoder.at_end())
+          return count;
+
+        // Pass this record to the callback but discard its return value.
+        auto value = decoder.decode_value();
+        decoder.commit();
+        call.push_argument(count);
+        call.push_argument(::std::move(value));
+        call.invoke();
+        count ++;
+      }
+      catch(MsgPack_Partial&) {
+        // Discard bytes that have been consumed, then read more and retry.
+        decoder.rewind();
+        buf.erase(0, static_cast<size_t>(decoder.begin() - buf.data()));
+        final = !read_more(buf);
+        decoder.reload(buf.data(), buf.data() + buf.size(), final);
+      }
+  }
+
+}  // namespace
+
+V_string
+std_msgpack_encode(Value value)
+  {
+    ::rocket::tinyfmt_str fmt;
+    do_encode_nonrecursive(fmt, value);
+    return fmt.extract_string();
+  }
+
+void
+std_msgpack_encode_to_file(V_string path, Value value)
+  {
+    // Try opening the file.
+    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "wb"), ::fclose);
+    if(!fp)
+      ASTERIA_THROW("Could not open file '$2'\n"
+                    "[`fopen()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Write bytes into the file directly. They are buffered by the C library.
+    ::rocket::tinyfmt_file fmt(fp, nullptr);
+    do_encode_nonrecursive(fmt, value);
+    if(::fflush(fp) == EOF)
+      ASTERIA_THROW("Error writing file '$2'\n"
+                    "[`fflush()` failed: $1]",
+                    format_errno(errno), path);
+  }
+
+Value
+std_msgpack_decode(V_string data)
+  {
+    return do_msgpack_decode(data.data(), data.data() + data.size());
+  }
+
+Value
+std_msgpack_decode_file(V_string path)
+  {
+    // Try opening the file.
+    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "rb"), ::fclose);
+    if(!fp)
+      ASTERIA_THROW("Could not open file '$2'\n"
+                    "[`fopen()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Read the entire file, then decode it as a string.
+    cow_string data;
+    ::setbuf(fp, nullptr);
+    for(;;) {
+      size_t off = data.size();
+      data.append(0x10000, '\0');
+      size_t nread = ::fread(data.mut_data() + off, 1, 0x10000, fp);
+      data.erase(off + nread);
+      if(nread == 0) {
+        if(::ferror(fp))
+          ASTERIA_THROW("Error reading file '$2'\n"
+                        "[`fread()` failed: $1]",
+                        format_errno(errno), path);
+        break;
+      }
+    }
+    return do_msgpack_decode(data.data(), data.data() + data.size());
+  }
+
+V_integer
+std_msgpack_decode_stream(Global_Context& global, V_string data, V_function callback)
+  {
+    // The string is complete, so no more bytes will be read.
+    return do_msgpack_decode_stream(global, ::std::move(callback), data, true,
+                                    [](cow_string&) { return false;  });
+  }
+
+V_integer
+std_msgpack_decode_file_stream(Global_Context& global, V_string path, V_function callback)
+  {
+    // Open the file for reading.
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY), ::close);
+    if(!fd)
+      ASTERIA_THROW("Could not open file '$2'\n"
+                    "[`open()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Read the file in chunks. If a record is longer than a chunk, the buffer
+    // will grow exponentially.
+    V_string buf;
+    return do_msgpack_decode_stream(global, ::std::move(callback), buf, false,
+      [&](cow_string& data) {
+        size_t off = data.size();
+        size_t nbatch = ::rocket::max(off, size_t(0x100000));
+        data.append(nbatch, '/');
+
+        ::ssize_t nread = ::read(fd, data.mut_data() + off, nbatch);
+        if(nread < 0)
+          ASTERIA_THROW("Error reading file '$2'\n"
+                        "[`read()` failed: $1]",
+                        format_errno(errno), path);
+
+        data.erase(off + static_cast<size_t>(nread));
+        return nread != 0;
+      });
+  }
+
+void
+create_bindings_msgpack(V_object& result, API_Version /*version*/)
+  {
+    result.insert_or_assign(sref("encode"),
+      ASTERIA_BINDING_BEGIN("std.msgpack.encode", self, global, reader) {
+        Value value;
+
+        reader.start_overload();
+        reader.optional(value);   // [value]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_msgpack_encode, value);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("encode_to_file"),
+      ASTERIA_BINDING_BEGIN("std.msgpack.encode_to_file", self, global, reader) {
+        V_string path;
+        Value value;
+
+        reader.start_overload();
+        reader.required(path);    // path
+        reader.optional(value);   // [value]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_msgpack_encode_to_file, path, value);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("decode"),
+      ASTERIA_BINDING_BEGIN("std.msgpack.decode", self, global, reader) {
+        V_string data;
+
+        reader.start_overload();
+        reader.required(data);    // data
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_msgpack_decode, data);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("decode_file"),
+      ASTERIA_BINDING_BEGIN("std.msgpack.decode_file", self, global, reader) {
+        V_string path;
+
+        reader.start_overload();
+        reader.required(path);    // path
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_msgpack_decode_file, path);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("decode_stream"),
+      ASTERIA_BINDING_BEGIN("std.msgpack.decode_stream", self, global, reader) {
+        V_string data;
+        V_function func;
+
+        reader.start_overload();
+        reader.required(data);    // data
+        reader.required(func);    // callback
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_msgpack_decode_stream, global, data, func);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("decode_file_stream"),
+      ASTERIA_BINDING_BEGIN("std.msgpack.decode_file_stream", self, global, reader) {
+        V_string path;
+        V_function func;
+
+        reader.start_overload();
+        reader.required(path);    // path
+        reader.required(func);    // callback
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_msgpack_decode_file_stream, global, path, func);
+      }
+      ASTERIA_BINDING_END);
+  }
+
+}  // namespace asteria
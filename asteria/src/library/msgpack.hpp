@@ -0,0 +1,41 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_LIBRARY_MSGPACK_HPP_
+#define ASTERIA_LIBRARY_MSGPACK_HPP_
+
+#include "../fwd.hpp"
+
+namespace asteria {
+
+// `std.msgpack.encode`
+V_string
+std_msgpack_encode(Value value);
+
+// `std.msgpack.encode_to_file`
+void
+std_msgpack_encode_to_file(V_string path, Value value);
+
+// `std.msgpack.decode`
+Value
+std_msgpack_decode(V_string data);
+
+// `std.msgpack.decode_file`
+Value
+std_msgpack_decode_file(V_string path);
+
+// `std.msgpack.decode_stream`
+V_integer
+std_msgpack_decode_stream(Global_Context& global, V_string data, V_function callback);
+
+// `std.msgpack.decode_file_stream`
+V_integer
+std_msgpack_decode_file_stream(Global_Context& global, V_string path, V_function callback);
+
+// Create an object that is to be referenced as `std.msgpack`.
+void
+create_bindings_msgpack(V_object& result, API_Version version);
+
+}  // namespace asteria
+
+#endif
@@ -5,6 +5,7 @@
 #include "string.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../utils.hpp"
+#include "../../rocket/mutex.hpp"
 #define PCRE2_CODE_UNIT_WIDTH 8
 #include <pcre2.h>
 
@@ -534,16 +535,20 @@ operator<<(tinyfmt& fmt, const PCRE2_Error& err)
   { return fmt << err.c_str();  }
 
 class PCRE2_Matcher
+  final
+  : public Abstract_Opaque
   {
   private:
+    cow_string m_patt;
+    uint32_t m_opts;
     uptr<::pcre2_code, void (&)(::pcre2_code*)> m_code;
     uptr<::pcre2_match_data, void (&)(::pcre2_match_data*)> m_match;
 
   public:
     explicit
-    PCRE2_Matcher(const V_string& pattern, uint32_t opts = 0)
-      : m_code(::pcre2_code_free),
-        m_match(::pcre2_match_data_free)
+    PCRE2_Matcher(const V_string& pattern, uint32_t opts)
+      : m_patt(pattern), m_opts(opts),
+        m_code(::pcre2_code_free), m_match(::pcre2_match_data_free)
       {
         int err;
         size_t off;
@@ -554,31 +559,323 @@ class PCRE2_Matcher
                         "[`pcre2_compile()` failed at offset `$3`: $2]",
                         pattern, PCRE2_Error(err), off);
 
-        if(!this->m_match.reset(::pcre2_match_data_create_from_pattern(
-              this->m_code, nullptr)))
-          ASTERIA_THROW("Could not allocate `match_data` structure: $1\n"
-                        "[`pcre2_match_data_create_from_pattern()` failed]",
-                        pattern);
+        // Try compiling the pattern into machine code. If JIT is not available,
+        // the interpreter is used, so errors are ignored.
+        ::pcre2_jit_compile(this->m_code, PCRE2_JIT_COMPLETE);
       }
 
   public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+      const override
+      { return fmt << "compiled regular expression `" << this->m_patt << "`";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+      const override
+      { return callback;  }
+
+    PCRE2_Matcher*
+    clone_opt(rcptr<Abstract_Opaque>& /*output*/)
+      const override
+      { return nullptr;  }  // immutable
+
+    const cow_string&
+    pattern()
+      const noexcept
+      { return this->m_patt;  }
+
+    uint32_t
+    options()
+      const noexcept
+      { return this->m_opts;  }
+
     ::pcre2_code*
     code()
-      noexcept
+      const noexcept
       { return this->m_code;  }
 
+    // A matcher in the cache is held by only one caller at a time, so it keeps
+    // a match data block for reuse. This shall not be called on matchers that
+    // may be shared, such as those from `pcre_compile()`.
     ::pcre2_match_data*
-    match()
-      noexcept
-      { return this->m_match;  }
+    exclusive_match_data()
+      {
+        if(!this->m_match && !this->m_match.reset(
+              ::pcre2_match_data_create_from_pattern(this->m_code, nullptr)))
+          ASTERIA_THROW("Could not allocate `match_data` structure: $1\n"
+                        "[`pcre2_match_data_create_from_pattern()` failed]",
+                        this->m_patt);
+        return this->m_match;
+      }
   };
 
+// Match data blocks for shared matchers are allocated for each match, as they
+// may be used by multiple threads at the same time.
+using PCRE2_Match_Data = uptr<::pcre2_match_data, void (&)(::pcre2_match_data*)>;
+
+PCRE2_Match_Data
+do_create_match_data(const PCRE2_Matcher& pcre)
+  {
+    PCRE2_Match_Data match(::pcre2_match_data_free);
+    if(!match.reset(::pcre2_match_data_create_from_pattern(pcre.code(), nullptr)))
+      ASTERIA_THROW("Could not allocate `match_data` structure: $1\n"
+                    "[`pcre2_match_data_create_from_pattern()` failed]",
+                    pcre.pattern());
+    return match;
+  }
+
+// Matchers that are created from pattern strings are cached, as compilation is
+// expensive. A matcher is removed from the cache while it is in use, and is put
+// back afterwards, so its match data block can be reused without locking.
+struct PCRE2_Cache
+  {
+    ::rocket::mutex mutex;
+    cow_vector<rcptr<PCRE2_Matcher>> entries;  // least recently used first
+  };
+
+constexpr size_t s_pcre2_cache_capacity = 64;
+PCRE2_Cache s_pcre2_cache;
+
+rcptr<PCRE2_Matcher>
+do_acquire_pcre2(const V_string& pattern, uint32_t opts)
+  {
+    ::rocket::mutex::unique_lock lock(s_pcre2_cache.mutex);
+    auto& entries = s_pcre2_cache.entries;
+
+    // Search for a matcher, starting from the most recently used one.
+    for(size_t k = entries.size();  k-- != 0;  ) {
+      const auto& pcre = entries[k];
+      if((pcre->options() != opts) || (pcre->pattern() != pattern))
+        continue;
+
+      auto res = ::std::move(entries.mut(k));
+      entries.erase(k, 1);
+      return res;
+    }
+    lock.unlock();
+
+    // Compile a new one.
+    return ::rocket::make_refcnt<PCRE2_Matcher>(pattern, opts);
+  }
+
+void
+do_release_pcre2(rcptr<PCRE2_Matcher>&& pcre)
+  {
+    ::rocket::mutex::unique_lock lock(s_pcre2_cache.mutex);
+    auto& entries = s_pcre2_cache.entries;
+
+    // If another caller has put back a matcher for the same pattern while this
+    // one was in use, keep that one and discard this one.
+    for(size_t k = entries.size();  k-- != 0;  )
+      if((entries[k]->options() == pcre->options()) && (entries[k]->pattern() == pcre->pattern()))
+        return;
+
+    // Evict the least recently used matcher if the cache is full.
+    if(entries.size() >= s_pcre2_cache_capacity)
+      entries.erase(0, 1);
+    entries.emplace_back(::std::move(pcre));
+  }
+
+template<typename FuncT>
+decltype(auto)
+do_with_pcre2(const V_string& pattern, FuncT&& func)
+  {
+    // If an exception is thrown, the matcher is discarded.
+    auto pcre = do_acquire_pcre2(pattern, 0);
+    auto res = ::std::forward<FuncT>(func)(*pcre, pcre->exclusive_match_data());
+    do_release_pcre2(::std::move(pcre));
+    return res;
+  }
+
+rcptr<const PCRE2_Matcher>
+do_cast_pcre2(const V_opaque& pattern)
+  {
+    auto pcre = pattern.get_opt<PCRE2_Matcher>();
+    if(!pcre)
+      ASTERIA_THROW("Invalid compiled regular expression (invalid dynamic_cast to `$1` from `$2`)",
+                    typeid(PCRE2_Matcher).name(), pattern.type().name());
+    return pcre;
+  }
+
 struct PCRE2_Name
   {
     uint16_t index_be;
     char name[];
   };
 
+opt<pair<V_integer, V_integer>>
+do_pcre_find(const PCRE2_Matcher& pcre, ::pcre2_match_data* match,
+             const V_string& text, const V_integer& from, const Opt_integer& length)
+  {
+    auto range = do_slice(text, from, length);
+
+    // Get the real start and length.
+    auto sub_off = static_cast<size_t>(range.first - text.begin());
+    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
+    auto sub_len = static_cast<size_t>(range.second - range.first);
+
+    int err = ::pcre2_match(pcre.code(), sub_ptr, sub_len, 0, 0, match, nullptr);
+    if(err < 0) {
+      if(err == PCRE2_ERROR_NOMATCH)
+        return nullopt;
+
+      ASTERIA_THROW("Regular expression match failure: $1\n"
+                    "[`pcre2_match()` failed: $2]",
+                    pcre.pattern(), PCRE2_Error(err));
+    }
+    auto ovec = ::pcre2_get_ovector_pointer(match);
+
+    // This is copied from PCRE2 manual:
+    //   If a pattern uses the \K escape sequence within a positive assertion, the reported
+    //   start of a successful match can be greater than the end of the match. For example,
+    //   if the pattern (?=ab\K) is matched against "ab", the start and end offset values
+    //   for the match are 2 and 0.
+    return ::std::make_pair(static_cast<int64_t>(sub_off + ovec[0]),
+                            static_cast<int64_t>(::std::max(ovec[0], ovec[1]) - ovec[0]));
+  }
+
+Opt_array
+do_pcre_match(const PCRE2_Matcher& pcre, ::pcre2_match_data* match,
+              const V_string& text, const V_integer& from, const Opt_integer& length)
+  {
+    auto range = do_slice(text, from, length);
+
+    // Get the real start and length.
+    auto sub_off = static_cast<size_t>(range.first - text.begin());
+    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
+    auto sub_len = static_cast<size_t>(range.second - range.first);
+
+    int err = ::pcre2_match(pcre.code(), sub_ptr, sub_len, 0, 0, match, nullptr);
+    if(err < 0) {
+      if(err == PCRE2_ERROR_NOMATCH)
+        return nullopt;
+
+      ASTERIA_THROW("Regular expression match failure: $1\n"
+                    "[`pcre2_match()` failed: $2]",
+                    pcre.pattern(), PCRE2_Error(err));
+    }
+    auto ovec = ::pcre2_get_ovector_pointer(match);
+    size_t npairs = ::pcre2_get_ovector_count(match);
+
+    // Compose the match result array.
+    // The first element should be the matched substring. All remaining elements are
+    // positional capturing groups. If a group matched nothing, its corresponding element
+    // is `null`.
+    V_array matches(npairs);
+    for(size_t k = 0;  k != npairs;  ++k) {
+      // This is copied from PCRE2 manual:
+      //   If a pattern uses the \K escape sequence within a positive assertion, the reported
+      //   start of a successful match can be greater than the end of the match. For example,
+      //   if the pattern (?=ab\K) is matched against "ab", the start and end offset values
+      //   for the match are 2 and 0.
+      auto opair = ovec + k * 2;
+      if(opair[0] != PCRE2_UNSET)
+        matches.mut(k) = cow_string(reinterpret_cast<const char*>(sub_ptr + opair[0]),
+                                    ::std::max(opair[0], opair[1]) - opair[0]);
+    }
+    return ::std::move(matches);
+  }
+
+Opt_object
+do_pcre_named_match(const PCRE2_Matcher& pcre, ::pcre2_match_data* match,
+                    const V_string& text, const V_integer& from, const Opt_integer& length)
+  {
+    auto range = do_slice(text, from, length);
+
+    // Get the real start and length.
+    auto sub_off = static_cast<size_t>(range.first - text.begin());
+    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
+    auto sub_len = static_cast<size_t>(range.second - range.first);
+
+    int err = ::pcre2_match(pcre.code(), sub_ptr, sub_len, 0, 0, match, nullptr);
+    if(err < 0) {
+      if(err == PCRE2_ERROR_NOMATCH)
+        return nullopt;
+
+      ASTERIA_THROW("Regular expression match failure: $1\n"
+                    "[`pcre2_match()` failed: $2]",
+                    pcre.pattern(), PCRE2_Error(err));
+    }
+    auto ovec = ::pcre2_get_ovector_pointer(match);
+
+    // Get named group information.
+    const uint8_t* gptr;
+    ::pcre2_pattern_info(pcre.code(), PCRE2_INFO_NAMETABLE, &gptr);
+    uint32_t ngroups;
+    ::pcre2_pattern_info(pcre.code(), PCRE2_INFO_NAMECOUNT, &ngroups);
+    uint32_t gsize;
+    ::pcre2_pattern_info(pcre.code(), PCRE2_INFO_NAMEENTRYSIZE, &gsize);
+
+    // Compose the match result object.
+    V_object matches;
+    for(size_t k = 0;  k != ngroups;  ++k) {
+      // Get the index and name of this group.
+      auto gcur = reinterpret_cast<const PCRE2_Name*>(gptr + k * gsize);
+      size_t gindex = be16toh(gcur->index_be);
+      auto gmatch = matches.try_emplace(cow_string(gcur->name)).first;
+
+      // This is copied from PCRE2 manual:
+      //   If a pattern uses the \K escape sequence within a positive assertion, the reported
+      //   start of a successful match can be greater than the end of the match. For example,
+      //   if the pattern (?=ab\K) is matched against "ab", the start and end offset values
+      //   for the match are 2 and 0.
+      auto opair = ovec + gindex * 2;
+      if(opair[0] != PCRE2_UNSET)
+        gmatch->second = cow_string(reinterpret_cast<const char*>(sub_ptr + opair[0]),
+                                    ::std::max(opair[0], opair[1]) - opair[0]);
+    }
+    return ::std::move(matches);
+  }
+
+V_string
+do_pcre_replace(const PCRE2_Matcher& pcre, ::pcre2_match_data* match,
+                const V_string& text, const V_integer& from, const Opt_integer& length,
+                const V_string& replacement)
+  {
+    auto range = do_slice(text, from, length);
+
+    // Get the real start and length.
+    auto sub_off = static_cast<size_t>(range.first - text.begin());
+    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
+    auto sub_len = static_cast<size_t>(range.second - range.first);
+
+    // Reserve resonable storage for the replaced string.
+    size_t output_len = 1;
+#ifndef ROCKET_DEBUG
+    output_len += replacement.size() + text.size();
+#endif
+    V_string output_str;
+
+  r:
+    output_str.assign(output_len, '*');
+    int err = ::pcre2_substitute(pcre.code(), sub_ptr, sub_len, 0,
+                  PCRE2_SUBSTITUTE_EXTENDED | PCRE2_SUBSTITUTE_GLOBAL
+                    | PCRE2_SUBSTITUTE_OVERFLOW_LENGTH, match, nullptr,
+                  reinterpret_cast<const uint8_t*>(replacement.data()), replacement.size(),
+                  reinterpret_cast<uint8_t*>(output_str.mut_data()), &output_len);
+    if(err < 0) {
+      if(err == PCRE2_ERROR_NOMATCH)
+        return text;
+
+      if(err == PCRE2_ERROR_NOMEMORY)
+        goto r;
+
+      ASTERIA_THROW("Regular expression substitution failure: $1\n"
+                    "[`pcre2_substitute()` failed: $2]",
+                    pcre.pattern(), PCRE2_Error(err));
+    }
+
+    // Discard excess characters.
+    ROCKET_ASSERT(output_len <= output_str.size());
+    output_str.erase(output_len);
+
+    // Concatenate it with unreplaced parts.
+    output_str.insert(output_str.begin(), text.begin(), range.first);
+    output_str.append(range.second, text.end());
+    return output_str;
+  }
+
 }  // namespace
 
 V_string
@@ -1507,177 +1804,100 @@ std_string_format(V_string templ, cow_vector<Value> values)
 opt<pair<V_integer, V_integer>>
 std_string_pcre_find(V_string text, V_integer from, Opt_integer length, V_string pattern)
   {
-    auto range = do_slice(text, from, length);
-
-    // Get the real start and length.
-    auto sub_off = static_cast<size_t>(range.first - text.begin());
-    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
-    auto sub_len = static_cast<size_t>(range.second - range.first);
-
-    // Try matching using default options.
-    PCRE2_Matcher pcre(pattern);
-    int err = ::pcre2_match(pcre.code(), sub_ptr, sub_len, 0, 0, pcre.match(), nullptr);
-    if(err < 0) {
-      if(err == PCRE2_ERROR_NOMATCH)
-        return nullopt;
-
-      ASTERIA_THROW("Regular expression match failure: $1\n"
-                    "[`pcre2_match()` failed: $2]",
-                    pattern, PCRE2_Error(err));
-    }
-    auto ovec = ::pcre2_get_ovector_pointer(pcre.match());
+    return do_with_pcre2(pattern,
+        [&](const PCRE2_Matcher& pcre, ::pcre2_match_data* match) {
+          return do_pcre_find(pcre, match, text, from, length);  });
+  }
 
-    // This is copied from PCRE2 manual:
-    //   If a pattern uses the \K escape sequence within a positive assertion, the reported
-    //   start of a successful match can be greater than the end of the match. For example,
-    //   if the pattern (?=ab\K) is matched against "ab", the start and end offset values
-    //   for the match are 2 and 0.
-    return ::std::make_pair(static_cast<int64_t>(sub_off + ovec[0]),
-                            static_cast<int64_t>(::std::max(ovec[0], ovec[1]) - ovec[0]));
+opt<pair<V_integer, V_integer>>
+std_string_pcre_find(V_string text, V_integer from, Opt_integer length, V_opaque pattern)
+  {
+    auto pcre = do_cast_pcre2(pattern);
+    auto match = do_create_match_data(*pcre);
+    return do_pcre_find(*pcre, match, text, from, length);
   }
 
 Opt_array
 std_string_pcre_match(V_string text, V_integer from, Opt_integer length, V_string pattern)
   {
-    auto range = do_slice(text, from, length);
-
-    // Get the real start and length.
-    auto sub_off = static_cast<size_t>(range.first - text.begin());
-    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
-    auto sub_len = static_cast<size_t>(range.second - range.first);
-
-    // Try matching using default options.
-    PCRE2_Matcher pcre(pattern);
-    int err = ::pcre2_match(pcre.code(), sub_ptr, sub_len, 0, 0, pcre.match(), nullptr);
-    if(err < 0) {
-      if(err == PCRE2_ERROR_NOMATCH)
-        return nullopt;
-
-      ASTERIA_THROW("Regular expression match failure: $1\n"
-                    "[`pcre2_match()` failed: $2]",
-                    pattern, PCRE2_Error(err));
-    }
-    auto ovec = ::pcre2_get_ovector_pointer(pcre.match());
-    size_t npairs = ::pcre2_get_ovector_count(pcre.match());
+    return do_with_pcre2(pattern,
+        [&](const PCRE2_Matcher& pcre, ::pcre2_match_data* match) {
+          return do_pcre_match(pcre, match, text, from, length);  });
+  }
 
-    // Compose the match result array.
-    // The first element should be the matched substring. All remaining elements are
-    // positional capturing groups. If a group matched nothing, its corresponding element
-    // is `null`.
-    V_array matches(npairs);
-    for(size_t k = 0;  k != npairs;  ++k) {
-      // This is copied from PCRE2 manual:
-      //   If a pattern uses the \K escape sequence within a positive assertion, the reported
-      //   start of a successful match can be greater than the end of the match. For example,
-      //   if the pattern (?=ab\K) is matched against "ab", the start and end offset values
-      //   for the match are 2 and 0.
-      auto opair = ovec + k * 2;
-      if(opair[0] != PCRE2_UNSET)
-        matches.mut(k) = cow_string(reinterpret_cast<const char*>(sub_ptr + opair[0]),
-                                    ::std::max(opair[0], opair[1]) - opair[0]);
-    }
-    return ::std::move(matches);
+Opt_array
+std_string_pcre_match(V_string text, V_integer from, Opt_integer length, V_opaque pattern)
+  {
+    auto pcre = do_cast_pcre2(pattern);
+    auto match = do_create_match_data(*pcre);
+    return do_pcre_match(*pcre, match, text, from, length);
   }
 
 Opt_object
 std_string_pcre_named_match(V_string text, V_integer from, Opt_integer length, V_string pattern)
   {
-    auto range = do_slice(text, from, length);
-
-    // Get the real start and length.
-    auto sub_off = static_cast<size_t>(range.first - text.begin());
-    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
-    auto sub_len = static_cast<size_t>(range.second - range.first);
-
-    // Try matching using default options.
-    PCRE2_Matcher pcre(pattern);
-    int err = ::pcre2_match(pcre.code(), sub_ptr, sub_len, 0, 0, pcre.match(), nullptr);
-    if(err < 0) {
-      if(err == PCRE2_ERROR_NOMATCH)
-        return nullopt;
-
-      ASTERIA_THROW("Regular expression match failure: $1\n"
-                    "[`pcre2_match()` failed: $2]",
-                    pattern, PCRE2_Error(err));
-    }
-    auto ovec = ::pcre2_get_ovector_pointer(pcre.match());
-
-    // Get named group information.
-    const uint8_t* gptr;
-    ::pcre2_pattern_info(pcre.code(), PCRE2_INFO_NAMETABLE, &gptr);
-    uint32_t ngroups;
-    ::pcre2_pattern_info(pcre.code(), PCRE2_INFO_NAMECOUNT, &ngroups);
-    uint32_t gsize;
-    ::pcre2_pattern_info(pcre.code(), PCRE2_INFO_NAMEENTRYSIZE, &gsize);
-
-    // Compose the match result object.
-    V_object matches;
-    for(size_t k = 0;  k != ngroups;  ++k) {
-      // Get the index and name of this group.
-      auto gcur = reinterpret_cast<const PCRE2_Name*>(gptr + k * gsize);
-      size_t gindex = be16toh(gcur->index_be);
-      auto gmatch = matches.try_emplace(cow_string(gcur->name)).first;
+    return do_with_pcre2(pattern,
+        [&](const PCRE2_Matcher& pcre, ::pcre2_match_data* match) {
+          return do_pcre_named_match(pcre, match, text, from, length);  });
+  }
 
-      // This is copied from PCRE2 manual:
-      //   If a pattern uses the \K escape sequence within a positive assertion, the reported
-      //   start of a successful match can be greater than the end of the match. For example,
-      //   if the pattern (?=ab\K) is matched against "ab", the start and end offset values
-      //   for the match are 2 and 0.
-      auto opair = ovec + gindex * 2;
-      if(opair[0] != PCRE2_UNSET)
-        gmatch->second = cow_string(reinterpret_cast<const char*>(sub_ptr + opair[0]),
-                                    ::std::max(opair[0], opair[1]) - opair[0]);
-    }
-    return ::std::move(matches);
+Opt_object
+std_string_pcre_named_match(V_string text, V_integer from, Opt_integer length, V_opaque pattern)
+  {
+    auto pcre = do_cast_pcre2(pattern);
+    auto match = do_create_match_data(*pcre);
+    return do_pcre_named_match(*pcre, match, text, from, length);
   }
 
 V_string
 std_string_pcre_replace(V_string text, V_integer from, Opt_integer length, V_string pattern,
                         V_string replacement)
   {
-    auto range = do_slice(text, from, length);
-
-    // Get the real start and length.
-    auto sub_off = static_cast<size_t>(range.first - text.begin());
-    auto sub_ptr = reinterpret_cast<const uint8_t*>(text.data()) + sub_off;
-    auto sub_len = static_cast<size_t>(range.second - range.first);
-
-    // Reserve resonable storage for the replaced string.
-    size_t output_len = 1;
-#ifndef ROCKET_DEBUG
-    output_len += replacement.size() + text.size();
-#endif
-    V_string output_str;
-
-    // Try matching using default options.
-    PCRE2_Matcher pcre(pattern);
-  r:
-    output_str.assign(output_len, '*');
-    int err = ::pcre2_substitute(pcre.code(), sub_ptr, sub_len, 0,
-                  PCRE2_SUBSTITUTE_EXTENDED | PCRE2_SUBSTITUTE_GLOBAL
-                    | PCRE2_SUBSTITUTE_OVERFLOW_LENGTH, pcre.match(), nullptr,
-                  reinterpret_cast<const uint8_t*>(replacement.data()), replacement.size(),
-                  reinterpret_cast<uint8_t*>(output_str.mut_data()), &output_len);
-    if(err < 0) {
-      if(err == PCRE2_ERROR_NOMATCH)
-        return ::std::move(text);
+    return do_with_pcre2(pattern,
+        [&](const PCRE2_Matcher& pcre, ::pcre2_match_data* match) {
+          return do_pcre_replace(pcre, match, text, from, length, replacement);  });
+  }
 
-      if(err == PCRE2_ERROR_NOMEMORY)
-        goto r;
+V_string
+std_string_pcre_replace(V_string text, V_integer from, Opt_integer length, V_opaque pattern,
+                        V_string replacement)
+  {
+    auto pcre = do_cast_pcre2(pattern);
+    auto match = do_create_match_data(*pcre);
+    return do_pcre_replace(*pcre, match, text, from, length, replacement);
+  }
 
-      ASTERIA_THROW("Regular expression substitution failure: $1\n"
-                    "[`pcre2_substitute()` failed: $2]",
-                    pattern, PCRE2_Error(err));
-    }
+V_opaque
+std_string_pcre_compile(V_string pattern, Opt_array options)
+  {
+    // Translate options.
+    uint32_t opts = 0;
+    if(options)
+      for(const auto& opt : *options) {
+        if(!opt.is_string())
+          ASTERIA_THROW("Invalid regular expression option (value `$1`)", opt);
 
-    // Discard excess characters.
-    ROCKET_ASSERT(output_len <= output_str.size());
-    output_str.erase(output_len);
+        const auto& name = opt.as_string();
+        if(name == "caseless")
+          opts |= PCRE2_CASELESS;
+        else if(name == "dotall")
+          opts |= PCRE2_DOTALL;
+        else if(name == "extended")
+          opts |= PCRE2_EXTENDED;
+        else if(name == "multiline")
+          opts |= PCRE2_MULTILINE;
+        else if(name == "anchored")
+          opts |= PCRE2_ANCHORED;
+        else if(name == "dollar_endonly")
+          opts |= PCRE2_DOLLAR_ENDONLY;
+        else if(name == "ungreedy")
+          opts |= PCRE2_UNGREEDY;
+        else
+          ASTERIA_THROW("Invalid regular expression option `$1`", name);
+      }
 
-    // Concatenate it with unreplaced parts.
-    output_str.insert(output_str.begin(), text.begin(), range.first);
-    output_str.append(range.second, text.end());
-    return output_str;
+    // Compile the pattern. The result is not cached.
+    return ::rocket::make_refcnt<PCRE2_Matcher>(pattern, opts);
   }
 
 void
@@ -2572,6 +2792,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         V_integer from;
         Opt_integer len;
         V_string patt;
+        V_opaque cpatt;
 
         reader.start_overload();
         reader.required(text);     // text
@@ -2581,6 +2802,12 @@ create_bindings_string(V_object& result, API_Version /*version*/)
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_find, text, 0, nullopt, patt);
 
+        reader.load_state(0);      // text
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_find, text, 0, nullopt, cpatt);
+
         reader.load_state(0);      // text
         reader.required(from);     // from
         reader.save_state(0);
@@ -2589,12 +2816,25 @@ create_bindings_string(V_object& result, API_Version /*version*/)
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_find, text, from, nullopt, patt);
 
+        reader.load_state(0);      // text, from
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_find, text, from, nullopt, cpatt);
+
         reader.load_state(0);      // text, from
         reader.optional(len);      // [length]
+        reader.save_state(0);
         reader.required(patt);     // pattern
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_find, text, from, len, patt);
+
+        reader.load_state(0);      // text, from, [length]
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_find, text, from, len, cpatt);
       }
       ASTERIA_BINDING_END);
 
@@ -2604,6 +2844,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         V_integer from;
         Opt_integer len;
         V_string patt;
+        V_opaque cpatt;
 
         reader.start_overload();
         reader.required(text);     // text
@@ -2613,6 +2854,12 @@ create_bindings_string(V_object& result, API_Version /*version*/)
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_match, text, 0, nullopt, patt);
 
+        reader.load_state(0);      // text
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_match, text, 0, nullopt, cpatt);
+
         reader.load_state(0);      // text
         reader.required(from);     // from
         reader.save_state(0);
@@ -2621,12 +2868,25 @@ create_bindings_string(V_object& result, API_Version /*version*/)
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_match, text, from, nullopt, patt);
 
+        reader.load_state(0);      // text, from
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_match, text, from, nullopt, cpatt);
+
         reader.load_state(0);      // text, from
         reader.optional(len);      // [length]
+        reader.save_state(0);
         reader.required(patt);     // pattern
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_match, text, from, len, patt);
+
+        reader.load_state(0);      // text, from, [length]
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_match, text, from, len, cpatt);
       }
       ASTERIA_BINDING_END);
 
@@ -2636,6 +2896,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         V_integer from;
         Opt_integer len;
         V_string patt;
+        V_opaque cpatt;
 
         reader.start_overload();
         reader.required(text);     // text
@@ -2645,6 +2906,12 @@ create_bindings_string(V_object& result, API_Version /*version*/)
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_named_match, text, 0, nullopt, patt);
 
+        reader.load_state(0);      // text
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_named_match, text, 0, nullopt, cpatt);
+
         reader.load_state(0);      // text
         reader.required(from);     // from
         reader.save_state(0);
@@ -2653,12 +2920,25 @@ create_bindings_string(V_object& result, API_Version /*version*/)
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_named_match, text, from, nullopt, patt);
 
+        reader.load_state(0);      // text, from
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_named_match, text, from, nullopt, cpatt);
+
         reader.load_state(0);      // text, from
         reader.optional(len);      // [length]
+        reader.save_state(0);
         reader.required(patt);     // pattern
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_named_match, text, from, len, patt);
+
+        reader.load_state(0);      // text, from, [length]
+        reader.required(cpatt);    // pattern
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_named_match, text, from, len, cpatt);
       }
       ASTERIA_BINDING_END);
 
@@ -2668,33 +2948,70 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         V_integer from;
         Opt_integer len;
         V_string patt;
+        V_opaque cpatt;
         V_string rep;
 
         reader.start_overload();
         reader.required(text);     // text
         reader.save_state(0);
         reader.required(patt);     // pattern
-        reader.required(rep);     // replacement
+        reader.required(rep);      // replacement
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_replace, text, 0, nullopt, patt, rep);
 
+        reader.load_state(0);      // text
+        reader.required(cpatt);    // pattern
+        reader.required(rep);      // replacement
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_replace, text, 0, nullopt, cpatt, rep);
+
         reader.load_state(0);      // text
         reader.required(from);     // from
         reader.save_state(0);
         reader.required(patt);     // pattern
-        reader.required(rep);     // replacement
+        reader.required(rep);      // replacement
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_replace, text, from, nullopt, patt, rep);
 
+        reader.load_state(0);      // text, from
+        reader.required(cpatt);    // pattern
+        reader.required(rep);      // replacement
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_replace, text, from, nullopt, cpatt, rep);
+
         reader.load_state(0);      // text, from
         reader.optional(len);      // [length]
+        reader.save_state(0);
         reader.required(patt);     // pattern
-        reader.required(rep);     // replacement
+        reader.required(rep);      // replacement
         if(reader.end_overload())
           ASTERIA_BINDING_RETURN_MOVE(self,
                     std_string_pcre_replace, text, from, len, patt, rep);
+
+        reader.load_state(0);      // text, from, [length]
+        reader.required(cpatt);    // pattern
+        reader.required(rep);      // replacement
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_replace, text, from, len, cpatt, rep);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("pcre_compile"),
+      ASTERIA_BINDING_BEGIN("std.string.pcre_compile", self, global, reader) {
+        V_string patt;
+        Opt_array opts;
+
+        reader.start_overload();
+        reader.required(patt);     // pattern
+        reader.optional(opts);     // [options]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_string_pcre_compile, patt, opts);
       }
       ASTERIA_BINDING_END);
   }
@@ -246,23 +246,40 @@ std_string_unpack_64le(V_string text);
 V_string
 std_string_format(V_string templ, cow_vector<Value> values);
 
-// `std.string.pcre_find`.
+// `std.string.pcre_find`
 opt<pair<V_integer, V_integer>>
 std_string_pcre_find(V_string text, V_integer from, Opt_integer length, V_string pattern);
 
+opt<pair<V_integer, V_integer>>
+std_string_pcre_find(V_string text, V_integer from, Opt_integer length, V_opaque pattern);
+
 // `std.string.pcre_match`
 Opt_array
 std_string_pcre_match(V_string text, V_integer from, Opt_integer length, V_string pattern);
 
+Opt_array
+std_string_pcre_match(V_string text, V_integer from, Opt_integer length, V_opaque pattern);
+
 // `std.string.pcre_named_match`
 Opt_object
 std_string_pcre_named_match(V_string text, V_integer from, Opt_integer length, V_string pattern);
 
+Opt_object
+std_string_pcre_named_match(V_string text, V_integer from, Opt_integer length, V_opaque pattern);
+
 // `std.string.pcre_replace`
 V_string
 std_string_pcre_replace(V_string text, V_integer from, Opt_integer length, V_string pattern,
                         V_string replacement);
 
+V_string
+std_string_pcre_replace(V_string text, V_integer from, Opt_integer length, V_opaque pattern,
+                        V_string replacement);
+
+// `std.string.pcre_compile`
+V_opaque
+std_string_pcre_compile(V_string pattern, Opt_array options);
+
 // Create an object that is to be referenced as `std.string`.
 void
 create_bindings_string(V_object& result, API_Version version);
@@ -7,6 +7,8 @@
 #include "../runtime/global_context.hpp"
 #include "../runtime/genius_collector.hpp"
 #include "../runtime/random_engine.hpp"
+#include "../runtime/module_cache.hpp"
+#include "../runtime/thread_pool.hpp"
 #include "../compiler/token_stream.hpp"
 #include "../compiler/parser_error.hpp"
 #include "../compiler/enums.hpp"
@@ -36,6 +38,14 @@ do_clamp_gc_gen(V_integer param)
                weaken_enum(gc_generation_newest), weaken_enum(gc_generation_oldest)));
   }
 
+double
+do_get_monotonic_msecs()
+  {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) * 1000 + static_cast<double>(ts.tv_nsec) / 1000'000.0;
+  }
+
 inline
 bool
 do_check_punctuator(const Token* qtok, initializer_list<Punctuator> accept)
@@ -330,6 +340,33 @@ std_system_gc_set_threshold(Global_Context& global, V_integer generation, V_inte
     return static_cast<int64_t>(thres_old);
   }
 
+Opt_boolean
+std_system_gc_get_adaptive(Global_Context& global, V_integer generation)
+  {
+    auto gc_gen = do_clamp_gc_gen(generation);
+    if(gc_gen != generation)
+      return nullopt;
+
+    // Get the current policy.
+    auto gcoll = global.genius_collector();
+    bool adaptive = gcoll->get_collector(gc_gen).is_adaptive();
+    return adaptive;
+  }
+
+Opt_boolean
+std_system_gc_set_adaptive(Global_Context& global, V_integer generation, V_boolean adaptive)
+  {
+    auto gc_gen = do_clamp_gc_gen(generation);
+    if(gc_gen != generation)
+      return nullopt;
+
+    // Set the policy and return its old value.
+    auto gcoll = global.genius_collector();
+    bool adaptive_old = gcoll->get_collector(gc_gen).is_adaptive();
+    gcoll->open_collector(gc_gen).set_adaptive(adaptive);
+    return adaptive_old;
+  }
+
 V_integer
 std_system_gc_collect(Global_Context& global, Opt_integer generation_limit)
   {
@@ -343,6 +380,147 @@ std_system_gc_collect(Global_Context& global, Opt_integer generation_limit)
     return static_cast<int64_t>(nvars);
   }
 
+Opt_integer
+std_system_gc_get_slice_budget(Global_Context& global, V_integer generation)
+  {
+    auto gc_gen = do_clamp_gc_gen(generation);
+    if(gc_gen != generation)
+      return nullopt;
+
+    // Get the current budget.
+    auto gcoll = global.genius_collector();
+    uint32_t budget = gcoll->get_collector(gc_gen).get_slice_budget();
+    return static_cast<int64_t>(budget);
+  }
+
+Opt_integer
+std_system_gc_set_slice_budget(Global_Context& global, V_integer generation, V_integer budget)
+  {
+    auto gc_gen = do_clamp_gc_gen(generation);
+    if(gc_gen != generation)
+      return nullopt;
+
+    // Set the budget and return its old value.
+    auto gcoll = global.genius_collector();
+    uint32_t budget_new = static_cast<uint32_t>(::rocket::clamp(budget, 0, INT32_MAX));
+    uint32_t budget_old = gcoll->get_collector(gc_gen).get_slice_budget();
+    gcoll->open_collector(gc_gen).set_slice_budget(budget_new);
+    return static_cast<int64_t>(budget_old);
+  }
+
+Opt_integer
+std_system_gc_collect_slice(Global_Context& global, V_integer generation, V_integer budget)
+  {
+    auto gc_gen = do_clamp_gc_gen(generation);
+    if(gc_gen != generation)
+      return nullopt;
+
+    // Perform a slice of incremental garbage collection.
+    auto gcoll = global.genius_collector();
+    size_t nvars = gcoll->collect_variables_slice(gc_gen,
+                              static_cast<size_t>(::rocket::clamp(budget, 1, INT32_MAX)));
+    return static_cast<int64_t>(nvars);
+  }
+
+V_integer
+std_system_gc_collect_timed(Global_Context& global, V_integer duration,
+                            Opt_integer generation_limit)
+  {
+    auto gc_limit = gc_generation_oldest;
+    if(generation_limit)
+      gc_limit = do_clamp_gc_gen(*generation_limit);
+
+    // Perform slices of incremental garbage collection on each generation, until
+    // its cycle completes or time runs out. At least one slice is performed.
+    auto gcoll = global.genius_collector();
+    double deadline = do_get_monotonic_msecs() + static_cast<double>(duration);
+    size_t nvars = 0;
+
+    for(auto gc_gen = gc_generation_newest;  gc_gen <= gc_limit;
+          gc_gen = static_cast<GC_Generation>(gc_gen + 1)) {
+      // Use the budget of the collector, or a reasonable default.
+      const auto& coll = gcoll->get_collector(gc_gen);
+      size_t budget = coll.get_slice_budget();
+      if(budget == 0)
+        budget = 1000;
+
+      do
+        nvars += gcoll->collect_variables_slice(gc_gen, budget);
+      while(coll.count_pending_variables() && (do_get_monotonic_msecs() < deadline));
+
+      if(do_get_monotonic_msecs() >= deadline)
+        break;
+    }
+    return static_cast<int64_t>(nvars);
+  }
+
+V_array
+std_system_gc_stats(Global_Context& global)
+  {
+    auto gcoll = global.genius_collector();
+    V_array result;
+
+    for(auto gc_gen = gc_generation_newest;  gc_gen <= gc_generation_oldest;
+          gc_gen = static_cast<GC_Generation>(gc_gen + 1)) {
+      const auto& stats = gcoll->get_collector(gc_gen).get_statistics();
+      V_object obj;
+
+      obj.insert_or_assign(sref("collections"), static_cast<int64_t>(stats.collections));
+      obj.insert_or_assign(sref("traversed"), static_cast<int64_t>(stats.traversed));
+      obj.insert_or_assign(sref("freed"), static_cast<int64_t>(stats.freed));
+      obj.insert_or_assign(sref("promoted"), static_cast<int64_t>(stats.promoted));
+      obj.insert_or_assign(sref("reused"), static_cast<int64_t>(stats.reused));
+
+      // Pause durations are converted to milliseconds.
+      obj.insert_or_assign(sref("pause_total"), static_cast<double>(stats.pause_total) / 1000'000.0);
+      obj.insert_or_assign(sref("pause_max"), static_cast<double>(stats.pause_max) / 1000'000.0);
+
+      V_array hist;
+      for(uint64_t count : stats.pause_histogram)
+        hist.emplace_back(static_cast<int64_t>(count));
+      obj.insert_or_assign(sref("pause_histogram"), ::std::move(hist));
+
+      result.emplace_back(::std::move(obj));
+    }
+    return result;
+  }
+
+V_integer
+std_system_parallel_get_threads(Global_Context& global)
+  {
+    auto tpool = global.thread_pool();
+    return static_cast<int64_t>(tpool->get_thread_count());
+  }
+
+V_integer
+std_system_parallel_set_threads(Global_Context& global, V_integer threads)
+  {
+    // Set the number of workers and return its old value.
+    auto tpool = global.thread_pool();
+    uint32_t nthrs_new = static_cast<uint32_t>(::rocket::clamp(threads, 0, 256));
+    uint32_t nthrs_old = tpool->get_thread_count();
+    tpool->set_thread_count(nthrs_new);
+    return static_cast<int64_t>(nthrs_old);
+  }
+
+V_integer
+std_system_parallel_get_cutoff(Global_Context& global)
+  {
+    auto tpool = global.thread_pool();
+    return static_cast<int64_t>(tpool->get_cutoff());
+  }
+
+V_integer
+std_system_parallel_set_cutoff(Global_Context& global, V_integer cutoff)
+  {
+    // Set the cutoff and return its old value.
+    auto tpool = global.thread_pool();
+    uint32_t cutoff_new = static_cast<uint32_t>(::rocket::clamp(cutoff, 1, INT32_MAX));
+    uint32_t cutoff_old = tpool->get_cutoff();
+    tpool->set_cutoff(cutoff_new);
+    return static_cast<int64_t>(cutoff_old);
+  }
+
 Opt_string
 std_system_env_get_variable(V_string name)
   {
@@ -522,6 +700,23 @@ std_system_conf_load_file(V_string path)
     return root;
   }
 
+V_integer
+std_system_import_invalidate_cache(Global_Context& global, Opt_string path)
+  {
+    auto mcache = global.module_cache();
+    if(!path)
+      return static_cast<int64_t>(mcache->clear());
+
+    // Resolve the path in the same way as `import`. If the file no longer exists,
+    // the path is used verbatim.
+    auto abspath = ::rocket::make_unique_handle(
+                         ::realpath(path->safe_c_str(), nullptr), ::free);
+    if(abspath)
+      path->assign(abspath);
+
+    return static_cast<int64_t>(mcache->invalidate(*path));
+  }
+
 void
 create_bindings_system(V_object& result, API_Version /*version*/)
   {
@@ -563,6 +758,32 @@ create_bindings_system(V_object& result, API_Version /*version*/)
       }
       ASTERIA_BINDING_END);
 
+    result.insert_or_assign(sref("gc_get_adaptive"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_get_adaptive", self, global, reader) {
+        V_integer gen;
+
+        reader.start_overload();
+        reader.required(gen);      // generation
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_get_adaptive, global, gen);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("gc_set_adaptive"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_set_adaptive", self, global, reader) {
+        V_integer gen;
+        V_boolean adapt;
+
+        reader.start_overload();
+        reader.required(gen);      // generation
+        reader.required(adapt);    // adaptive
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_set_adaptive, global, gen, adapt);
+      }
+      ASTERIA_BINDING_END);
+
     result.insert_or_assign(sref("gc_collect"),
       ASTERIA_BINDING_BEGIN("std.system.collect", self, global, reader) {
         Opt_integer glim;
@@ -575,6 +796,111 @@ create_bindings_system(V_object& result, API_Version /*version*/)
       }
       ASTERIA_BINDING_END);
 
+    result.insert_or_assign(sref("gc_get_slice_budget"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_get_slice_budget", self, global, reader) {
+        V_integer gen;
+
+        reader.start_overload();
+        reader.required(gen);      // generation
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_get_slice_budget, global, gen);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("gc_set_slice_budget"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_set_slice_budget", self, global, reader) {
+        V_integer gen;
+        V_integer bdgt;
+
+        reader.start_overload();
+        reader.required(gen);      // generation
+        reader.required(bdgt);     // budget
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_set_slice_budget, global, gen, bdgt);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("gc_collect_slice"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_collect_slice", self, global, reader) {
+        V_integer gen;
+        V_integer bdgt;
+
+        reader.start_overload();
+        reader.required(gen);      // generation
+        reader.required(bdgt);     // budget
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_collect_slice, global, gen, bdgt);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("gc_collect_timed"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_collect_timed", self, global, reader) {
+        V_integer dura;
+        Opt_integer glim;
+
+        reader.start_overload();
+        reader.required(dura);     // duration
+        reader.optional(glim);     // [generation_limit]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_collect_timed, global, dura, glim);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("gc_stats"),
+      ASTERIA_BINDING_BEGIN("std.system.gc_stats", self, global, reader) {
+        reader.start_overload();
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_gc_stats, global);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("parallel_get_threads"),
+      ASTERIA_BINDING_BEGIN("std.system.parallel_get_threads", self, global, reader) {
+        reader.start_overload();
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_parallel_get_threads, global);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("parallel_set_threads"),
+      ASTERIA_BINDING_BEGIN("std.system.parallel_set_threads", self, global, reader) {
+        V_integer nthrs;
+
+        reader.start_overload();
+        reader.required(nthrs);    // threads
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_parallel_set_threads, global, nthrs);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("parallel_get_cutoff"),
+      ASTERIA_BINDING_BEGIN("std.system.parallel_get_cutoff", self, global, reader) {
+        reader.start_overload();
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_parallel_get_cutoff, global);
+      }
+      ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("parallel_set_cutoff"),
+      ASTERIA_BINDING_BEGIN("std.system.parallel_set_cutoff", self, global, reader) {
+        V_integer cutoff;
+
+        reader.start_overload();
+        reader.required(cutoff);   // cutoff
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_parallel_set_cutoff, global, cutoff);
+      }
+      ASTERIA_BINDING_END);
+
     result.insert_or_assign(sref("env_get_variable"),
       ASTERIA_BINDING_BEGIN("std.system.env_get_variable", self, global, reader) {
         V_string name;
@@ -680,6 +1006,18 @@ create_bindings_system(V_object& result, API_Version /*version*/)
                     std_system_conf_load_file, path);
       }
       ASTERIA_BINDING_END);
+
+    result.insert_or_assign(sref("import_invalidate_cache"),
+      ASTERIA_BINDING_BEGIN("std.system.import_invalidate_cache", self, global, reader) {
+        Opt_string path;
+
+        reader.start_overload();
+        reader.optional(path);     // [path]
+        if(reader.end_overload())
+          ASTERIA_BINDING_RETURN_MOVE(self,
+                    std_system_import_invalidate_cache, global, path);
+      }
+      ASTERIA_BINDING_END);
   }
 
 }  // namespace asteria
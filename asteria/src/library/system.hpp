@@ -20,10 +20,55 @@ std_system_gc_get_threshold(Global_Context& global, V_integer generation);
 Opt_integer
 std_system_gc_set_threshold(Global_Context& global, V_integer generation, V_integer threshold);
 
+// `std.system.gc_get_adaptive`
+Opt_boolean
+std_system_gc_get_adaptive(Global_Context& global, V_integer generation);
+
+// `std.system.gc_set_adaptive`
+Opt_boolean
+std_system_gc_set_adaptive(Global_Context& global, V_integer generation, V_boolean adaptive);
+
 // `std.system.gc_collect`
 V_integer
 std_system_gc_collect(Global_Context& global, Opt_integer generation_limit);
 
+// `std.system.gc_get_slice_budget`
+Opt_integer
+std_system_gc_get_slice_budget(Global_Context& global, V_integer generation);
+
+// `std.system.gc_set_slice_budget`
+Opt_integer
+std_system_gc_set_slice_budget(Global_Context& global, V_integer generation, V_integer budget);
+
+// `std.system.gc_collect_slice`
+Opt_integer
+std_system_gc_collect_slice(Global_Context& global, V_integer generation, V_integer budget);
+
+// `std.system.gc_collect_timed`
+V_integer
+std_system_gc_collect_timed(Global_Context& global, V_integer duration,
+                            Opt_integer generation_limit);
+
+// `std.system.gc_stats`
+V_array
+std_system_gc_stats(Global_Context& global);
+
+// `std.system.parallel_get_threads`
+V_integer
+std_system_parallel_get_threads(Global_Context& global);
+
+// `std.system.parallel_set_threads`
+V_integer
+std_system_parallel_set_threads(Global_Context& global, V_integer threads);
+
+// `std.system.parallel_get_cutoff`
+V_integer
+std_system_parallel_get_cutoff(Global_Context& global);
+
+// `std.system.parallel_set_cutoff`
+V_integer
+std_system_parallel_set_cutoff(Global_Context& global, V_integer cutoff);
+
 // `std.system.env_get_variable`
 Opt_string
 std_system_env_get_variable(V_string name);
@@ -64,6 +109,10 @@ std_system_proc_daemonize();
 V_object
 std_system_conf_load_file(V_string path);
 
+// `std.system.import_invalidate_cache`
+V_integer
+std_system_import_invalidate_cache(Global_Context& global, Opt_string path);
+
 // Create an object that is to be referenced as `std.system`.
 void
 create_bindings_system(V_object& result, API_Version version);
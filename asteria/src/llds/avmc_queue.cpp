@@ -22,13 +22,16 @@ do_destroy_nodes()
       auto qnode = next;
       next += UINT32_C(1) + qnode->nheaders;
 
+      if(!qnode->meta_ver)
+        continue;
+
       // Destroy `sparam`, if any.
-      if(qnode->meta_ver && qnode->pv_meta->dtor_opt)
-        qnode->pv_meta->dtor_opt(qnode);
+      auto meta = details_avmc_queue::do_get_metadata(qnode);
+      if(meta->dtor_opt)
+        meta->dtor_opt(qnode);
 
       // Deallocate the vtable and symbols.
-      if(qnode->meta_ver)
-        delete qnode->pv_meta;
+      delete meta;
     }
 #ifdef ROCKET_DEBUG
     ::std::memset(this->m_bptr, 0xE6, this->m_rsrv * sizeof(Header));
@@ -66,8 +69,8 @@ do_reallocate(uint32_t nadd)
       offset += UINT32_C(1) + qnode->nheaders;
 
       // Relocate `sparam`, if any.
-      if(qnode->meta_ver && qnode->pv_meta->reloc_opt)
-        qnode->pv_meta->reloc_opt(qnode, qfrom);
+      if(qnode->meta_ver && details_avmc_queue::do_get_metadata(qnode)->reloc_opt)
+        details_avmc_queue::do_get_metadata(qnode)->reloc_opt(qnode, qfrom);
     }
     if(bold)
       ::operator delete(bold);
@@ -75,7 +78,7 @@ do_reallocate(uint32_t nadd)
 
 details_avmc_queue::Header*
 AVMC_Queue::
-do_reserve_one(Uparam uparam, size_t size)
+do_reserve_one(Uparam uparam, Dispatch disp, size_t size)
   {
     constexpr size_t size_max = UINT8_MAX * sizeof(Header) - 1;
     if(size > size_max)
@@ -103,14 +106,32 @@ do_reserve_one(Uparam uparam, size_t size)
     qnode->uparam = uparam;
     qnode->nheaders = static_cast<uint8_t>(nheaders_p1 - UINT32_C(1));
     qnode->meta_ver = 0;
+    qnode->disp = disp & 3U;
+    qnode->disp_next = details_avmc_queue::dispatch_end;
     return qnode;
   }
 
+void
+AVMC_Queue::
+do_accept_one(Header* qnode)
+  noexcept
+  {
+    ROCKET_ASSERT(qnode == this->m_bptr + this->m_used);
+
+    // Link this node to its predecessor, if any.
+    if(this->m_used)
+      this->m_bptr[this->m_last].disp_next = qnode->disp;
+
+    this->m_last = this->m_used;
+    this->m_used += UINT32_C(1) + qnode->nheaders;
+  }
+
 AVMC_Queue&
 AVMC_Queue::
-do_append_trivial(Uparam uparam, Executor* exec, size_t size, const void* data_opt)
+do_append_trivial(Uparam uparam, Executor* exec, Dispatch disp, size_t size,
+                  const void* data_opt)
   {
-    auto qnode = this->do_reserve_one(uparam, size);
+    auto qnode = this->do_reserve_one(uparam, disp, size);
 
     // Copy source data if `data_opt` is non-null. Fill zeroes otherwise.
     // This operation will not throw exceptions.
@@ -120,18 +141,20 @@ do_append_trivial(Uparam uparam, Executor* exec, size_t size, const void* data_o
       ::std::memset(qnode->sparam, 0, size);
 
     // Accept this node.
-    qnode->pv_exec = exec;
-    this->m_used += UINT32_C(1) + qnode->nheaders;
+    qnode->exec = exec;
+    this->do_accept_one(qnode);
     return *this;
   }
 
 AVMC_Queue&
 AVMC_Queue::
-do_append_nontrivial(Uparam uparam, Executor* exec, const Source_Location* sloc_opt,
-                     Enumerator* enum_opt, Relocator* reloc_opt, Destructor* dtor_opt,
-                     size_t size, Constructor* ctor_opt, intptr_t ctor_arg)
+do_append_nontrivial(Uparam uparam, Executor* exec, Dispatch disp,
+                     const Source_Location* sloc_opt, Enumerator* enum_opt,
+                     Relocator* reloc_opt, Destructor* dtor_opt, size_t size,
+                     Constructor* ctor_opt, intptr_t ctor_arg)
   {
-    auto qnode = this->do_reserve_one(uparam, size);
+    // Reserve space for a pointer to metadata after `sparam`.
+    auto qnode = this->do_reserve_one(uparam, disp, size + sizeof(void*));
 
     // Allocate metadata for this node.
     auto meta = ::rocket::make_unique<details_avmc_queue::Metadata>();
@@ -140,7 +163,6 @@ do_append_nontrivial(Uparam uparam, Executor* exec, const Source_Location* sloc_
     meta->reloc_opt = reloc_opt;
     meta->dtor_opt = dtor_opt;
     meta->enum_opt = enum_opt;
-    meta->exec = exec;
 
     if(sloc_opt) {
       meta->syms = *sloc_opt;
@@ -155,9 +177,10 @@ do_append_nontrivial(Uparam uparam, Executor* exec, const Source_Location* sloc_
       ::std::memset(qnode->sparam, 0, size);
 
     // Accept this node.
-    qnode->pv_meta = meta.release();
-    qnode->meta_ver = meta_ver;
-    this->m_used += UINT32_C(1) + qnode->nheaders;
+    qnode->exec = exec;
+    qnode->meta_ver = meta_ver & 3U;
+    details_avmc_queue::do_get_metadata(qnode) = meta.release();
+    this->do_accept_one(qnode);
     return *this;
   }
 
@@ -166,30 +189,74 @@ AVMC_Queue::
 execute(Executive_Context& ctx)
   const
   {
-    auto next = this->m_bptr;
-    const auto eptr = this->m_bptr + this->m_used;
-    while(ROCKET_EXPECT(next != eptr)) {
-      auto qnode = next;
-      next += UINT32_C(1) + qnode->nheaders;
+    const Header* qnode = this->m_bptr;
+    uint32_t disp = details_avmc_queue::dispatch_end;
+    if(this->m_used)
+      disp = qnode->disp;
+    AIR_Status status;
 
-      AIR_Status status;
-      if(ROCKET_UNEXPECT(qnode->meta_ver >= 2)) {
-        // Symbols are available.
-        ASTERIA_RUNTIME_TRY {
-          status = qnode->pv_meta->exec(ctx, qnode);
-        }
-        ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
-          except.push_frame_plain(qnode->pv_meta->syms, sref(""));
-          throw;
-        }
-      }
-      else {
-        // Symbols are not available.
-        status = (qnode->meta_ver ? qnode->pv_meta->exec
-                                  : qnode->pv_exec)(ctx, qnode);
-      }
+    // Nodes are dispatched through executors in their headers. Status codes are
+    // only checked for nodes that may divert control flow.
+    // Exceptions are handled out of the loop, where symbols of the node that has
+    // thrown the exception are looked up, so no per-node setup is required.
+    try {
+#if defined(__GNUC__) && defined(ASTERIA_ENABLE_THREADED_DISPATCH)
+      // Use direct threading. Each node is followed by an indirect jump of its
+      // own, to the handler of its successor.
+      static const void* const s_handlers[] =
+        {
+          &&do_dispatch_end,
+          &&do_dispatch_plain,
+          &&do_dispatch_checked,
+        };
+
+      goto *(s_handlers[disp]);
+
+    do_dispatch_plain:
+      status = details_avmc_queue::do_load_executor(qnode)(ctx, qnode);
+      ROCKET_ASSERT(status == air_status_next);
+      disp = qnode->disp_next;
+      qnode += UINT32_C(1) + qnode->nheaders;
+      goto *(s_handlers[disp]);
+
+    do_dispatch_checked:
+      status = details_avmc_queue::do_load_executor(qnode)(ctx, qnode);
       if(ROCKET_UNEXPECT(status != air_status_next))
         return status;
+      disp = qnode->disp_next;
+      qnode += UINT32_C(1) + qnode->nheaders;
+      goto *(s_handlers[disp]);
+
+    do_dispatch_end:
+      ;
+#else
+      // Use a plain loop.
+      while(ROCKET_EXPECT(disp != details_avmc_queue::dispatch_end)) {
+        status = details_avmc_queue::do_load_executor(qnode)(ctx, qnode);
+        if(ROCKET_UNEXPECT(disp == details_avmc_queue::dispatch_checked)
+           && ROCKET_UNEXPECT(status != air_status_next))
+          return status;
+
+        ROCKET_ASSERT(status == air_status_next);
+        disp = qnode->disp_next;
+        qnode += UINT32_C(1) + qnode->nheaders;
+      }
+#endif
+    }
+    catch(Runtime_Error& except) {
+      // Append symbols, if any.
+      if(qnode->meta_ver >= 2)
+        except.push_frame_plain(details_avmc_queue::do_get_metadata(qnode)->syms, sref(""));
+      throw;
+    }
+    catch(::std::exception& stdex) {
+      // Convert the exception, only if symbols are available.
+      if(qnode->meta_ver < 2)
+        throw;
+
+      Runtime_Error except(Runtime_Error::M_native(), stdex);
+      except.push_frame_plain(details_avmc_queue::do_get_metadata(qnode)->syms, sref(""));
+      throw except;
     }
     return air_status_next;
   }
@@ -206,8 +273,8 @@ enumerate_variables(Variable_Callback& callback)
       next += UINT32_C(1) + qnode->nheaders;
 
       // Enumerate variables from this node.
-      if(qnode->meta_ver && qnode->pv_meta->enum_opt)
-        qnode->pv_meta->enum_opt(callback, qnode);
+      if(qnode->meta_ver && details_avmc_queue::do_get_metadata(qnode)->enum_opt)
+        details_avmc_queue::do_get_metadata(qnode)->enum_opt(callback, qnode);
     }
     return callback;
   }
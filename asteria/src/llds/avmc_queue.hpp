@@ -14,6 +14,7 @@ class AVMC_Queue
   {
   public:
     using Uparam      = details_avmc_queue::Uparam;
+    using Dispatch    = details_avmc_queue::Dispatch;
     using Header      = details_avmc_queue::Header;
     using Executor    = details_avmc_queue::Executor;
     using Enumerator  = details_avmc_queue::Enumerator;
@@ -27,6 +28,7 @@ class AVMC_Queue
     Header* m_bptr = nullptr;  // beginning of raw storage
     uint32_t m_rsrv = 0;  // size of raw storage, in number of `Header`s [!]
     uint32_t m_used = 0;  // size of used storage, in number of `Header`s [!]
+    uint32_t m_last = 0;  // offset of the last node, in number of `Header`s [!]
 
   public:
     explicit constexpr
@@ -54,21 +56,29 @@ class AVMC_Queue
     // Reserve storage for the next node. `size` is the size of `sparam` to initialize.
     inline
     Header*
-    do_reserve_one(Uparam uparam, size_t size);
+    do_reserve_one(Uparam uparam, Dispatch disp, size_t size);
+
+    // Make a node that has been reserved and initialized a part of this queue.
+    inline
+    void
+    do_accept_one(Header* qnode)
+      noexcept;
 
     // Append a new node to the end. `size` is the size of `sparam` to initialize.
     // If `data_opt` is specified, it should point to the buffer containing data to copy.
     // Otherwise, `sparam` is filled with zeroes.
     AVMC_Queue&
-    do_append_trivial(Uparam uparam, Executor* exec, size_t size, const void* data_opt);
+    do_append_trivial(Uparam uparam, Executor* exec, Dispatch disp, size_t size,
+                      const void* data_opt);
 
     // Append a new node to the end. `size` is the size of `sparam` to initialize.
     // If `ctor_opt` is specified, it is called to initialize `sparam`. Otherwise,
     // `sparam` is filled with zeroes.
     AVMC_Queue&
-    do_append_nontrivial(Uparam uparam, Executor* exec, const Source_Location* sloc_opt,
-                         Enumerator* enum_opt, Relocator* reloc_opt, Destructor* dtor_opt,
-                         size_t size, Constructor* ctor_opt, intptr_t ctor_arg);
+    do_append_nontrivial(Uparam uparam, Executor* exec, Dispatch disp,
+                         const Source_Location* sloc_opt, Enumerator* enum_opt,
+                         Relocator* reloc_opt, Destructor* dtor_opt, size_t size,
+                         Constructor* ctor_opt, intptr_t ctor_arg);
 
   public:
     ~AVMC_Queue()
@@ -116,46 +126,61 @@ class AVMC_Queue
         ::std::swap(this->m_bptr, other.m_bptr);
         ::std::swap(this->m_rsrv, other.m_rsrv);
         ::std::swap(this->m_used, other.m_used);
+        ::std::swap(this->m_last, other.m_last);
         return *this;
       }
 
     // Append a node. This allows you to bind an arbitrary function.
     // If `data` is a null pointer, `size` zero bytes are allocated.
     // Call the `append()` function if the node is non-trivial.
+    // If `diverts` is `false`, `exec` shall always return `air_status_next`.
     AVMC_Queue&
-    append(Executor& exec, const Source_Location* sloc_opt, Uparam up = { })
+    append(Executor& exec, bool diverts, const Source_Location* sloc_opt, Uparam up = { })
       {
+        auto disp = diverts ? details_avmc_queue::dispatch_checked
+                            : details_avmc_queue::dispatch_plain;
         if(!sloc_opt)
-          return this->do_append_trivial(up, exec, 0, nullptr);
+          return this->do_append_trivial(up, exec, disp, 0, nullptr);
 
-        return this->do_append_nontrivial(up, exec, sloc_opt,
+        return this->do_append_nontrivial(up, exec, disp, sloc_opt,
                            nullptr, nullptr, nullptr, 0, nullptr, 0);
       }
 
     template<typename XSparamT>
     AVMC_Queue&
-    append(Executor& exec, const Source_Location* sloc_opt, XSparamT&& sp)
+    append(Executor& exec, bool diverts, const Source_Location* sloc_opt, XSparamT&& sp)
       {
-        return this->append(exec, sloc_opt, Uparam(), ::std::forward<XSparamT>(sp));
+        return this->append(exec, diverts, sloc_opt, Uparam(), ::std::forward<XSparamT>(sp));
       }
 
     template<typename XSparamT>
     AVMC_Queue&
-    append(Executor& exec, const Source_Location* sloc_opt, Uparam up, XSparamT&& sp)
+    append(Executor& exec, bool diverts, const Source_Location* sloc_opt, Uparam up,
+           XSparamT&& sp)
       {
         using Sparam = typename ::std::decay<XSparamT>::type;
         static_assert(::std::is_nothrow_move_constructible<Sparam>::value);
         using Traits = details_avmc_queue::Sparam_traits<Sparam>;
 
-        if(::std::is_trivial<Sparam>::value && !Traits::enum_opt && !sloc_opt)
-          return this->do_append_trivial(up, exec, sizeof(sp), ::std::addressof(sp));
+        auto disp = diverts ? details_avmc_queue::dispatch_checked
+                            : details_avmc_queue::dispatch_plain;
+        if(Traits::trivial && !sloc_opt)
+          return this->do_append_trivial(up, exec, disp, sizeof(sp), ::std::addressof(sp));
 
-        return this->do_append_nontrivial(up, exec, sloc_opt,
+        return this->do_append_nontrivial(up, exec, disp, sloc_opt,
                           Traits::enum_opt, Traits::reloc_opt, Traits::dtor_opt,
                           sizeof(sp), details_avmc_queue::do_forward_ctor<XSparamT>,
                           reinterpret_cast<intptr_t>(::std::addressof(sp)));
       }
 
+    // Replace the executor of a node that is being executed. `exec` shall take
+    // the same `uparam` and `sparam` as the old one.
+    static
+    void
+    replace_executor(const Header* head, Executor& exec)
+      noexcept
+      { details_avmc_queue::do_store_executor(head, &exec);  }
+
     // These are interfaces called by the runtime.
     AIR_Status
     execute(Executive_Context& ctx)
@@ -10,25 +10,22 @@ namespace asteria {
 
 void
 Reference_Dictionary::
-do_destroy_buckets()
+do_destroy_slots()
   noexcept
   {
-    auto next = this->m_head;
-    while(ROCKET_EXPECT(next)) {
-      auto qbkt = next;
-      next = qbkt->next;
-
-      // Destroy this bucket.
-      ROCKET_ASSERT(*qbkt);
-      ::rocket::destroy_at(qbkt->kstor);
-      ::rocket::destroy_at(qbkt->vstor);
-      qbkt->next = nullptr;
+    auto next = this->m_sptr;
+    const auto eptr = this->m_sptr + this->m_size;
+    while(ROCKET_EXPECT(next != eptr)) {
+      auto qslot = next;
+      next += 1;
+
+      // Destroy this slot.
+      ::rocket::destroy_at(qslot);
     }
 #ifdef ROCKET_DEBUG
-    ::std::for_each(this->m_bptr, this->m_eptr, [&](Bucket& r) {
-              ::std::memset((void*)&r, 0xD3, sizeof(r));  r.prev = nullptr;  });
+    ::std::memset((void*)this->m_sptr, 0xD3, this->m_scap * sizeof(Slot));
 #endif
-    this->m_head = reinterpret_cast<Bucket*>(0xDEADBEEF);
+    this->m_size = 0;
   }
 
 details_reference_dictionary::Bucket*
@@ -45,20 +42,8 @@ do_xprobe(const phsh_string& name)
     auto mptr = ::rocket::get_probing_origin(bptr, eptr, name.rdhash());
     auto qbkt = ::rocket::linear_probe(bptr, mptr, mptr, eptr,
            [&](const Bucket& r) {
-             // This handwritten bytewise comparison prevents unnecessary pushs and
-             // pops in the prolog and epilog of this function.
-             if(r.kstor[0].length() != name.length())
-               return false;
-
-             if(r.kstor[0].data() == name.data())
-               return true;
-
-             if(r.kstor[0].rdhash() != name.rdhash())
-               return false;
-
-             return ::std::equal(r.kstor[0].data(),
-                                 r.kstor[0].data() + r.kstor[0].length(),
-                                 static_cast<const volatile char*>(name.data()));
+             return details_reference_dictionary::do_name_equals(
+                                  this->m_sptr[r.ind1 - 1].name, name);
            });
 
     // The load factor is kept <= 0.5 so there must always be a bucket available.
@@ -77,34 +62,22 @@ do_xrelocate_but(Bucket* qxcld)
       qxcld + 1,
       this->m_eptr,
       [&](Bucket& rb) {
-        auto sbkt = &rb;
-
-        // Mark this bucket empty, without destroying its contents.
-        ROCKET_ASSERT(*sbkt);
-        this->do_list_detach(sbkt);
+        // Mark this bucket empty.
+        auto ind1 = ::std::exchange(rb.ind1, 0U);
+        ROCKET_ASSERT(ind1 != 0);
 
         // Find a new bucket for the name using linear probing.
         // Uniqueness has already been implied for all elements, so there is no need
         // to check for collisions.
         auto mptr = ::rocket::get_probing_origin(this->m_bptr, this->m_eptr,
-                                                 sbkt->kstor->rdhash());
+                                                 this->m_sptr[ind1 - 1].name.rdhash());
         auto qbkt = ::rocket::linear_probe(this->m_bptr, mptr, mptr, this->m_eptr,
                                            [&](const Bucket&) { return false;  });
         ROCKET_ASSERT(qbkt);
 
-        // Mark the new bucket non-empty.
+        // Relocate the index. Slots are never moved.
         ROCKET_ASSERT(!*qbkt);
-        this->do_list_attach(qbkt);
-
-        // If the two pointers reference the same one, no relocation is needed.
-        if(ROCKET_EXPECT(qbkt == sbkt))
-          return false;
-
-        // Relocate the bucket.
-        ::rocket::construct_at(qbkt->kstor, ::std::move(sbkt->kstor[0]));
-        ::rocket::destroy_at(sbkt->kstor);
-        ::rocket::construct_at(qbkt->vstor, ::std::move(sbkt->vstor[0]));
-        ::rocket::destroy_at(sbkt->vstor);
+        qbkt->ind1 = ind1;
 
         // Keep probing until an empty bucket is found.
         return false;
@@ -115,51 +88,82 @@ void
 Reference_Dictionary::
 do_rehash_more()
   {
-    // Allocate a new table.
-    size_t nbkt = (this->m_size * 3 + 5) | 9;
-    if(nbkt > PTRDIFF_MAX / sizeof(Bucket))
+    // Allocate a new table. Buckets follow slots.
+    size_t scap = (this->m_scap * 3 / 2 + 5) | 7;
+    size_t nbkt = scap * 2 + 1;
+    if(scap >= UINT32_MAX / 2)
       throw ::std::bad_array_new_length();
 
-    if(nbkt / 2 <= this->m_size)
+    if(scap <= this->m_scap)
       throw ::std::bad_alloc();
 
-    auto bptr = static_cast<Bucket*>(::operator new(nbkt * sizeof(Bucket)));
+    auto sptr = static_cast<Slot*>(::operator new(scap * sizeof(Slot) +
+                                                  nbkt * sizeof(Bucket)));
+    auto bptr = reinterpret_cast<Bucket*>(sptr + scap);
     auto eptr = bptr + nbkt;
+#ifdef ROCKET_DEBUG
+    ::std::memset((void*)sptr, 0xE6, scap * sizeof(Slot));
+#endif
 
     // Initialize an empty table.
-    ::std::for_each(bptr, eptr, [&](Bucket& r) { r.prev = nullptr;  });
-    auto bold = ::std::exchange(this->m_bptr, bptr);
+    ::std::for_each(bptr, eptr, [&](Bucket& r) { r.ind1 = 0;  });
+    auto sold = ::std::exchange(this->m_sptr, sptr);
+    this->m_bptr = bptr;
     this->m_eptr = eptr;
+    this->m_scap = static_cast<uint32_t>(scap);
 
-    // Move buckets into the new table.
+    // Move slots into the new table, keeping their indices.
     // Warning: No exception shall be thrown from the code below.
-    auto sbkt = ::std::exchange(this->m_head, nullptr);
-    while(ROCKET_EXPECT(sbkt)) {
-      ROCKET_ASSERT(*sbkt);
+    for(uint32_t k = 0;  k != this->m_size;  ++k) {
+      ::rocket::construct_at(sptr + k, ::std::move(sold[k]));
+      ::rocket::destroy_at(sold + k);
 
       // Find a new bucket for the name using linear probing.
       // Uniqueness has already been implied for all elements, so there is no need
       // to check for collisions.
-      auto mptr = ::rocket::get_probing_origin(bptr, eptr, sbkt->kstor->rdhash());
+      auto mptr = ::rocket::get_probing_origin(bptr, eptr, sptr[k].name.rdhash());
       auto qbkt = ::rocket::linear_probe(bptr, mptr, mptr, eptr,
                                          [&](const Bucket&) { return false;  });
       ROCKET_ASSERT(qbkt);
 
       // Mark the new bucket non-empty.
       ROCKET_ASSERT(!*qbkt);
-      this->do_list_attach(qbkt);
-
-      // Relocate the bucket.
-      ::rocket::construct_at(qbkt->kstor, ::std::move(sbkt->kstor[0]));
-      ::rocket::destroy_at(sbkt->kstor);
-      ::rocket::construct_at(qbkt->vstor, ::std::move(sbkt->vstor[0]));
-      ::rocket::destroy_at(sbkt->vstor);
+      qbkt->ind1 = k + 1;
+    }
+    if(sold)
+      ::operator delete(sold);
+  }
 
-      // Process the next bucket.
-      sbkt = sbkt->next;
+bool
+Reference_Dictionary::
+erase(const phsh_string& name)
+  noexcept
+  {
+    // Be advised that `do_xprobe()` shall not be called when the
+    // table has not been allocated.
+    if(!this->m_bptr)
+      return false;
+
+    // Find the bucket for the name.
+    auto qbkt = this->do_xprobe(name);
+    if(!*qbkt)
+      return false;
+
+    // Detach the bucket, then relocate buckets that follow it, if any.
+    uint32_t index = ::std::exchange(qbkt->ind1, 0U) - 1;
+    this->do_xrelocate_but(qbkt);
+
+    // Fill the hole with the last slot, so slots remain contiguous.
+    uint32_t ilast = this->m_size - 1;
+    if(index != ilast) {
+      auto qlast = this->do_xprobe(this->m_sptr[ilast].name);
+      ROCKET_ASSERT(qlast->ind1 == ilast + 1);
+      qlast->ind1 = index + 1;
+      this->m_sptr[index] = ::std::move(this->m_sptr[ilast]);
     }
-    if(bold)
-      ::operator delete(bold);
+    ::rocket::destroy_at(this->m_sptr + ilast);
+    this->m_size--;
+    return true;
   }
 
 Variable_Callback&
@@ -167,14 +171,14 @@ Reference_Dictionary::
 enumerate_variables(Variable_Callback& callback)
   const
   {
-    auto next = this->m_head;
-    while(ROCKET_EXPECT(next)) {
-      auto qbkt = next;
-      next = qbkt->next;
+    auto next = this->m_sptr;
+    const auto eptr = this->m_sptr + this->m_size;
+    while(ROCKET_EXPECT(next != eptr)) {
+      auto qslot = next;
+      next += 1;
 
       // Enumerate child variables.
-      ROCKET_ASSERT(*qbkt);
-      qbkt->vstor[0].enumerate_variables(callback);
+      qslot->ref.enumerate_variables(callback);
     }
     return callback;
   }
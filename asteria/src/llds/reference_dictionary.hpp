@@ -13,12 +13,17 @@ namespace asteria {
 class Reference_Dictionary
   {
   private:
-    using Bucket = details_reference_dictionary::Bucket;
+    using Slot    = details_reference_dictionary::Slot;
+    using Bucket  = details_reference_dictionary::Bucket;
 
+    // References are stored in slots in the order of insertion, so a name
+    // can be resolved to a slot index at compile time. Buckets, which are
+    // allocated immediately after slots, map names to slot indices.
+    Slot* m_sptr = nullptr;    // beginning of slot storage
     Bucket* m_bptr = nullptr;  // beginning of bucket storage
     Bucket* m_eptr = nullptr;  // end of bucket storage
-    Bucket* m_head = nullptr;  // the first initialized bucket
-    size_t m_size = 0;         // number of initialized buckets
+    uint32_t m_size = 0;       // number of initialized slots
+    uint32_t m_scap = 0;       // number of slots allocated
 
   public:
     explicit constexpr
@@ -37,7 +42,7 @@ class Reference_Dictionary
 
   private:
     void
-    do_destroy_buckets()
+    do_destroy_slots()
       noexcept;
 
     // This function returns a pointer to either an empty bucket or a
@@ -52,75 +57,17 @@ class Reference_Dictionary
     do_xrelocate_but(Bucket* qxcld)
       noexcept;
 
-    // Valid buckets are linked altogether for efficient iteration.
-    void
-    do_list_attach(Bucket* qbkt)
-      noexcept
-      {
-        // Insert the bucket before `head`.
-        auto next = ::std::exchange(this->m_head, qbkt);
-        // Update the forward list, which is non-circular.
-        qbkt->next = next;
-        // Update the backward list, which is circular.
-        qbkt->prev = next ? ::std::exchange(next->prev, qbkt) : qbkt;
-      }
-
-    void
-    do_list_detach(Bucket* qbkt)
-      noexcept
-      {
-        auto next = qbkt->next;
-        auto prev = qbkt->prev;
-        auto head = this->m_head;
-
-        // Update the forward list, which is non-circular.
-        ((qbkt == head) ? this->m_head : prev->next) = next;
-        // Update the backward list, which is circular.
-        (next ? next : head)->prev = prev;
-        // Mark the bucket empty.
-        qbkt->prev = nullptr;
-      }
-
-    void
-    do_attach(Bucket* qbkt, const phsh_string& name)
-      noexcept
-      {
-        // Construct the node, then attach it.
-        ROCKET_ASSERT(!*qbkt);
-        this->do_list_attach(qbkt);
-        ::rocket::construct_at(qbkt->kstor, name);
-        ::rocket::construct_at(qbkt->vstor);
-        ROCKET_ASSERT(*qbkt);
-        this->m_size++;
-      }
-
-    void
-    do_detach(Bucket* qbkt)
-      noexcept
-      {
-        // Destroy the old name and reference, then detach the bucket.
-        this->m_size--;
-        ROCKET_ASSERT(*qbkt);
-        ::rocket::destroy_at(qbkt->kstor);
-        ::rocket::destroy_at(qbkt->vstor);
-        this->do_list_detach(qbkt);
-        ROCKET_ASSERT(!*qbkt);
-
-        // Relocate nodes that follow `qbkt`, if any.
-        this->do_xrelocate_but(qbkt);
-      }
-
     void
     do_rehash_more();
 
   public:
     ~Reference_Dictionary()
       {
-        if(this->m_head)
-          this->do_destroy_buckets();
+        if(this->m_size)
+          this->do_destroy_slots();
 
-        if(this->m_bptr)
-          ::operator delete(this->m_bptr);
+        if(this->m_sptr)
+          ::operator delete(this->m_sptr);
 
 #ifdef ROCKET_DEBUG
         ::std::memset(static_cast<void*>(this), 0xA6, sizeof(*this));
@@ -130,22 +77,27 @@ class Reference_Dictionary
     bool
     empty()
       const noexcept
-      { return this->m_head == nullptr;  }
+      { return this->m_size == 0;  }
 
     size_t
     size()
       const noexcept
       { return this->m_size;  }
 
+    size_t
+    capacity()
+      const noexcept
+      { return this->m_scap;  }
+
     Reference_Dictionary&
     clear()
       noexcept
       {
-        if(this->m_head)
-          this->do_destroy_buckets();
+        if(this->m_size)
+          this->do_destroy_slots();
 
         // Clean invalid data up.
-        this->m_head = nullptr;
+        ::std::for_each(this->m_bptr, this->m_eptr, [&](Bucket& r) { r.ind1 = 0;  });
         this->m_size = 0;
         return *this;
       }
@@ -154,10 +106,11 @@ class Reference_Dictionary
     swap(Reference_Dictionary& other)
       noexcept
       {
+        ::std::swap(this->m_sptr, other.m_sptr);
         ::std::swap(this->m_bptr, other.m_bptr);
         ::std::swap(this->m_eptr, other.m_eptr);
-        ::std::swap(this->m_head, other.m_head);
         ::std::swap(this->m_size, other.m_size);
+        ::std::swap(this->m_scap, other.m_scap);
         return *this;
       }
 
@@ -175,8 +128,8 @@ class Reference_Dictionary
         if(!*qbkt)
           return nullptr;
 
-        ROCKET_ASSERT(qbkt->kstor[0].rdhash() == name.rdhash());
-        return qbkt->vstor;
+        ROCKET_ASSERT(this->m_sptr[qbkt->ind1 - 1].name.rdhash() == name.rdhash());
+        return &(this->m_sptr[qbkt->ind1 - 1].ref);
       }
 
     Reference*
@@ -193,47 +146,69 @@ class Reference_Dictionary
         if(!*qbkt)
           return nullptr;
 
-        ROCKET_ASSERT(qbkt->kstor[0].rdhash() == name.rdhash());
-        return qbkt->vstor;
+        ROCKET_ASSERT(this->m_sptr[qbkt->ind1 - 1].name.rdhash() == name.rdhash());
+        return &(this->m_sptr[qbkt->ind1 - 1].ref);
+      }
+
+    // Gets the index of the slot for `name`. If no such name exists,
+    // `UINT32_MAX` is returned.
+    uint32_t
+    find_slot(const phsh_string& name)
+      const noexcept
+      {
+        // Be advised that `do_xprobe()` shall not be called when the
+        // table has not been allocated.
+        if(!this->m_bptr)
+          return UINT32_MAX;
+
+        // Find the bucket for the name.
+        auto qbkt = this->do_xprobe(name);
+        if(!*qbkt)
+          return UINT32_MAX;
+
+        return qbkt->ind1 - 1;
+      }
+
+    // Gets the reference in the slot at `index`, if its name equals `name`.
+    // Slot indices are assigned in the order of insertion, which may differ
+    // between compile time and run time, so the name is always checked, and
+    // the caller shall fall back to `find_opt()` upon failure.
+    const Reference*
+    find_slot_opt(uint32_t index, const phsh_string& name)
+      const noexcept
+      {
+        if(index >= this->m_size)
+          return nullptr;
+
+        auto qslot = this->m_sptr + index;
+        if(!details_reference_dictionary::do_name_equals(qslot->name, name))
+          return nullptr;
+
+        return &(qslot->ref);
       }
 
     pair<Reference*, bool>
     insert(const phsh_string& name)
       {
-        // Reserve more room by rehashing if the load factor would
-        // exceed 0.5.
-        auto nbkt = static_cast<size_t>(this->m_eptr - this->m_bptr);
-        if(ROCKET_UNEXPECT(this->m_size >= nbkt / 2))
+        // Reserve more room if all slots have been used. This also keeps
+        // the load factor of buckets below 0.5.
+        if(ROCKET_UNEXPECT(this->m_size >= this->m_scap))
           this->do_rehash_more();
 
         // Find a bucket for the new name.
         auto qbkt = this->do_xprobe(name);
         if(*qbkt)
-          return ::std::make_pair(qbkt->vstor, false);
+          return ::std::make_pair(&(this->m_sptr[qbkt->ind1 - 1].ref), false);
 
-        // Construct a null reference and return it.
-        this->do_attach(qbkt, name);
-        return ::std::make_pair(qbkt->vstor, true);
+        // Construct a null reference in a new slot and return it.
+        auto qslot = ::rocket::construct_at(this->m_sptr + this->m_size, name);
+        qbkt->ind1 = ++(this->m_size);
+        return ::std::make_pair(&(qslot->ref), true);
       }
 
     bool
     erase(const phsh_string& name)
-      noexcept
-      {
-        // Be advised that `do_xprobe()` shall not be called when the
-        // table has not been allocated.
-        if(!this->m_bptr)
-          return false;
-
-        // Find the bucket for the name.
-        auto qbkt = this->do_xprobe(name);
-        if(!*qbkt)
-          return false;
-
-        // Detach this reference.
-        this->do_detach(qbkt);
-        return true;
-      }
+      noexcept;
 
     Variable_Callback&
     enumerate_variables(Variable_Callback& callback)
@@ -92,6 +92,21 @@ class Reference_Stack
         return *this;
       }
 
+    // Destroy all references, including those that have been popped, but keep
+    // storage for reuse.
+    Reference_Stack&
+    clear_cache()
+      noexcept
+      {
+        if(this->m_einit)
+          this->do_destroy_elements();
+
+        // Clean invalid data up.
+        this->m_etop = 0;
+        this->m_einit = 0;
+        return *this;
+      }
+
     Reference_Stack&
     swap(Reference_Stack& other)
       noexcept
@@ -0,0 +1,35 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "variable_pool.hpp"
+#include "../utils.hpp"
+
+namespace asteria {
+
+void
+Variable_Pool::
+do_reserve_more()
+  {
+    // Allocate a new table.
+    uint32_t estor = (this->m_estor * 3 / 2 + 5) | 61;
+    if(estor > PTRDIFF_MAX / sizeof(Variable*))
+      throw ::std::bad_array_new_length();
+
+    if(estor <= this->m_estor)
+      throw ::std::bad_alloc();
+
+    auto bptr = static_cast<Variable**>(::operator new(estor * sizeof(Variable*)));
+
+    // Move pointers into the new storage.
+    auto bold = ::std::exchange(this->m_bptr, bptr);
+    this->m_estor = estor;
+
+    if(this->m_size)
+      ::std::memcpy(bptr, bold, this->m_size * sizeof(Variable*));
+
+    if(bold)
+      ::operator delete(bold);
+  }
+
+}  // namespace asteria
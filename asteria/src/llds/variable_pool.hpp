@@ -0,0 +1,141 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_LLDS_VARIABLE_POOL_HPP_
+#define ASTERIA_LLDS_VARIABLE_POOL_HPP_
+
+#include "../fwd.hpp"
+#include "../runtime/variable.hpp"
+
+namespace asteria {
+
+// This is a LIFO free list of dead variables, which are recycled by the
+// garbage collector. Each element owns a reference to its variable.
+class Variable_Pool
+  {
+  private:
+    Variable** m_bptr = nullptr;  // beginning of raw storage
+    uint32_t m_size = 0;    // number of variables
+    uint32_t m_estor = 0;   // end of reserved storage
+    uint32_t m_limit;       // maximum number of variables to retain
+
+  public:
+    explicit constexpr
+    Variable_Pool(uint32_t limit = 4096)
+      noexcept
+      : m_limit(limit)
+      { }
+
+    Variable_Pool(Variable_Pool&& other)
+      noexcept
+      : m_limit(other.m_limit)
+      { this->swap(other);  }
+
+    Variable_Pool&
+    operator=(Variable_Pool&& other)
+      noexcept
+      { return this->swap(other);  }
+
+  private:
+    void
+    do_reserve_more();
+
+  public:
+    ~Variable_Pool()
+      {
+        this->clear();
+
+        if(this->m_bptr)
+          ::operator delete(this->m_bptr);
+
+#ifdef ROCKET_DEBUG
+        ::std::memset(static_cast<void*>(this), 0xA7, sizeof(*this));
+#endif
+      }
+
+    bool
+    empty()
+      const noexcept
+      { return this->m_size == 0;  }
+
+    size_t
+    size()
+      const noexcept
+      { return this->m_size;  }
+
+    size_t
+    get_limit()
+      const noexcept
+      { return this->m_limit;  }
+
+    // Variables beyond the new limit are freed.
+    Variable_Pool&
+    set_limit(uint32_t limit)
+      noexcept
+      {
+        this->m_limit = limit;
+        return this->trim(limit);
+      }
+
+    // Frees variables until at most `count` are retained.
+    Variable_Pool&
+    trim(size_t count)
+      noexcept
+      {
+        while(this->m_size > count)
+          rcptr<Variable>(this->m_bptr[--(this->m_size)]).reset();
+        return *this;
+      }
+
+    Variable_Pool&
+    clear()
+      noexcept
+      { return this->trim(0);  }
+
+    Variable_Pool&
+    swap(Variable_Pool& other)
+      noexcept
+      {
+        ::std::swap(this->m_bptr, other.m_bptr);
+        ::std::swap(this->m_size, other.m_size);
+        ::std::swap(this->m_estor, other.m_estor);
+        ::std::swap(this->m_limit, other.m_limit);
+        return *this;
+      }
+
+    // If the pool is full, `var` is not retained, and `false` is returned.
+    bool
+    push(const rcptr<Variable>& var)
+      {
+        if(ROCKET_UNEXPECT(this->m_size >= this->m_limit))
+          return false;
+
+        if(ROCKET_UNEXPECT(this->m_size == this->m_estor))
+          this->do_reserve_more();
+
+        // Take ownership of a new reference.
+        this->m_bptr[this->m_size++] = rcptr<Variable>(var).release();
+        return true;
+      }
+
+    rcptr<Variable>
+    pop_opt()
+      noexcept
+      {
+        if(this->m_size == 0)
+          return nullptr;
+
+        // Transfer ownership of the reference.
+        return rcptr<Variable>(this->m_bptr[--(this->m_size)]);
+      }
+  };
+
+inline
+void
+swap(Variable_Pool& lhs, Variable_Pool& rhs)
+  noexcept
+  { lhs.swap(rhs);  }
+
+}  // namespace asteria
+
+#endif
@@ -26,6 +26,7 @@ struct Command_Line
     bool verbose = false;
     bool interactive = false;
     Compiler_Options opts;
+    cow_string output;
 
     // non-options
     cow_string path;
@@ -64,11 +65,15 @@ get_and_clear_last_signal()
 void
 install_signal_and_verbose_hooks();
 
-// This functions is defined in 'single.cpp'.
+// These functions are defined in 'single.cpp'.
 [[noreturn]]
 void
 load_and_execute_single_noreturn();
 
+[[noreturn]]
+void
+compile_single_noreturn();
+
 // This function is defined in 'commands.cpp'.
 void
 handle_repl_command(cow_string&& cmd, cow_string&& args);
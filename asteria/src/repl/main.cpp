@@ -19,6 +19,7 @@ do_print_help_and_exit(const char* self)
 """""""""""""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 Usage: %s [OPTIONS] [[--] FILE [ARGUMENTS]...]
 
+  -c OUT  compile FILE into bytecode, write it to OUT, then exit
   -h      show help message then exit
   -I      suppress interactive mode [default = auto]
   -i      force interactive mode [default = auto]
@@ -43,6 +44,11 @@ returns no value, the exit status is zero. If the script returns a value
 that is neither an integer nor void, or throws an exception, the status is
 non-zero.
 
+In compile mode, FILE is compiled and written to OUT, which can be passed as
+FILE later, or loaded by `import()`, without being parsed again. Note that
+source locations and paths of imported scripts are not updated if OUT is
+moved elsewhere.
+
 In verbose mode, execution details are printed to standard error. It also
 prevents quick termination, which enables some tools such as valgrind to
 discover memory leaks upon exit.
@@ -90,6 +96,7 @@ do_parse_command_line(int argc, char** argv)
     opt<bool> verbose;
     opt<bool> interactive;
     opt<int8_t> optimize;
+    opt<cow_string> output;
 
     opt<cow_string> path;
     cow_vector<cow_string> args;
@@ -105,9 +112,13 @@ do_parse_command_line(int argc, char** argv)
 
     // Parse command-line options.
     int ch;
-    while((ch = ::getopt(argc, argv, "+hIiO::Vv")) != -1) {
+    while((ch = ::getopt(argc, argv, "+c:hIiO::Vv")) != -1) {
       // Identify a single option.
       switch(ch) {
+        case 'c':
+          output = cow_string(optarg);
+          continue;
+
         case 'h':
           help = true;
           continue;
@@ -185,6 +196,10 @@ do_parse_command_line(int argc, char** argv)
     if(optimize)
       repl_cmdline.opts.optimization_level = *optimize;
 
+    // Bytecode is written only if an output file is given.
+    if(output)
+      repl_cmdline.output = ::std::move(*output);
+
     // These arguments are always overwritten.
     repl_cmdline.path = path.move_value_or(sref("-"));
     repl_cmdline.args = ::std::move(args);
@@ -216,6 +231,10 @@ main(int argc, char** argv)
     if(repl_cmdline.verbose)
       repl_cmdline.opts.verbose_single_step_traps = true;
 
+    // In compile mode, read the script, write its bytecode, then exit.
+    if(!repl_cmdline.output.empty())
+      compile_single_noreturn();
+
     // In non-include mode, read the script, execute it, then exit.
     if(!repl_cmdline.interactive)
       load_and_execute_single_noreturn();
@@ -6,6 +6,7 @@
 #include "../runtime/global_context.hpp"
 #include "../simple_script.hpp"
 #include "../value.hpp"
+#include "../../rocket/tinybuf_file.hpp"
 
 namespace asteria {
 
@@ -47,4 +48,30 @@ load_and_execute_single_noreturn()
     exit_printf(exit_runtime_error, "! error: %s\n", stdex.what());
   }
 
+void
+compile_single_noreturn()
+  try {
+    // Prepare the parser.
+    repl_script.set_options(repl_cmdline.opts);
+
+    // Open the output file first, so nothing is parsed if it can't be written.
+    ::rocket::tinybuf_file obuf;
+    obuf.open(repl_cmdline.output.c_str(),
+              tinybuf::open_write | tinybuf::open_create | tinybuf::open_truncate);
+
+    // Load and compile the script.
+    if(repl_cmdline.path == "-") {
+      ::rocket::tinybuf_file cbuf;
+      cbuf.reset(stdin, nullptr);
+      repl_script.compile(obuf, sref("[stdin]"), 1, cbuf);
+    }
+    else
+      repl_script.compile_file(obuf, repl_cmdline.path.c_str());
+
+    exit_printf(exit_success);
+  }
+  catch(exception& stdex) {
+    exit_printf(exit_parser_error, "! error: %s\n", stdex.what());
+  }
+
 }  // namespace asteria
@@ -16,6 +16,7 @@ class Abstract_Context
     struct M_plain     { };
     struct M_defer     { };
     struct M_function  { };
+    struct M_constant  { };
 
   private:
     // This stores all named references (variables, parameters, etc.) of
@@ -63,6 +64,12 @@ class Abstract_Context
         return *qref;
       }
 
+    // This allows storage of the dictionary to be recycled.
+    Reference_Dictionary&
+    do_mut_named_references()
+      const noexcept
+      { return this->m_named_refs;  }
+
   public:
     ASTERIA_NONCOPYABLE_DESTRUCTOR(Abstract_Context);
 
@@ -86,6 +93,28 @@ class Abstract_Context
         return qref;
       }
 
+    // Named references are assigned slot indices in the order of declaration.
+    // The compiler records the index of a name, which can then be passed to
+    // the overload below as a hint. If the hint turns out to be wrong, e.g.
+    // because control flow has bypassed some declarations, this function
+    // falls back to looking up `name`.
+    uint32_t
+    get_named_reference_slot(const phsh_string& name)
+      const
+      {
+        return this->m_named_refs.find_slot(name);
+      }
+
+    const Reference*
+    get_named_reference_opt(uint32_t slot, const phsh_string& name)
+      const
+      {
+        auto qref = this->m_named_refs.find_slot_opt(slot, name);
+        if(ROCKET_UNEXPECT(!qref))
+          qref = this->get_named_reference_opt(name);
+        return qref;
+      }
+
     Reference&
     open_named_reference(const phsh_string& name)
       {
@@ -70,6 +70,31 @@ struct Abstract_Hooks
       {
         (void)sloc;
       }
+
+    // This hook is called before the collector for `gc_gen` performs a collection,
+    // which may be either a full collection or a slice of an incremental cycle.
+    // N.B. It is suggested that you should not throw exceptions from this hook.
+    virtual
+    void
+    on_gc_collect_begin(GC_Generation gc_gen)
+      {
+        (void)gc_gen;
+      }
+
+    // This hook is called after the collector for `gc_gen` completes a collection.
+    // `ntraversed` and `nfreed` are the numbers of variables that have been traversed
+    // and freed respectively, and `pause_ns` is the time it has taken in nanoseconds.
+    // N.B. It is suggested that you should not throw exceptions from this hook.
+    virtual
+    void
+    on_gc_collect_end(GC_Generation gc_gen, size_t ntraversed, size_t nfreed,
+                      uint64_t pause_ns)
+      {
+        (void)gc_gen;
+        (void)ntraversed;
+        (void)nfreed;
+        (void)pause_ns;
+      }
   };
 
 }  // namespace asteria
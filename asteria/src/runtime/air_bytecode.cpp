@@ -0,0 +1,420 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "air_bytecode.hpp"
+#include "air_node.hpp"
+#include "reference.hpp"
+#include "../value.hpp"
+#include "../utils.hpp"
+
+namespace asteria {
+
+AIR_Bytecode_Writer::
+~AIR_Bytecode_Writer()
+  {
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_bytes(const void* data, size_t size)
+  {
+    this->m_cbuf->putn(static_cast<const char*>(data), size);
+    return *this;
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_uint(uint64_t val)
+  {
+    // Write the value in groups of seven bits, least significant ones first.
+    char bytes[10];
+    size_t nbytes = 0;
+    while(val > 0x7F) {
+      bytes[nbytes++] = static_cast<char>((val & 0x7F) | 0x80);
+      val >>= 7;
+    }
+    bytes[nbytes++] = static_cast<char>(val);
+    return this->put_bytes(bytes, nbytes);
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_int(int64_t val)
+  {
+    // Map small negative values to small positive values.
+    uint64_t bits = static_cast<uint64_t>(val);
+    return this->put_uint((bits << 1) ^ static_cast<uint64_t>(val >> 63));
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_real(double val)
+  {
+    uint64_t bits;
+    ::std::memcpy(&bits, &val, sizeof(bits));
+
+    // Always write the value in little-endian byte order.
+    char bytes[8];
+    for(size_t k = 0;  k != 8;  ++k)
+      bytes[k] = static_cast<char>(bits >> k * 8);
+    return this->put_bytes(bytes, 8);
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_string(const cow_string& str)
+  {
+    // If the string has been written before, write its index.
+    // Otherwise, write the next index followed by its contents.
+    auto result = this->m_strings.try_emplace(str, this->m_strings.size());
+    this->put_uint(result.first->second);
+    if(!result.second)
+      return *this;
+
+    this->put_uint(str.size());
+    return this->put_bytes(str.data(), str.size());
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_strings(const cow_vector<phsh_string>& strs)
+  {
+    this->put_uint(strs.size());
+    for(const auto& str : strs)
+      this->put_string(str.rdstr());
+    return *this;
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_sloc(const Source_Location& sloc)
+  {
+    this->put_string(sloc.file());
+    this->put_int(sloc.line());
+    return this->put_int(sloc.column());
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_options(const Compiler_Options& opts)
+  {
+    // All members are single bytes, so the struct is written verbatim.
+    static_assert(::std::is_trivially_copyable<Compiler_Options>::value, "");
+    this->put_uint(sizeof(opts));
+    return this->put_bytes(&opts, sizeof(opts));
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_value(const Value& val)
+  {
+    this->put_uint(val.type());
+    switch(val.type()) {
+      case type_null:
+        return *this;
+
+      case type_boolean:
+        return this->put_uint(val.as_boolean());
+
+      case type_integer:
+        return this->put_int(val.as_integer());
+
+      case type_real:
+        return this->put_real(val.as_real());
+
+      case type_string:
+        return this->put_string(val.as_string());
+
+      case type_opaque:
+      case type_function:
+        ASTERIA_THROW("Value not serializable (value `$1`)", val);
+
+      case type_array: {
+        const auto& arr = val.as_array();
+        this->put_uint(arr.size());
+        for(const auto& elem : arr)
+          this->put_value(elem);
+        return *this;
+      }
+
+      case type_object: {
+        const auto& obj = val.as_object();
+        this->put_uint(obj.size());
+        for(const auto& pair : obj) {
+          this->put_string(pair.first.rdstr());
+          this->put_value(pair.second);
+        }
+        return *this;
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid value type (type `$1`)", val.type());
+    }
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_reference(const Reference& ref)
+  {
+    // Only constants are allowed. Other references are not known until the
+    // code is executed.
+    if(!ref.is_temporary() || ref.count_modifiers())
+      ASTERIA_THROW("Bound reference not serializable");
+
+    return this->put_value(ref.dereference_readonly());
+  }
+
+AIR_Bytecode_Writer&
+AIR_Bytecode_Writer::
+put_code(const cow_vector<AIR_Node>& code)
+  {
+    this->put_uint(code.size());
+    for(const auto& node : code)
+      node.serialize(*this);
+    return *this;
+  }
+
+AIR_Bytecode_Reader::
+~AIR_Bytecode_Reader()
+  {
+  }
+
+AIR_Bytecode_Reader&
+AIR_Bytecode_Reader::
+get_bytes(void* data, size_t size)
+  {
+    // Note `getn()` may return fewer characters than requested.
+    auto bptr = static_cast<char*>(data);
+    auto eptr = bptr + size;
+    while(bptr != eptr) {
+      size_t nread = this->m_cbuf->getn(bptr, static_cast<size_t>(eptr - bptr));
+      if(nread == 0)
+        ASTERIA_THROW("Bytecode truncated");
+      bptr += nread;
+    }
+    return *this;
+  }
+
+uint64_t
+AIR_Bytecode_Reader::
+get_uint()
+  {
+    uint64_t val = 0;
+    for(uint32_t shift = 0;  shift < 64;  shift += 7) {
+      auto ch = this->m_cbuf->getc();
+      if(ch == EOF)
+        ASTERIA_THROW("Bytecode truncated");
+
+      val |= static_cast<uint64_t>(ch & 0x7F) << shift;
+      if(!(ch & 0x80))
+        return val;
+    }
+    ASTERIA_THROW("Invalid integer in bytecode");
+  }
+
+uint32_t
+AIR_Bytecode_Reader::
+get_uint32()
+  {
+    uint64_t val = this->get_uint();
+    if(val > UINT32_MAX)
+      ASTERIA_THROW("Integer out of range in bytecode (value `$1`)", val);
+    return static_cast<uint32_t>(val);
+  }
+
+int64_t
+AIR_Bytecode_Reader::
+get_int()
+  {
+    uint64_t bits = this->get_uint();
+    return static_cast<int64_t>(bits >> 1) ^ -static_cast<int64_t>(bits & 1);
+  }
+
+double
+AIR_Bytecode_Reader::
+get_real()
+  {
+    unsigned char bytes[8];
+    this->get_bytes(bytes, 8);
+
+    uint64_t bits = 0;
+    for(size_t k = 0;  k != 8;  ++k)
+      bits |= static_cast<uint64_t>(bytes[k]) << k * 8;
+
+    double val;
+    ::std::memcpy(&val, &bits, sizeof(val));
+    return val;
+  }
+
+cow_string
+AIR_Bytecode_Reader::
+get_string()
+  {
+    // If the index refers to a string that has been read, return it.
+    uint64_t index = this->get_uint();
+    if(index < this->m_strings.size())
+      return this->m_strings.at(static_cast<size_t>(index));
+
+    if(index != this->m_strings.size())
+      ASTERIA_THROW("Invalid string index in bytecode (index `$1`)", index);
+
+    // Otherwise, read a new string. The length has not been validated, so
+    // don't allocate memory for bytes that have not been read.
+    cow_string str;
+    size_t nrem = this->get_uint32();
+    char temp[1024];
+    while(nrem != 0) {
+      size_t nread = ::rocket::min(nrem, sizeof(temp));
+      this->get_bytes(temp, nread);
+      str.append(temp, nread);
+      nrem -= nread;
+    }
+    this->m_strings.emplace_back(str);
+    return str;
+  }
+
+cow_vector<phsh_string>
+AIR_Bytecode_Reader::
+get_strings()
+  {
+    cow_vector<phsh_string> strs;
+    size_t size = this->get_uint32();
+    for(size_t k = 0;  k != size;  ++k)
+      strs.emplace_back(this->get_string());
+    return strs;
+  }
+
+Source_Location
+AIR_Bytecode_Reader::
+get_sloc()
+  {
+    auto file = this->get_string();
+    auto line = static_cast<int>(this->get_int());
+    auto column = static_cast<int>(this->get_int());
+    return Source_Location(file, line, column);
+  }
+
+Compiler_Options
+AIR_Bytecode_Reader::
+get_options()
+  {
+    Compiler_Options opts;
+    if(this->get_uint() != sizeof(opts))
+      ASTERIA_THROW("Incompatible compiler options in bytecode");
+
+    // Validate the bytes before copying them, as not all values are valid for
+    // boolean members.
+    unsigned char bytes[sizeof(opts)];
+    this->get_bytes(bytes, sizeof(bytes));
+
+    const auto get_byte = [&](const void* mptr)
+      { return bytes[static_cast<const unsigned char*>(mptr)
+                     - reinterpret_cast<const unsigned char*>(&opts)];  };
+
+    if(get_byte(&(opts.version)) != opts.version)
+      ASTERIA_THROW("Incompatible compiler options in bytecode");
+
+    for(auto mptr : { &Compiler_Options::escapable_single_quotes,
+                      &Compiler_Options::keywords_as_identifiers,
+                      &Compiler_Options::integers_as_reals,
+                      &Compiler_Options::proper_tail_calls,
+                      &Compiler_Options::verbose_single_step_traps })
+      if(get_byte(&(opts.*mptr)) > 1)
+        ASTERIA_THROW("Invalid compiler options in bytecode");
+
+    ::std::memcpy(&opts, bytes, sizeof(opts));
+    return opts;
+  }
+
+Value
+AIR_Bytecode_Reader::
+get_value()
+  {
+    if(this->m_nesting >= nesting_limit)
+      ASTERIA_THROW("Bytecode nested too deeply");
+
+    uint64_t type = this->get_uint();
+    switch(type) {
+      case type_null:
+        return nullopt;
+
+      case type_boolean:
+        return this->get_uint() != 0;
+
+      case type_integer:
+        return this->get_int();
+
+      case type_real:
+        return this->get_real();
+
+      case type_string:
+        return this->get_string();
+
+      case type_array: {
+        V_array arr;
+        size_t size = this->get_uint32();
+        this->m_nesting++;
+        for(size_t k = 0;  k != size;  ++k)
+          arr.emplace_back(this->get_value());
+        this->m_nesting--;
+        return ::std::move(arr);
+      }
+
+      case type_object: {
+        V_object obj;
+        size_t size = this->get_uint32();
+        this->m_nesting++;
+        for(size_t k = 0;  k != size;  ++k) {
+          auto key = this->get_string();
+          obj.insert_or_assign(::std::move(key), this->get_value());
+        }
+        this->m_nesting--;
+        return ::std::move(obj);
+      }
+
+      default:
+        ASTERIA_THROW("Invalid value type in bytecode (type `$1`)", type);
+    }
+  }
+
+Reference
+AIR_Bytecode_Reader::
+get_reference()
+  {
+    Reference ref;
+    ref.set_temporary(this->get_value());
+    return ref;
+  }
+
+uint32_t
+AIR_Bytecode_Reader::
+get_depth()
+  {
+    uint32_t depth = this->get_uint32();
+    if(depth >= this->m_ncontexts)
+      ASTERIA_THROW("Invalid reference depth in bytecode (depth `$1`)", depth);
+    return depth;
+  }
+
+cow_vector<AIR_Node>
+AIR_Bytecode_Reader::
+get_code(uint32_t nctxs)
+  {
+    if(this->m_nesting >= nesting_limit)
+      ASTERIA_THROW("Bytecode nested too deeply");
+
+    // Sizes are not trusted, so nothing is reserved. These counters are not
+    // restored if an exception is thrown, as the reader is unusable anyway.
+    cow_vector<AIR_Node> code;
+    size_t size = this->get_uint32();
+    this->m_nesting++;
+    this->m_ncontexts += nctxs;
+    for(size_t k = 0;  k != size;  ++k)
+      code.emplace_back(AIR_Node::deserialize(*this));
+    this->m_ncontexts -= nctxs;
+    this->m_nesting--;
+    return code;
+  }
+
+}  // namespace asteria
@@ -0,0 +1,141 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_AIR_BYTECODE_HPP_
+#define ASTERIA_RUNTIME_AIR_BYTECODE_HPP_
+
+#include "../fwd.hpp"
+#include "../source_location.hpp"
+
+namespace asteria {
+
+// These classes implement the binary format of AIR code, which is used to store
+// compiled scripts. Integers are encoded as LEB128 numbers; signed ones are
+// zigzag-encoded. Strings are pooled, so each distinct string is stored only
+// once. Only bound references that are constants can be stored.
+class AIR_Bytecode_Writer
+  {
+  private:
+    tinybuf* m_cbuf;
+    cow_dictionary<uint64_t> m_strings;
+
+  public:
+    explicit
+    AIR_Bytecode_Writer(tinybuf& cbuf)
+      noexcept
+      : m_cbuf(::std::addressof(cbuf))
+      { }
+
+  public:
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(AIR_Bytecode_Writer);
+
+    AIR_Bytecode_Writer&
+    put_bytes(const void* data, size_t size);
+
+    AIR_Bytecode_Writer&
+    put_uint(uint64_t val);
+
+    AIR_Bytecode_Writer&
+    put_int(int64_t val);
+
+    AIR_Bytecode_Writer&
+    put_real(double val);
+
+    AIR_Bytecode_Writer&
+    put_string(const cow_string& str);
+
+    AIR_Bytecode_Writer&
+    put_strings(const cow_vector<phsh_string>& strs);
+
+    AIR_Bytecode_Writer&
+    put_sloc(const Source_Location& sloc);
+
+    AIR_Bytecode_Writer&
+    put_options(const Compiler_Options& opts);
+
+    AIR_Bytecode_Writer&
+    put_value(const Value& val);
+
+    AIR_Bytecode_Writer&
+    put_reference(const Reference& ref);
+
+    AIR_Bytecode_Writer&
+    put_code(const cow_vector<AIR_Node>& code);
+  };
+
+class AIR_Bytecode_Reader
+  {
+  public:
+    enum : uint32_t {
+      nesting_limit = 256,
+    };
+
+  private:
+    tinybuf* m_cbuf;
+    cow_vector<cow_string> m_strings;
+
+    // These are used to validate the input. `m_nesting` is the number of
+    // values and code sequences that are being read, and `m_ncontexts` is the
+    // number of contexts that enclose the code that is being read.
+    uint32_t m_nesting = 0;
+    uint32_t m_ncontexts = 0;
+
+  public:
+    explicit
+    AIR_Bytecode_Reader(tinybuf& cbuf)
+      noexcept
+      : m_cbuf(::std::addressof(cbuf))
+      { }
+
+  public:
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(AIR_Bytecode_Reader);
+
+    // All these functions throw exceptions if the input is truncated or
+    // malformed.
+    AIR_Bytecode_Reader&
+    get_bytes(void* data, size_t size);
+
+    uint64_t
+    get_uint();
+
+    uint32_t
+    get_uint32();
+
+    int64_t
+    get_int();
+
+    double
+    get_real();
+
+    cow_string
+    get_string();
+
+    cow_vector<phsh_string>
+    get_strings();
+
+    Source_Location
+    get_sloc();
+
+    Compiler_Options
+    get_options();
+
+    Value
+    get_value();
+
+    Reference
+    get_reference();
+
+    // A local reference must denote one of the contexts that enclose the code
+    // that is being read.
+    uint32_t
+    get_depth();
+
+    // `nctxs` is the number of contexts that are created around the code when
+    // it is executed.
+    cow_vector<AIR_Node>
+    get_code(uint32_t nctxs = 0);
+  };
+
+}  // namespace asteria
+
+#endif
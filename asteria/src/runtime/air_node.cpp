@@ -14,7 +14,9 @@
 #include "variable.hpp"
 #include "ptc_arguments.hpp"
 #include "loader_lock.hpp"
+#include "module_cache.hpp"
 #include "air_optimizer.hpp"
+#include "air_bytecode.hpp"
 #include "../compiler/token_stream.hpp"
 #include "../compiler/statement_sequence.hpp"
 #include "../compiler/statement.hpp"
@@ -63,6 +65,38 @@ do_rebind_return_opt(bool dirty, NodeT&& xnode)
       return ::std::forward<NodeT>(xnode);
   }
 
+bool&
+do_rebind_operand(bool& dirty, AIR_Node::Fused_Operand& opnd, Abstract_Context& ctx)
+  {
+    // Bound references need no rebinding.
+    if(opnd.name.empty())
+      return dirty;
+
+    // Get the context.
+    // Don't bind references in analytic contexts.
+    // References that go beyond the outermost context can't be bound. They can
+    // only come from malformed bytecode, and will fail when executed.
+    Abstract_Context* qctx = &ctx;
+    for(uint32_t k = 0;  k != opnd.depth;  ++k) {
+      qctx = qctx->get_parent_opt();
+      if(!qctx)
+        return dirty;
+    }
+    if(qctx->is_analytic())
+      return dirty;
+
+    // Look for the name in the context.
+    auto qref = qctx->get_named_reference_opt(opnd.slot, opnd.name);
+    if(!qref)
+      return dirty;
+
+    // Bind it now.
+    opnd.ref = *qref;
+    opnd.name.clear();
+    dirty = true;
+    return dirty;
+  }
+
 bool
 do_solidify_nodes(AVMC_Queue& queue, const cow_vector<AIR_Node>& code)
   {
@@ -110,6 +144,42 @@ do_get_first_operand(Reference_Stack& stack, bool assign)
       return stack.mut_back().mutate_into_temporary();
   }
 
+AIR_Status
+do_push_local_reference(Executive_Context& ctx, uint32_t depth, uint32_t slot,
+                        const phsh_string& name)
+  {
+    // Get the context.
+    Executive_Context* qctx = &ctx;
+    for(uint32_t k = 0;  k != depth;  ++k) {
+      qctx = qctx->get_parent_opt();
+      if(!qctx)
+        ASTERIA_THROW("Undeclared identifier `$1`", name);
+    }
+
+    // Look for the name in the context, starting from the slot that has been
+    // assigned by the compiler.
+    auto qref = qctx->get_named_reference_opt(slot, name);
+    if(!qref)
+      ASTERIA_THROW("Undeclared identifier `$1`", name);
+
+    // Check if control flow has bypassed its initialization.
+    if(qref->is_uninit())
+      ASTERIA_THROW("Use of bypassed variable or reference `$1`", name);
+
+    // Push a copy of it.
+    ctx.stack().emplace_back_uninit() = *qref;
+    return air_status_next;
+  }
+
+void
+do_push_fused_operand(Executive_Context& ctx, const AIR_Node::Fused_Operand& opnd)
+  {
+    if(opnd.name.empty())
+      ctx.stack().emplace_back_uninit() = opnd.ref;
+    else
+      do_push_local_reference(ctx, opnd.depth, opnd.slot, opnd.name);
+  }
+
 Reference&
 do_declare(Executive_Context& ctx, const phsh_string& name)
   {
@@ -246,6 +316,42 @@ struct Sparam_func
       }
   };
 
+struct Sparam_fused_operands
+  {
+    AIR_Node::Fused_Operand lhs;
+    AIR_Node::Fused_Operand rhs;
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+      const
+      {
+        this->lhs.ref.enumerate_variables(callback);
+        this->rhs.ref.enumerate_variables(callback);
+        return callback;
+      }
+  };
+
+template<size_t sizeT>
+struct Sparam_fused_queues
+  {
+    AIR_Node::Fused_Operand lhs;
+    AIR_Node::Fused_Operand rhs;
+    array<AVMC_Queue, sizeT> queues;
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+      const
+      {
+        this->lhs.ref.enumerate_variables(callback);
+        this->rhs.ref.enumerate_variables(callback);
+        ::rocket::for_each(this->queues, callback);
+        return callback;
+      }
+  };
+
+using Sparam_fused_queues_1 = Sparam_fused_queues<1>;
+using Sparam_fused_queues_2 = Sparam_fused_queues<2>;
+
 struct Sparam_defer
   {
     Source_Location sloc;
@@ -262,7 +368,9 @@ struct Sparam_defer
 
 // These are traits for individual AIR node types.
 // Each traits struct must contain the `execute()` function, and optionally,
-// these functions: `make_uparam()`, `make_sparam()`, `get_symbols()`.
+// these functions: `make_uparam()`, `make_sparam()`, `get_symbols()`,
+// `may_divert()`. A node whose traits struct has no `may_divert()` shall
+// always return `air_status_next`.
 
 struct AIR_Traits_clear_stack
   {
@@ -283,6 +391,13 @@ struct AIR_Traits_execute_block
     // `up` is unused.
     // `sp` is the solidified body.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_execute_block& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue
     make_sparam(bool& reachable, const AIR_Node::S_execute_block& altr)
@@ -302,7 +417,7 @@ struct AIR_Traits_execute_block
 
 struct AIR_Traits_declare_variable
   {
-    // `up` is unused.
+    // `up` is `escaping`.
     // `sp` is the source location and name;
 
     static
@@ -312,6 +427,15 @@ struct AIR_Traits_declare_variable
         return altr.sloc;
       }
 
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_declare_variable& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.p8[0] = altr.escaping;
+        return up;
+      }
+
     static
     Sparam_sloc_name
     make_sparam(bool& /*reachable*/, const AIR_Node::S_declare_variable& altr)
@@ -324,14 +448,15 @@ struct AIR_Traits_declare_variable
 
     static
     AIR_Status
-    execute(Executive_Context& ctx, const Sparam_sloc_name& sp)
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up, const Sparam_sloc_name& sp)
       {
         const auto qhooks = ctx.global().get_hooks_opt();
         const auto gcoll = ctx.global().genius_collector();
 
-        // Allocate an uninitialized variable.
+        // Allocate an uninitialized variable. A variable that can't escape
+        // from this function can't be involved in cycles either.
         // Inject the variable into the current context.
-        const auto var = gcoll->create_variable();
+        const auto var = up.p8[0] ? gcoll->create_variable() : gcoll->create_untracked_variable();
         ctx.open_named_reference(sp.name).set_variable(var);
         if(qhooks)
           qhooks->on_variable_declare(sp.sloc, sp.name);
@@ -388,6 +513,13 @@ struct AIR_Traits_if_statement
     // `up` is `negative`.
     // `sp` is the two branches.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_if_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& /*reachable*/, const AIR_Node::S_if_statement& altr)
@@ -427,6 +559,13 @@ struct AIR_Traits_switch_statement
     // `up` is unused.
     // `sp` is ... everything.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_switch_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     Sparam_switch
     make_sparam(bool& /*reachable*/, const AIR_Node::S_switch_statement& altr)
@@ -514,6 +653,13 @@ struct AIR_Traits_do_while_statement
     // `up` is `negative`.
     // `sp` is the loop body and condition.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_do_while_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& /*reachable*/, const AIR_Node::S_do_while_statement& altr)
@@ -563,6 +709,13 @@ struct AIR_Traits_while_statement
     // `up` is `negative`.
     // `sp` is the condition and loop body.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_while_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& /*reachable*/, const AIR_Node::S_while_statement& altr)
@@ -612,6 +765,13 @@ struct AIR_Traits_for_each_statement
     // `up` is unused.
     // `sp` is ... everything.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_for_each_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     Sparam_for_each
     make_sparam(bool& /*reachable*/, const AIR_Node::S_for_each_statement& altr)
@@ -711,6 +871,13 @@ struct AIR_Traits_for_statement
     // `up` is unused.
     // `sp` is ... everything.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_for_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     Sparam_queues_4
     make_sparam(bool& /*reachable*/, const AIR_Node::S_for_statement& altr)
@@ -768,6 +935,13 @@ struct AIR_Traits_try_statement
     // `up` is unused.
     // `sp` is ... everything.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_try_statement& /*altr*/)
+      {
+        return true;
+      }
+
     static
     Sparam_try_catch
     make_sparam(bool& reachable, const AIR_Node::S_try_statement& altr)
@@ -914,6 +1088,13 @@ struct AIR_Traits_simple_status
     // `up` is `status`.
     // `sp` is unused.
 
+    static
+    bool
+    may_divert(const AIR_Node::S_simple_status& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& reachable, const AIR_Node::S_simple_status& altr)
@@ -989,7 +1170,7 @@ struct AIR_Traits_push_global_reference
 
 struct AIR_Traits_push_local_reference
   {
-    // `up` is the depth.
+    // `up` is the depth and slot index.
     // `sp` is the source location and name;
 
     static
@@ -1005,6 +1186,7 @@ struct AIR_Traits_push_local_reference
       {
         AVMC_Queue::Uparam up;
         up.s32 = altr.depth;
+        up.s16 = static_cast<uint16_t>(::rocket::min(altr.slot, 0xFFFFU));
         return up;
       }
 
@@ -1019,25 +1201,9 @@ struct AIR_Traits_push_local_reference
     AIR_Status
     execute(Executive_Context& ctx, AVMC_Queue::Uparam up, const phsh_string& name)
       {
-        // Get the context.
-        Executive_Context* qctx = &ctx;
-        for(uint32_t k = 0;  k != up.s32;  ++k) {
-          qctx = qctx->get_parent_opt();
-          ROCKET_ASSERT(qctx);
-        }
-
-        // Look for the name in the context.
-        auto qref = qctx->get_named_reference_opt(name);
-        if(!qref)
-          ASTERIA_THROW("Undeclared identifier `$1`", name);
-
-        // Check if control flow has bypassed its initialization.
-        if(qref->is_uninit())
-          ASTERIA_THROW("Use of bypassed variable or reference `$1`", name);
-
-        // Push a copy of it.
-        ctx.stack().emplace_back_uninit() = *qref;
-        return air_status_next;
+        // Slot indices that don't fit in `s16` will always fall back to name
+        // lookups.
+        return do_push_local_reference(ctx, up.s32, up.s16, name);
       }
   };
 
@@ -1107,6 +1273,13 @@ struct AIR_Traits_branch_expression
         return altr.sloc;
       }
 
+    static
+    bool
+    may_divert(const AIR_Node::S_branch_expression& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& /*reachable*/, const AIR_Node::S_branch_expression& altr)
@@ -1151,6 +1324,13 @@ struct AIR_Traits_coalescence
         return altr.sloc;
       }
 
+    static
+    bool
+    may_divert(const AIR_Node::S_coalescence& /*altr*/)
+      {
+        return true;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& /*reachable*/, const AIR_Node::S_coalescence& altr)
@@ -1257,6 +1437,13 @@ struct AIR_Traits_function_call
         return altr.sloc;
       }
 
+    static
+    bool
+    may_divert(const AIR_Node::S_function_call& altr)
+      {
+        return altr.ptc != ptc_aware_none;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& reachable, const AIR_Node::S_function_call& altr)
@@ -2622,6 +2809,39 @@ struct AIR_Traits_apply_operator_cmp_eq
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
+    static
+    void
+    apply_integer(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_integer() == rhs.as_integer();
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_real() == rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_string().compare(rhs.as_string()) == 0;
+      }
+
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
+        // Check whether the two operands equal.
+        // Unordered operands are not equal.
+        // N.B. This is one of the few operators that work on all types.
+        lhs = lhs.compare(rhs) == compare_equal;
+      }
+
     static
     AIR_Status
     execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
@@ -2630,11 +2850,7 @@ struct AIR_Traits_apply_operator_cmp_eq
         const auto& rhs = ctx.stack().back().dereference_readonly();
         ctx.stack().pop_back();
         auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
-
-        // Check whether the two operands equal.
-        // Unordered operands are not equal.
-        // N.B. This is one of the few operators that work on all types.
-        lhs = lhs.compare(rhs) == compare_equal;
+        apply(lhs, rhs);
         return air_status_next;
       }
   };
@@ -2660,6 +2876,39 @@ struct AIR_Traits_apply_operator_cmp_ne
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
+    static
+    void
+    apply_integer(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_integer() != rhs.as_integer();
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_real() != rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_string().compare(rhs.as_string()) != 0;
+      }
+
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
+        // Check whether the two operands don't equal.
+        // Unordered operands are not equal.
+        // N.B. This is one of the few operators that work on all types.
+        lhs = lhs.compare(rhs) != compare_equal;
+      }
+
     static
     AIR_Status
     execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
@@ -2668,11 +2917,7 @@ struct AIR_Traits_apply_operator_cmp_ne
         const auto& rhs = ctx.stack().back().dereference_readonly();
         ctx.stack().pop_back();
         auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
-
-        // Check whether the two operands don't equal.
-        // Unordered operands are not equal.
-        // N.B. This is one of the few operators that work on all types.
-        lhs = lhs.compare(rhs) != compare_equal;
+        apply(lhs, rhs);
         return air_status_next;
       }
   };
@@ -2698,15 +2943,37 @@ struct AIR_Traits_apply_operator_cmp_lt
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        lhs = lhs.as_integer() < rhs.as_integer();
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        if(::std::isunordered(lhs.as_real(), rhs.as_real()))
+          ASTERIA_THROW("Values not comparable (operands were `$1` and `$2`)",
+                        lhs, rhs);
+
+        lhs = lhs.as_real() < rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_string().compare(rhs.as_string()) < 0;
+      }
 
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
         // Check whether the LHS operand is less than the RHS operand.
         // Throw an exception if they are unordered.
         auto cmp = lhs.compare(rhs);
@@ -2715,6 +2982,17 @@ struct AIR_Traits_apply_operator_cmp_lt
                         lhs, rhs);
 
         lhs = cmp == compare_less;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
         return air_status_next;
       }
   };
@@ -2740,15 +3018,37 @@ struct AIR_Traits_apply_operator_cmp_gt
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        lhs = lhs.as_integer() > rhs.as_integer();
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        if(::std::isunordered(lhs.as_real(), rhs.as_real()))
+          ASTERIA_THROW("Values not comparable (operands were `$1` and `$2`)",
+                        lhs, rhs);
+
+        lhs = lhs.as_real() > rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_string().compare(rhs.as_string()) > 0;
+      }
 
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
         // Check whether the LHS operand is greater than the RHS operand.
         // Throw an exception if they are unordered.
         auto cmp = lhs.compare(rhs);
@@ -2757,6 +3057,17 @@ struct AIR_Traits_apply_operator_cmp_gt
                         lhs, rhs);
 
         lhs = cmp == compare_greater;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
         return air_status_next;
       }
   };
@@ -2782,23 +3093,56 @@ struct AIR_Traits_apply_operator_cmp_lte
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        lhs = lhs.as_integer() <= rhs.as_integer();
+      }
 
-        // Check whether the LHS operand is less than or equal to the RHS operand.
-        // Throw an exception if they are unordered.
-        auto cmp = lhs.compare(rhs);
-        if(cmp == compare_unordered)
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        if(::std::isunordered(lhs.as_real(), rhs.as_real()))
           ASTERIA_THROW("Values not comparable (operands were `$1` and `$2`)",
                         lhs, rhs);
 
-        lhs = cmp != compare_greater;
+        lhs = lhs.as_real() <= rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_string().compare(rhs.as_string()) <= 0;
+      }
+
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
+        // Check whether the LHS operand is less than or equal to the RHS operand.
+        // Throw an exception if they are unordered.
+        auto cmp = lhs.compare(rhs);
+        if(cmp == compare_unordered)
+          ASTERIA_THROW("Values not comparable (operands were `$1` and `$2`)",
+                        lhs, rhs);
+
+        lhs = cmp != compare_greater;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
         return air_status_next;
       }
   };
@@ -2824,15 +3168,37 @@ struct AIR_Traits_apply_operator_cmp_gte
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        lhs = lhs.as_integer() >= rhs.as_integer();
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        if(::std::isunordered(lhs.as_real(), rhs.as_real()))
+          ASTERIA_THROW("Values not comparable (operands were `$1` and `$2`)",
+                        lhs, rhs);
+
+        lhs = lhs.as_real() >= rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        lhs = lhs.as_string().compare(rhs.as_string()) >= 0;
+      }
 
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
         // Check whether the LHS operand is greater than or equal to the RHS operand.
         // Throw an exception if they are unordered.
         auto cmp = lhs.compare(rhs);
@@ -2841,6 +3207,17 @@ struct AIR_Traits_apply_operator_cmp_gte
                         lhs, rhs);
 
         lhs = cmp != compare_less;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
         return air_status_next;
       }
   };
@@ -2922,15 +3299,45 @@ struct AIR_Traits_apply_operator_add
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        ROCKET_ASSERT(lhs.is_integer());
+        ROCKET_ASSERT(rhs.is_integer());
+        auto& x = lhs.open_integer();
+        auto y = rhs.as_integer();
+
+        // Check for overflows.
+        if((y >= 0) ? (x > INT64_MAX - y) : (x < INT64_MIN - y))
+          ASTERIA_THROW("Integer addition overflow (operands were `$1` and `$2`)",
+                        lhs, rhs);
+
+        x += y;
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        lhs.open_real() += rhs.as_real();
+      }
+
+    static
+    void
+    apply_string(Value& lhs, const Value& rhs)
+      {
+        ROCKET_ASSERT(lhs.is_string());
+        ROCKET_ASSERT(rhs.is_string());
+        lhs.open_string() += rhs.as_string();
+      }
 
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
         // For the `boolean` type, perform logical OR of the operands.
         // For the `integer` and `real` types, perform arithmetic addition.
         // For the `string` type, concatenate them.
@@ -2939,44 +3346,42 @@ struct AIR_Traits_apply_operator_add
             ROCKET_ASSERT(lhs.is_boolean());
             ROCKET_ASSERT(rhs.is_boolean());
             lhs.open_boolean() |= rhs.as_boolean();
-            return air_status_next;
+            return;
           }
 
-          case tmask_integer: {
-            ROCKET_ASSERT(lhs.is_integer());
-            ROCKET_ASSERT(rhs.is_integer());
-            auto& x = lhs.open_integer();
-            auto y = rhs.as_integer();
-
-            // Check for overflows.
-            if((y >= 0) ? (x > INT64_MAX - y) : (x < INT64_MIN - y))
-              ASTERIA_THROW("Integer addition overflow (operands were `$1` and `$2`)",
-                            lhs, rhs);
-
-            x += y;
-            return air_status_next;
-          }
+          case tmask_integer:
+            apply_integer(lhs, rhs);
+            return;
 
           case tmask_real | tmask_integer:
           case tmask_real: {
             ROCKET_ASSERT(lhs.is_convertible_to_real());
             ROCKET_ASSERT(rhs.is_convertible_to_real());
             lhs.mutate_into_real() += rhs.convert_to_real();
-            return air_status_next;
+            return;
           }
 
-          case tmask_string: {
-            ROCKET_ASSERT(lhs.is_string());
-            ROCKET_ASSERT(rhs.is_string());
-            lhs.open_string() += rhs.as_string();
-            return air_status_next;
-          }
+          case tmask_string:
+            apply_string(lhs, rhs);
+            return;
 
           default:
             ASTERIA_THROW("Infix addition not applicable (operands were `$1` and `$2`)",
                           lhs, rhs);
         }
       }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
+        return air_status_next;
+      }
   };
 
 struct AIR_Traits_apply_operator_sub
@@ -3000,15 +3405,36 @@ struct AIR_Traits_apply_operator_sub
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        ROCKET_ASSERT(lhs.is_integer());
+        ROCKET_ASSERT(rhs.is_integer());
+        auto& x = lhs.open_integer();
+        auto y = rhs.as_integer();
+
+        // Check for overflows.
+        if((y >= 0) ? (x < INT64_MIN + y) : (x > INT64_MAX + y))
+          ASTERIA_THROW("Integer subtraction overflow (operands were `$1` and `$2`)",
+                        lhs, rhs);
+
+        x -= y;
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        lhs.open_real() -= rhs.as_real();
+      }
 
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
         // For the `boolean` type, perform logical XOR of the operands.
         // For the `integer` and `real` types, perform arithmetic subtraction.
         switch(do_tmask_of(lhs) | do_tmask_of(rhs)) {
@@ -3016,30 +3442,19 @@ struct AIR_Traits_apply_operator_sub
             ROCKET_ASSERT(lhs.is_boolean());
             ROCKET_ASSERT(rhs.is_boolean());
             lhs.open_boolean() ^= rhs.as_boolean();
-            return air_status_next;
+            return;
           }
 
-          case tmask_integer: {
-            ROCKET_ASSERT(lhs.is_integer());
-            ROCKET_ASSERT(rhs.is_integer());
-            auto& x = lhs.open_integer();
-            auto y = rhs.as_integer();
-
-            // Check for overflows.
-            if((y >= 0) ? (x < INT64_MIN + y) : (x > INT64_MAX + y))
-              ASTERIA_THROW("Integer subtraction overflow (operands were `$1` and `$2`)",
-                            lhs, rhs);
-
-            x -= y;
-            return air_status_next;
-          }
+          case tmask_integer:
+            apply_integer(lhs, rhs);
+            return;
 
           case tmask_real | tmask_integer:
           case tmask_real: {
             ROCKET_ASSERT(lhs.is_convertible_to_real());
             ROCKET_ASSERT(rhs.is_convertible_to_real());
             lhs.mutate_into_real() -= rhs.convert_to_real();
-            return air_status_next;
+            return;
           }
 
           default:
@@ -3047,6 +3462,18 @@ struct AIR_Traits_apply_operator_sub
                           lhs, rhs);
         }
       }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
+        return air_status_next;
+      }
   };
 
 struct AIR_Traits_apply_operator_mul
@@ -3070,15 +3497,48 @@ struct AIR_Traits_apply_operator_mul
         return up;
       }
 
+    // These are specialized forms for quickening. Both operands are of the same
+    // type as in their names.
     static
-    AIR_Status
-    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+    void
+    apply_integer(Value& lhs, const Value& rhs)
       {
-        // This operator is binary.
-        const auto& rhs = ctx.stack().back().dereference_readonly();
-        ctx.stack().pop_back();
-        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        ROCKET_ASSERT(lhs.is_integer());
+        ROCKET_ASSERT(rhs.is_integer());
+        auto& x = lhs.open_integer();
+        auto y = rhs.as_integer();
+
+        // Check for overflows.
+        if((x == 0) || (y == 0)) {
+          x = 0;
+        }
+        else if((x == INT64_MIN) || (y == INT64_MIN)) {
+          x = ((x ^ y) >> 63) ^ INT64_MAX;
+        }
+        else {
+          int64_t m = y >> 63;
+          int64_t s = (x ^ m) - m;  // x
+          int64_t u = (y ^ m) - m;  // abs(y)
+
+          if((s >= 0) ? (s > INT64_MAX / u) : (s < INT64_MIN / u))
+            ASTERIA_THROW("Integer multiplication overflow (operands were `$1` and `$2`)",
+                          lhs, rhs);
+
+          x *= y;
+        }
+      }
+
+    static
+    void
+    apply_real(Value& lhs, const Value& rhs)
+      {
+        lhs.open_real() *= rhs.as_real();
+      }
 
+    static
+    void
+    apply(Value& lhs, const Value& rhs)
+      {
         // For the `boolean` type, perform logical AND of the operands.
         // For the `integer` and `real` types, perform arithmetic multiplication.
         // If either operand is an `integer` and the other is a `string`, duplicate the string.
@@ -3087,42 +3547,19 @@ struct AIR_Traits_apply_operator_mul
             ROCKET_ASSERT(lhs.is_boolean());
             ROCKET_ASSERT(rhs.is_boolean());
             lhs.open_boolean() &= rhs.as_boolean();
-            return air_status_next;
+            return;
           }
 
-          case tmask_integer: {
-            ROCKET_ASSERT(lhs.is_integer());
-            ROCKET_ASSERT(rhs.is_integer());
-            auto& x = lhs.open_integer();
-            auto y = rhs.as_integer();
-
-            // Check for overflows.
-            if((x == 0) || (y == 0)) {
-              x = 0;
-            }
-            else if((x == INT64_MIN) || (y == INT64_MIN)) {
-              x = ((x ^ y) >> 63) ^ INT64_MAX;
-            }
-            else {
-              int64_t m = y >> 63;
-              int64_t s = (x ^ m) - m;  // x
-              int64_t u = (y ^ m) - m;  // abs(y)
-
-              if((s >= 0) ? (s > INT64_MAX / u) : (s < INT64_MIN / u))
-                ASTERIA_THROW("Integer multiplication overflow (operands were `$1` and `$2`)",
-                              lhs, rhs);
-
-              x *= y;
-            }
-            return air_status_next;
-          }
+          case tmask_integer:
+            apply_integer(lhs, rhs);
+            return;
 
           case tmask_real | tmask_integer:
           case tmask_real: {
             ROCKET_ASSERT(lhs.is_convertible_to_real());
             ROCKET_ASSERT(rhs.is_convertible_to_real());
             lhs.mutate_into_real() *= rhs.convert_to_real();
-            return air_status_next;
+            return;
           }
 
           case tmask_string | tmask_integer: {
@@ -3156,7 +3593,7 @@ struct AIR_Traits_apply_operator_mul
                 ::std::memcpy(ptr + total, ptr, str.size() - total);
             }
             lhs = ::std::move(str);
-            return air_status_next;
+            return;
           }
 
           default:
@@ -3164,6 +3601,18 @@ struct AIR_Traits_apply_operator_mul
                           lhs, rhs);
         }
       }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up)
+      {
+        // This operator is binary.
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), up.p8[0]);  // assign
+        apply(lhs, rhs);
+        return air_status_next;
+      }
   };
 
 struct AIR_Traits_apply_operator_div
@@ -4089,7 +4538,7 @@ struct AIR_Traits_unpack_struct_object
 
 struct AIR_Traits_define_null_variable
   {
-    // `up` is `immutable`.
+    // `up` is `immutable` and `escaping`.
     // `sp` is the source location and name.
 
     static
@@ -4098,6 +4547,7 @@ struct AIR_Traits_define_null_variable
       {
         AVMC_Queue::Uparam up;
         up.p8[0] = altr.immutable;
+        up.p8[1] = altr.escaping;
         return up;
       }
 
@@ -4127,7 +4577,7 @@ struct AIR_Traits_define_null_variable
 
         // Allocate an uninitialized variable.
         // Inject the variable into the current context.
-        const auto var = gcoll->create_variable();
+        const auto var = up.p8[1] ? gcoll->create_variable() : gcoll->create_untracked_variable();
         ctx.open_named_reference(sp.name).set_variable(var);
         if(qhooks)
           qhooks->on_variable_declare(sp.sloc, sp.name);
@@ -4180,6 +4630,13 @@ struct AIR_Traits_variadic_call
         return altr.sloc;
       }
 
+    static
+    bool
+    may_divert(const AIR_Node::S_variadic_call& altr)
+      {
+        return altr.ptc != ptc_aware_none;
+      }
+
     static
     AVMC_Queue::Uparam
     make_uparam(bool& /*reachable*/, const AIR_Node::S_variadic_call& altr)
@@ -4412,20 +4869,34 @@ struct AIR_Traits_import_call
         Loader_Lock::Unique_Stream strm;
         strm.reset(ctx.global().loader_lock(), path.safe_c_str());
 
-        // Parse source code.
-        Token_Stream tstrm(sp.opts);
-        tstrm.reload(path, 1, strm);
+        // Reuse the function if the file has been compiled with the same options
+        // and has not been modified since.
+        const auto mcache = ctx.global().module_cache();
+        const int fd = ::fileno(strm.get().get_handle());
+        auto qtarget = mcache->get_function_opt(path, fd, sp.opts);
+        if(!qtarget) {
+          AIR_Optimizer optmz(sp.opts);
+          if(AIR_Optimizer::is_bytecode(strm)) {
+            // Load bytecode that has been compiled already.
+            optmz.deserialize(strm);
+          }
+          else {
+            // Parse source code.
+            Token_Stream tstrm(sp.opts);
+            tstrm.reload(path, 1, strm);
 
-        Statement_Sequence stmtq(sp.opts);
-        stmtq.reload(tstrm);
+            Statement_Sequence stmtq(sp.opts);
+            stmtq.reload(tstrm);
 
-        // Instantiate the function.
-        const Source_Location sloc(path, 0, 0);
-        const cow_vector<phsh_string> params(1, sref("..."));
+            const cow_vector<phsh_string> params(1, sref("..."));
+            optmz.reload(nullptr, params, stmtq);
+          }
 
-        AIR_Optimizer optmz(sp.opts);
-        optmz.reload(nullptr, params, stmtq);
-        auto qtarget = optmz.create_function(sloc, sref("[file scope]"));
+          // Instantiate the function.
+          const Source_Location sloc(path, 0, 0);
+          qtarget = optmz.create_function(sloc, sref("[file scope]"));
+          mcache->set_function(path, fd, sp.opts, qtarget);
+        }
 
         // Invoke the script.
         // `this` is null for imported scripts.
@@ -4494,36 +4965,382 @@ struct AIR_Traits_initialize_reference
       }
   };
 
-// Finally...
-template<typename TraitsT, typename NodeT, typename = void>
-struct symbol_getter
-  {
-    static constexpr
-    const Source_Location*
-    opt(const NodeT&)
-      noexcept
-      { return nullptr;  }
- };
-
-template<typename TraitsT, typename NodeT>
-struct symbol_getter<TraitsT, NodeT,
-    ROCKET_VOID_T(decltype(
-        TraitsT::get_symbols(
-            ::std::declval<const NodeT&>())))>
+// These are superinstructions. `OpTraitsT` shall be the traits of a binary
+// operator, which is invoked directly after its operands are pushed.
+template<typename OpTraitsT>
+struct AIR_Traits_fused_apply_operator
   {
-    static constexpr
-    const Source_Location*
-    opt(const NodeT& altr)
-      noexcept
-      { return ::std::addressof(TraitsT::get_symbols(altr));  }
-  };
+    // `up` is `assign`.
+    // `sp` is the two operands.
 
-template<typename TraitsT, typename NodeT, typename = void>
-struct has_uparam
-  : ::std::false_type
-  { };
+    static
+    const Source_Location&
+    get_symbols(const AIR_Node::S_fused_apply_operator& altr)
+      {
+        return altr.sloc;
+      }
 
-template<typename TraitsT, typename NodeT>
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_fused_apply_operator& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.p8[0] = altr.assign;
+        return up;
+      }
+
+    static
+    Sparam_fused_operands
+    make_sparam(bool& /*reachable*/, const AIR_Node::S_fused_apply_operator& altr)
+      {
+        Sparam_fused_operands sp;
+        sp.lhs = altr.lhs;
+        sp.rhs = altr.rhs;
+        return sp;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up, const Sparam_fused_operands& sp)
+      {
+        do_push_fused_operand(ctx, sp.lhs);
+        do_push_fused_operand(ctx, sp.rhs);
+        return OpTraitsT::execute(ctx, up);
+      }
+  };
+
+template<typename OpTraitsT>
+struct AIR_Traits_fused_if_statement
+  {
+    // `up` is `assign` (always false) and `negative`.
+    // `sp` is the two operands and the two branches.
+
+    static
+    const Source_Location&
+    get_symbols(const AIR_Node::S_fused_if_statement& altr)
+      {
+        return altr.sloc;
+      }
+
+    static
+    bool
+    may_divert(const AIR_Node::S_fused_if_statement& /*altr*/)
+      {
+        return true;
+      }
+
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_fused_if_statement& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.p8[0] = false;
+        up.p8[1] = altr.negative;
+        return up;
+      }
+
+    static
+    Sparam_fused_queues_2
+    make_sparam(bool& reachable, const AIR_Node::S_fused_if_statement& altr)
+      {
+        Sparam_fused_queues_2 sp;
+        sp.lhs = altr.lhs;
+        sp.rhs = altr.rhs;
+        bool rtrue = do_solidify_nodes(sp.queues[0], altr.code_true);
+        bool rfalse = do_solidify_nodes(sp.queues[1], altr.code_false);
+        reachable &= rtrue | rfalse;
+        return sp;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up, const Sparam_fused_queues_2& sp)
+      {
+        // Evaluate the condition.
+        do_push_fused_operand(ctx, sp.lhs);
+        do_push_fused_operand(ctx, sp.rhs);
+        auto status = OpTraitsT::execute(ctx, up);
+        ROCKET_ASSERT(status == air_status_next);
+
+        // Check the value of the condition.
+        if(ctx.stack().back().dereference_readonly().test() != up.p8[1])
+          // Execute the true branch and forward the status verbatim.
+          return do_execute_block(sp.queues[0], ctx);
+
+        // Execute the false branch and forward the status verbatim.
+        return do_execute_block(sp.queues[1], ctx);
+      }
+  };
+
+template<typename OpTraitsT>
+struct AIR_Traits_fused_while_statement
+  {
+    // `up` is `assign` (always false) and `negative`.
+    // `sp` is the two operands and the loop body.
+
+    static
+    const Source_Location&
+    get_symbols(const AIR_Node::S_fused_while_statement& altr)
+      {
+        return altr.sloc;
+      }
+
+    static
+    bool
+    may_divert(const AIR_Node::S_fused_while_statement& /*altr*/)
+      {
+        return true;
+      }
+
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_fused_while_statement& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.p8[0] = false;
+        up.p8[1] = altr.negative;
+        return up;
+      }
+
+    static
+    Sparam_fused_queues_1
+    make_sparam(bool& /*reachable*/, const AIR_Node::S_fused_while_statement& altr)
+      {
+        Sparam_fused_queues_1 sp;
+        sp.lhs = altr.lhs;
+        sp.rhs = altr.rhs;
+        do_solidify_nodes(sp.queues[0], altr.code_body);
+        return sp;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, AVMC_Queue::Uparam up, const Sparam_fused_queues_1& sp)
+      {
+        // This is the same as the `while` statement in C.
+        for(;;) {
+          // Check the condition.
+          ctx.stack().clear();
+          do_push_fused_operand(ctx, sp.lhs);
+          do_push_fused_operand(ctx, sp.rhs);
+          auto status = OpTraitsT::execute(ctx, up);
+          ROCKET_ASSERT(status == air_status_next);
+          if(ctx.stack().back().dereference_readonly().test() == up.p8[1])
+            break;
+
+          // Execute the body.
+          status = do_execute_block(sp.queues[0], ctx);
+          if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while }))
+            break;
+
+          if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                            air_status_continue_while }))
+            return status;
+        }
+        return air_status_next;
+      }
+  };
+
+// These implement quickening of binary operators. A node starts with an
+// executor that looks at the types of its operands, then replaces itself with
+// a form that is specialized for them. If a specialized form sees operands of
+// other types, it replaces itself with the generic form, which stays. Each form
+// checks its operands, so it does not matter which one another thread that is
+// executing the same node sees.
+// `OperandsT` pushes operands that are stored in the node, if any.
+using Quick_Applier = void (Value& lhs, const Value& rhs);
+
+struct Quick_operands_on_stack
+  {
+    static
+    void
+    push(Executive_Context& /*ctx*/, const AVMC_Queue::Header* /*head*/)
+      noexcept
+      { }
+  };
+
+struct Quick_operands_fused
+  {
+    static
+    void
+    push(Executive_Context& ctx, const AVMC_Queue::Header* head)
+      {
+        const auto& sp = reinterpret_cast<const Sparam_fused_operands&>(head->sparam);
+        do_push_fused_operand(ctx, sp.lhs);
+        do_push_fused_operand(ctx, sp.rhs);
+      }
+  };
+
+template<typename OpTraitsT, typename OperandsT>
+struct AIR_Quickened_operator
+  {
+    static
+    AIR_Status
+    do_generic(Executive_Context& ctx, const AVMC_Queue::Header* head)
+      {
+        OperandsT::push(ctx, head);
+        return OpTraitsT::execute(ctx, head->uparam);
+      }
+
+    template<uint32_t tmaskT, Quick_Applier& applyT>
+    ROCKET_FLATTEN_FUNCTION
+    static
+    AIR_Status
+    do_quick(Executive_Context& ctx, const AVMC_Queue::Header* head)
+      {
+        OperandsT::push(ctx, head);
+        const auto& rhs = ctx.stack().back().dereference_readonly();
+        ctx.stack().pop_back();
+        auto& lhs = do_get_first_operand(ctx.stack(), head->uparam.p8[0]);  // assign
+
+        // Check whether both operands are still of the expected type.
+        if(ROCKET_EXPECT((do_tmask_of(lhs) | do_tmask_of(rhs)) == tmaskT)) {
+          applyT(lhs, rhs);
+          return air_status_next;
+        }
+
+        AVMC_Queue::replace_executor(head, do_generic);
+        OpTraitsT::apply(lhs, rhs);
+        return air_status_next;
+      }
+
+    static
+    AIR_Status
+    do_learn(Executive_Context& ctx, const AVMC_Queue::Header* head);
+  };
+
+template<typename QuickT, typename OpTraitsT, uint32_t tmaskT, typename = void>
+struct quick_executor
+  {
+    static constexpr
+    AVMC_Queue::Executor*
+    opt()
+      noexcept
+      { return QuickT::do_generic;  }
+  };
+
+template<typename QuickT, typename OpTraitsT>
+struct quick_executor<QuickT, OpTraitsT, tmask_integer,
+    ROCKET_VOID_T(decltype(OpTraitsT::apply_integer))>
+  {
+    static constexpr
+    AVMC_Queue::Executor*
+    opt()
+      noexcept
+      { return QuickT::template do_quick<tmask_integer, OpTraitsT::apply_integer>;  }
+  };
+
+template<typename QuickT, typename OpTraitsT>
+struct quick_executor<QuickT, OpTraitsT, tmask_real,
+    ROCKET_VOID_T(decltype(OpTraitsT::apply_real))>
+  {
+    static constexpr
+    AVMC_Queue::Executor*
+    opt()
+      noexcept
+      { return QuickT::template do_quick<tmask_real, OpTraitsT::apply_real>;  }
+  };
+
+template<typename QuickT, typename OpTraitsT>
+struct quick_executor<QuickT, OpTraitsT, tmask_string,
+    ROCKET_VOID_T(decltype(OpTraitsT::apply_string))>
+  {
+    static constexpr
+    AVMC_Queue::Executor*
+    opt()
+      noexcept
+      { return QuickT::template do_quick<tmask_string, OpTraitsT::apply_string>;  }
+  };
+
+template<typename OpTraitsT, typename OperandsT>
+AIR_Status
+AIR_Quickened_operator<OpTraitsT, OperandsT>::
+do_learn(Executive_Context& ctx, const AVMC_Queue::Header* head)
+  {
+    using quick = AIR_Quickened_operator;
+    OperandsT::push(ctx, head);
+    const auto& rhs = ctx.stack().back().dereference_readonly();
+    ctx.stack().pop_back();
+    auto& lhs = do_get_first_operand(ctx.stack(), head->uparam.p8[0]);  // assign
+
+    // Select a form according to the types of both operands.
+    AVMC_Queue::Executor* exec;
+    switch(do_tmask_of(lhs) | do_tmask_of(rhs)) {
+      case tmask_integer:
+        exec = quick_executor<quick, OpTraitsT, tmask_integer>::opt();
+        break;
+
+      case tmask_real:
+        exec = quick_executor<quick, OpTraitsT, tmask_real>::opt();
+        break;
+
+      case tmask_string:
+        exec = quick_executor<quick, OpTraitsT, tmask_string>::opt();
+        break;
+
+      default:
+        exec = quick::do_generic;
+        break;
+    }
+    AVMC_Queue::replace_executor(head, *exec);
+
+    // This call itself is always performed by the generic form.
+    OpTraitsT::apply(lhs, rhs);
+    return air_status_next;
+  }
+
+// Finally...
+template<typename TraitsT, typename NodeT, typename = void>
+struct symbol_getter
+  {
+    static constexpr
+    const Source_Location*
+    opt(const NodeT&)
+      noexcept
+      { return nullptr;  }
+ };
+
+template<typename TraitsT, typename NodeT>
+struct symbol_getter<TraitsT, NodeT,
+    ROCKET_VOID_T(decltype(
+        TraitsT::get_symbols(
+            ::std::declval<const NodeT&>())))>
+  {
+    static constexpr
+    const Source_Location*
+    opt(const NodeT& altr)
+      noexcept
+      { return ::std::addressof(TraitsT::get_symbols(altr));  }
+  };
+
+template<typename TraitsT, typename NodeT, typename = void>
+struct divert_getter
+  {
+    static constexpr
+    bool
+    opt(const NodeT&)
+      noexcept
+      { return false;  }
+ };
+
+template<typename TraitsT, typename NodeT>
+struct divert_getter<TraitsT, NodeT,
+    ROCKET_VOID_T(decltype(
+        TraitsT::may_divert(
+            ::std::declval<const NodeT&>())))>
+  {
+    static
+    bool
+    opt(const NodeT& altr)
+      { return TraitsT::may_divert(altr);  }
+  };
+
+template<typename TraitsT, typename NodeT, typename = void>
+struct has_uparam
+  : ::std::false_type
+  { };
+
+template<typename TraitsT, typename NodeT>
 struct has_uparam<TraitsT, NodeT,
     ROCKET_VOID_T(decltype(
         TraitsT::make_uparam(::std::declval<bool&>(),
@@ -4568,7 +5385,8 @@ struct solidify_disp<TraitsT, NodeT, true, true>  // uparam, sparam
     void
     append(bool& reachable, AVMC_Queue& queue, const NodeT& altr)
       {
-        queue.append(thunk, symbol_getter<TraitsT, NodeT>::opt(altr),
+        queue.append(thunk, divert_getter<TraitsT, NodeT>::opt(altr),
+            symbol_getter<TraitsT, NodeT>::opt(altr),
             TraitsT::make_uparam(reachable, altr),
             TraitsT::make_sparam(reachable, altr));
       }
@@ -4592,7 +5410,8 @@ struct solidify_disp<TraitsT, NodeT, false, true>  // uparam, sparam
     void
     append(bool& reachable, AVMC_Queue& queue, const NodeT& altr)
       {
-        queue.append(thunk, symbol_getter<TraitsT, NodeT>::opt(altr),
+        queue.append(thunk, divert_getter<TraitsT, NodeT>::opt(altr),
+            symbol_getter<TraitsT, NodeT>::opt(altr),
             TraitsT::make_sparam(reachable, altr));
       }
   };
@@ -4615,7 +5434,8 @@ struct solidify_disp<TraitsT, NodeT, true, false>  // uparam, sparam
     void
     append(bool& reachable, AVMC_Queue& queue, const NodeT& altr)
       {
-        queue.append(thunk, symbol_getter<TraitsT, NodeT>::opt(altr),
+        queue.append(thunk, divert_getter<TraitsT, NodeT>::opt(altr),
+            symbol_getter<TraitsT, NodeT>::opt(altr),
             TraitsT::make_uparam(reachable, altr));
       }
   };
@@ -4635,7 +5455,8 @@ struct solidify_disp<TraitsT, NodeT, false, false>  // uparam, sparam
     void
     append(bool& /*reachable*/, AVMC_Queue& queue, const NodeT& altr)
       {
-        queue.append(thunk, symbol_getter<TraitsT, NodeT>::opt(altr));
+        queue.append(thunk, divert_getter<TraitsT, NodeT>::opt(altr),
+            symbol_getter<TraitsT, NodeT>::opt(altr));
       }
   };
 
@@ -4653,32 +5474,460 @@ do_solidify(AVMC_Queue& queue, const NodeT& altr)
     return reachable;
   }
 
-}  // namespace
-
-opt<AIR_Node>
-AIR_Node::
-rebind_opt(Abstract_Context& ctx)
-  const
+template<template<typename> class FusedT, typename NodeT>
+inline
+bool
+do_solidify_fused(AVMC_Queue& queue, const NodeT& altr)
   {
-    switch(this->index()) {
-      case index_clear_stack:
-        // There is nothing to rebind.
-        return nullopt;
+    switch(altr.xop) {
+      case xop_cmp_eq:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_eq>>(queue, altr);
+
+      case xop_cmp_ne:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_ne>>(queue, altr);
+
+      case xop_cmp_lt:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_lt>>(queue, altr);
+
+      case xop_cmp_gt:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_gt>>(queue, altr);
+
+      case xop_cmp_lte:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_lte>>(queue, altr);
+
+      case xop_cmp_gte:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_gte>>(queue, altr);
+
+      case xop_cmp_3way:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_cmp_3way>>(queue, altr);
+
+      case xop_add:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_add>>(queue, altr);
+
+      case xop_sub:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_sub>>(queue, altr);
+
+      case xop_mul:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_mul>>(queue, altr);
+
+      case xop_div:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_div>>(queue, altr);
+
+      case xop_mod:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_mod>>(queue, altr);
+
+      case xop_sll:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_sll>>(queue, altr);
+
+      case xop_srl:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_srl>>(queue, altr);
+
+      case xop_sla:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_sla>>(queue, altr);
+
+      case xop_sra:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_sra>>(queue, altr);
+
+      case xop_andb:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_andb>>(queue, altr);
+
+      case xop_orb:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_orb>>(queue, altr);
+
+      case xop_xorb:
+        return do_solidify<FusedT<AIR_Traits_apply_operator_xorb>>(queue, altr);
+
+      case xop_inc_post:
+      case xop_dec_post:
+      case xop_subscr:
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_inc_pre:
+      case xop_dec_pre:
+      case xop_unset:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_iround:
+      case xop_ifloor:
+      case xop_iceil:
+      case xop_itrunc:
+      case xop_assign:
+      case xop_fma:
+      case xop_head:
+      case xop_tail:
+      default:
+        ASTERIA_TERMINATE("invalid fused operator type (xop `$1`)", altr.xop);
+    }
+  }
 
-      case index_execute_block: {
-        const auto& altr = this->m_stor.as<index_execute_block>();
+bool
+do_is_fusible_xop(Xop xop)
+  {
+    switch(xop) {
+      case xop_cmp_eq:
+      case xop_cmp_ne:
+      case xop_cmp_lt:
+      case xop_cmp_gt:
+      case xop_cmp_lte:
+      case xop_cmp_gte:
+      case xop_cmp_3way:
+      case xop_add:
+      case xop_sub:
+      case xop_mul:
+      case xop_div:
+      case xop_mod:
+      case xop_sll:
+      case xop_srl:
+      case xop_sla:
+      case xop_sra:
+      case xop_andb:
+      case xop_orb:
+      case xop_xorb:
+        return true;
+
+      case xop_inc_post:
+      case xop_dec_post:
+      case xop_subscr:
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_inc_pre:
+      case xop_dec_pre:
+      case xop_unset:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_iround:
+      case xop_ifloor:
+      case xop_iceil:
+      case xop_itrunc:
+      case xop_assign:
+      case xop_fma:
+      case xop_head:
+      case xop_tail:
+        return false;
 
-        // Rebind the body.
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
-        bool dirty = false;
-        auto bound = altr;
+      default:
+        ASTERIA_TERMINATE("invalid operator type (xop `$1`)", xop);
+    }
+  }
 
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+template<typename OpTraitsT>
+inline
+bool
+do_solidify_quickened(AVMC_Queue& queue, const AIR_Node::S_apply_operator& altr)
+  {
+    using quick = AIR_Quickened_operator<OpTraitsT, Quick_operands_on_stack>;
 
-        return do_rebind_return_opt(dirty, ::std::move(bound));
-      }
+    bool reachable = true;
+    queue.append(quick::do_learn, false, ::std::addressof(OpTraitsT::get_symbols(altr)),
+                 OpTraitsT::make_uparam(reachable, altr));
+    return reachable;
+  }
 
-      case index_declare_variable:
+template<typename OpTraitsT>
+inline
+bool
+do_solidify_quickened(AVMC_Queue& queue, const AIR_Node::S_fused_apply_operator& altr)
+  {
+    using fused = AIR_Traits_fused_apply_operator<OpTraitsT>;
+    using quick = AIR_Quickened_operator<OpTraitsT, Quick_operands_fused>;
+
+    bool reachable = true;
+    queue.append(quick::do_learn, false, ::std::addressof(fused::get_symbols(altr)),
+                 fused::make_uparam(reachable, altr), fused::make_sparam(reachable, altr));
+    return reachable;
+  }
+
+inline
+bool
+do_solidify_fused_apply_operator(AVMC_Queue& queue, const AIR_Node::S_fused_apply_operator& altr)
+  {
+    switch(altr.xop) {
+      case xop_cmp_eq:
+        return do_solidify_quickened<AIR_Traits_apply_operator_cmp_eq>(queue, altr);
+
+      case xop_cmp_ne:
+        return do_solidify_quickened<AIR_Traits_apply_operator_cmp_ne>(queue, altr);
+
+      case xop_cmp_lt:
+        return do_solidify_quickened<AIR_Traits_apply_operator_cmp_lt>(queue, altr);
+
+      case xop_cmp_gt:
+        return do_solidify_quickened<AIR_Traits_apply_operator_cmp_gt>(queue, altr);
+
+      case xop_cmp_lte:
+        return do_solidify_quickened<AIR_Traits_apply_operator_cmp_lte>(queue, altr);
+
+      case xop_cmp_gte:
+        return do_solidify_quickened<AIR_Traits_apply_operator_cmp_gte>(queue, altr);
+
+      case xop_add:
+        return do_solidify_quickened<AIR_Traits_apply_operator_add>(queue, altr);
+
+      case xop_sub:
+        return do_solidify_quickened<AIR_Traits_apply_operator_sub>(queue, altr);
+
+      case xop_mul:
+        return do_solidify_quickened<AIR_Traits_apply_operator_mul>(queue, altr);
+
+      case xop_inc_post:
+      case xop_dec_post:
+      case xop_subscr:
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_inc_pre:
+      case xop_dec_pre:
+      case xop_unset:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_iround:
+      case xop_ifloor:
+      case xop_iceil:
+      case xop_itrunc:
+      case xop_cmp_3way:
+      case xop_div:
+      case xop_mod:
+      case xop_sll:
+      case xop_srl:
+      case xop_sla:
+      case xop_sra:
+      case xop_andb:
+      case xop_orb:
+      case xop_xorb:
+      case xop_assign:
+      case xop_fma:
+      case xop_head:
+      case xop_tail:
+        return do_solidify_fused<AIR_Traits_fused_apply_operator>(queue, altr);
+
+      default:
+        ASTERIA_TERMINATE("invalid operator type (xop `$1`)", altr.xop);
+    }
+  }
+
+void
+do_put_operand(AIR_Bytecode_Writer& sw, const AIR_Node::Fused_Operand& opnd)
+  {
+    sw.put_string(opnd.name.rdstr());
+    if(opnd.name.empty()) {
+      sw.put_reference(opnd.ref);
+      return;
+    }
+    sw.put_uint(opnd.depth);
+    sw.put_uint(opnd.slot);
+  }
+
+AIR_Node::Fused_Operand
+do_get_operand(AIR_Bytecode_Reader& sr)
+  {
+    AIR_Node::Fused_Operand opnd;
+    opnd.name = sr.get_string();
+    if(opnd.name.empty()) {
+      opnd.depth = 0;
+      opnd.slot = 0;
+      opnd.ref = sr.get_reference();
+      return opnd;
+    }
+    opnd.depth = sr.get_depth();
+    opnd.slot = sr.get_uint32();
+    return opnd;
+  }
+
+template<typename XEnumT>
+XEnumT
+do_get_enum(AIR_Bytecode_Reader& sr, XEnumT max)
+  {
+    uint64_t val = sr.get_uint();
+    if(val > static_cast<uint64_t>(max))
+      ASTERIA_THROW("Invalid enumeration in bytecode (value `$1`)", val);
+    return static_cast<XEnumT>(val);
+  }
+
+Xop
+do_get_fused_xop(AIR_Bytecode_Reader& sr)
+  {
+    auto xop = do_get_enum(sr, xop_tail);
+    if(!do_is_fusible_xop(xop))
+      ASTERIA_THROW("Invalid fused operator in bytecode (xop `$1`)", xop);
+    return xop;
+  }
+
+PTC_Aware
+do_get_ptc_aware(AIR_Bytecode_Reader& sr)
+  {
+    int64_t val = sr.get_int();
+    switch(val) {
+      case ptc_aware_none:
+      case ptc_aware_void:
+      case ptc_aware_by_ref:
+      case ptc_aware_by_val:
+        return static_cast<PTC_Aware>(val);
+
+      default:
+        ASTERIA_THROW("Invalid PTC awareness in bytecode (value `$1`)", val);
+    }
+  }
+
+uint32_t
+do_get_xop_arity(Xop xop)
+  {
+    switch(xop) {
+      case xop_inc_post:
+      case xop_dec_post:
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_inc_pre:
+      case xop_dec_pre:
+      case xop_unset:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_iround:
+      case xop_ifloor:
+      case xop_iceil:
+      case xop_itrunc:
+      case xop_head:
+      case xop_tail:
+        return 1;
+
+      case xop_subscr:
+      case xop_cmp_eq:
+      case xop_cmp_ne:
+      case xop_cmp_lt:
+      case xop_cmp_gt:
+      case xop_cmp_lte:
+      case xop_cmp_gte:
+      case xop_cmp_3way:
+      case xop_add:
+      case xop_sub:
+      case xop_mul:
+      case xop_div:
+      case xop_mod:
+      case xop_sll:
+      case xop_srl:
+      case xop_sla:
+      case xop_sra:
+      case xop_andb:
+      case xop_orb:
+      case xop_xorb:
+      case xop_assign:
+        return 2;
+
+      case xop_fma:
+        return 3;
+
+      default:
+        ASTERIA_TERMINATE("invalid operator type (xop `$1`)", xop);
+    }
+  }
+
+// These are used to verify bytecode. `stack` describes references that are
+// known to exist on the top of the stack. An element is `true` if it is a
+// variable that has been declared but not initialized.
+void
+do_verify_pop(cow_vector<bool>& stack, size_t count)
+  {
+    if(stack.size() < count)
+      ASTERIA_THROW("Stack underflow in bytecode (popping `$1` of `$2`)",
+                    count, stack.size());
+    stack.pop_back(count);
+  }
+
+void
+do_verify_pop_declared(cow_vector<bool>& stack, size_t count)
+  {
+    for(size_t k = 0;  k != count;  ++k)
+      if((k < stack.size()) && !stack[stack.size() - 1 - k])
+        ASTERIA_THROW("Uninitialized variable expected in bytecode");
+    do_verify_pop(stack, count);
+  }
+
+void
+do_verify_replace_top(cow_vector<bool>& stack)
+  {
+    do_verify_pop(stack, 1);
+    stack.emplace_back(false);
+  }
+
+void
+do_verify_merge(cow_vector<bool>& stack, const cow_vector<bool>& other)
+  {
+    // Only references that exist on both paths are known to exist. A variable
+    // is known to be declared only if it is declared on both.
+    size_t nkept = ::rocket::min(stack.size(), other.size());
+    stack.erase(0, stack.size() - nkept);
+    for(size_t k = 0;  k != nkept;  ++k)
+      stack.mut(k) = stack[k] && other[other.size() - nkept + k];
+  }
+
+}  // namespace
+
+opt<AIR_Node>
+AIR_Node::
+rebind_opt(Abstract_Context& ctx)
+  const
+  {
+    switch(this->index()) {
+      case index_clear_stack:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<index_execute_block>();
+
+        // Rebind the body.
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        return do_rebind_return_opt(dirty, ::std::move(bound));
+      }
+
+      case index_declare_variable:
       case index_initialize_variable:
         // There is nothing to rebind.
         return nullopt;
@@ -4798,16 +6047,19 @@ rebind_opt(Abstract_Context& ctx)
 
         // Get the context.
         // Don't bind references in analytic contexts.
+        // See `do_rebind_operand()` for references that go beyond the outermost
+        // context.
         Abstract_Context* qctx = &ctx;
         for(uint32_t k = 0;  k != altr.depth;  ++k) {
           qctx = qctx->get_parent_opt();
-          ROCKET_ASSERT(qctx);
+          if(!qctx)
+            return nullopt;
         }
         if(qctx->is_analytic())
           return nullopt;
 
         // Look for the name in the context.
-        auto qref = qctx->get_named_reference_opt(altr.name);
+        auto qref = qctx->get_named_reference_opt(altr.slot, altr.name);
         if(!qref)
           return nullopt;
 
@@ -4890,6 +6142,50 @@ rebind_opt(Abstract_Context& ctx)
         // There is nothing to rebind.
         return nullopt;
 
+      case index_fused_apply_operator: {
+        const auto& altr = this->m_stor.as<index_fused_apply_operator>();
+
+        // Rebind the operands.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_operand(dirty, bound.lhs, ctx);
+        do_rebind_operand(dirty, bound.rhs, ctx);
+
+        return do_rebind_return_opt(dirty, ::std::move(bound));
+      }
+
+      case index_fused_if_statement: {
+        const auto& altr = this->m_stor.as<index_fused_if_statement>();
+
+        // Rebind the operands and both branches.
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_operand(dirty, bound.lhs, ctx);  // this is not part of the body!
+        do_rebind_operand(dirty, bound.rhs, ctx);  // this is not part of the body!
+        do_rebind_nodes(dirty, bound.code_true, ctx_body);
+        do_rebind_nodes(dirty, bound.code_false, ctx_body);
+
+        return do_rebind_return_opt(dirty, ::std::move(bound));
+      }
+
+      case index_fused_while_statement: {
+        const auto& altr = this->m_stor.as<index_fused_while_statement>();
+
+        // Rebind the operands and the body.
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_operand(dirty, bound.lhs, ctx);  // this is not part of the body!
+        do_rebind_operand(dirty, bound.rhs, ctx);  // this is not part of the body!
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        return do_rebind_return_opt(dirty, ::std::move(bound));
+      }
+
       default:
         ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
     }
@@ -4989,209 +6285,1475 @@ solidify(AVMC_Queue& queue)
         return do_solidify<AIR_Traits_function_call>(queue,
                                      this->m_stor.as<index_function_call>());
 
-      case index_member_access:
-        return do_solidify<AIR_Traits_member_access>(queue,
-                                     this->m_stor.as<index_member_access>());
+      case index_member_access:
+        return do_solidify<AIR_Traits_member_access>(queue,
+                                     this->m_stor.as<index_member_access>());
+
+      case index_push_unnamed_array:
+        return do_solidify<AIR_Traits_push_unnamed_array>(queue,
+                                     this->m_stor.as<index_push_unnamed_array>());
+
+      case index_push_unnamed_object:
+        return do_solidify<AIR_Traits_push_unnamed_object>(queue,
+                                     this->m_stor.as<index_push_unnamed_object>());
+
+      case index_apply_operator: {
+        const auto& altr = this->m_stor.as<index_apply_operator>();
+        switch(altr.xop) {
+          case xop_inc_post:
+            return do_solidify<AIR_Traits_apply_operator_inc_post>(queue, altr);
+
+          case xop_dec_post:
+            return do_solidify<AIR_Traits_apply_operator_dec_post>(queue, altr);
+
+          case xop_subscr:
+            return do_solidify<AIR_Traits_apply_operator_subscr>(queue, altr);
+
+          case xop_pos:
+            return do_solidify<AIR_Traits_apply_operator_pos>(queue, altr);
+
+          case xop_neg:
+            return do_solidify<AIR_Traits_apply_operator_neg>(queue, altr);
+
+          case xop_notb:
+            return do_solidify<AIR_Traits_apply_operator_notb>(queue, altr);
+
+          case xop_notl:
+            return do_solidify<AIR_Traits_apply_operator_notl>(queue, altr);
+
+          case xop_inc_pre:
+            return do_solidify<AIR_Traits_apply_operator_inc_pre>(queue, altr);
+
+          case xop_dec_pre:
+            return do_solidify<AIR_Traits_apply_operator_dec_pre>(queue, altr);
+
+          case xop_unset:
+            return do_solidify<AIR_Traits_apply_operator_unset>(queue, altr);
+
+          case xop_countof:
+            return do_solidify<AIR_Traits_apply_operator_countof>(queue, altr);
+
+          case xop_typeof:
+            return do_solidify<AIR_Traits_apply_operator_typeof>(queue, altr);
+
+          case xop_sqrt:
+            return do_solidify<AIR_Traits_apply_operator_sqrt>(queue, altr);
+
+          case xop_isnan:
+            return do_solidify<AIR_Traits_apply_operator_isnan>(queue, altr);
+
+          case xop_isinf:
+            return do_solidify<AIR_Traits_apply_operator_isinf>(queue, altr);
+
+          case xop_abs:
+            return do_solidify<AIR_Traits_apply_operator_abs>(queue, altr);
+
+          case xop_sign:
+            return do_solidify<AIR_Traits_apply_operator_sign>(queue, altr);
+
+          case xop_round:
+            return do_solidify<AIR_Traits_apply_operator_round>(queue, altr);
+
+          case xop_floor:
+            return do_solidify<AIR_Traits_apply_operator_floor>(queue, altr);
+
+          case xop_ceil:
+            return do_solidify<AIR_Traits_apply_operator_ceil>(queue, altr);
+
+          case xop_trunc:
+            return do_solidify<AIR_Traits_apply_operator_trunc>(queue, altr);
+
+          case xop_iround:
+            return do_solidify<AIR_Traits_apply_operator_iround>(queue, altr);
+
+          case xop_ifloor:
+            return do_solidify<AIR_Traits_apply_operator_ifloor>(queue, altr);
+
+          case xop_iceil:
+            return do_solidify<AIR_Traits_apply_operator_iceil>(queue, altr);
+
+          case xop_itrunc:
+            return do_solidify<AIR_Traits_apply_operator_itrunc>(queue, altr);
+
+          case xop_cmp_eq:
+            return do_solidify_quickened<AIR_Traits_apply_operator_cmp_eq>(queue, altr);
+
+          case xop_cmp_ne:
+            return do_solidify_quickened<AIR_Traits_apply_operator_cmp_ne>(queue, altr);
+
+          case xop_cmp_lt:
+            return do_solidify_quickened<AIR_Traits_apply_operator_cmp_lt>(queue, altr);
+
+          case xop_cmp_gt:
+            return do_solidify_quickened<AIR_Traits_apply_operator_cmp_gt>(queue, altr);
+
+          case xop_cmp_lte:
+            return do_solidify_quickened<AIR_Traits_apply_operator_cmp_lte>(queue, altr);
+
+          case xop_cmp_gte:
+            return do_solidify_quickened<AIR_Traits_apply_operator_cmp_gte>(queue, altr);
+
+          case xop_cmp_3way:
+            return do_solidify<AIR_Traits_apply_operator_cmp_3way>(queue, altr);
+
+          case xop_add:
+            return do_solidify_quickened<AIR_Traits_apply_operator_add>(queue, altr);
+
+          case xop_sub:
+            return do_solidify_quickened<AIR_Traits_apply_operator_sub>(queue, altr);
+
+          case xop_mul:
+            return do_solidify_quickened<AIR_Traits_apply_operator_mul>(queue, altr);
+
+          case xop_div:
+            return do_solidify<AIR_Traits_apply_operator_div>(queue, altr);
+
+          case xop_mod:
+            return do_solidify<AIR_Traits_apply_operator_mod>(queue, altr);
+
+          case xop_sll:
+            return do_solidify<AIR_Traits_apply_operator_sll>(queue, altr);
+
+          case xop_srl:
+            return do_solidify<AIR_Traits_apply_operator_srl>(queue, altr);
+
+          case xop_sla:
+            return do_solidify<AIR_Traits_apply_operator_sla>(queue, altr);
+
+          case xop_sra:
+            return do_solidify<AIR_Traits_apply_operator_sra>(queue, altr);
+
+          case xop_andb:
+            return do_solidify<AIR_Traits_apply_operator_andb>(queue, altr);
+
+          case xop_orb:
+            return do_solidify<AIR_Traits_apply_operator_orb>(queue, altr);
+
+          case xop_xorb:
+            return do_solidify<AIR_Traits_apply_operator_xorb>(queue, altr);
+
+          case xop_assign:
+            return do_solidify<AIR_Traits_apply_operator_assign>(queue, altr);
+
+          case xop_fma:
+            return do_solidify<AIR_Traits_apply_operator_fma>(queue, altr);
+
+          case xop_head:
+            return do_solidify<AIR_Traits_apply_operator_head>(queue, altr);
+
+          case xop_tail:
+            return do_solidify<AIR_Traits_apply_operator_tail>(queue, altr);
+
+          default:
+            ASTERIA_TERMINATE("invalid operator type (xop `$1`)", altr.xop);
+        }
+      }
+
+      case index_unpack_struct_array:
+        return do_solidify<AIR_Traits_unpack_struct_array>(queue,
+                                     this->m_stor.as<index_unpack_struct_array>());
+
+      case index_unpack_struct_object:
+        return do_solidify<AIR_Traits_unpack_struct_object>(queue,
+                                     this->m_stor.as<index_unpack_struct_object>());
+
+      case index_define_null_variable:
+        return do_solidify<AIR_Traits_define_null_variable>(queue,
+                                     this->m_stor.as<index_define_null_variable>());
+
+      case index_single_step_trap:
+        return do_solidify<AIR_Traits_single_step_trap>(queue,
+                                     this->m_stor.as<index_single_step_trap>());
+
+      case index_variadic_call:
+        return do_solidify<AIR_Traits_variadic_call>(queue,
+                                     this->m_stor.as<index_variadic_call>());
+
+      case index_defer_expression:
+        return do_solidify<AIR_Traits_defer_expression>(queue,
+                                     this->m_stor.as<index_defer_expression>());
+
+      case index_import_call:
+        return do_solidify<AIR_Traits_import_call>(queue,
+                                     this->m_stor.as<index_import_call>());
+
+      case index_declare_reference:
+        return do_solidify<AIR_Traits_declare_reference>(queue,
+                                     this->m_stor.as<index_declare_reference>());
+
+      case index_initialize_reference:
+        return do_solidify<AIR_Traits_initialize_reference>(queue,
+                                     this->m_stor.as<index_initialize_reference>());
+
+      case index_fused_apply_operator:
+        return do_solidify_fused_apply_operator(queue,
+                                     this->m_stor.as<index_fused_apply_operator>());
+
+      case index_fused_if_statement:
+        return do_solidify_fused<AIR_Traits_fused_if_statement>(queue,
+                                     this->m_stor.as<index_fused_if_statement>());
+
+      case index_fused_while_statement:
+        return do_solidify_fused<AIR_Traits_fused_while_statement>(queue,
+                                     this->m_stor.as<index_fused_while_statement>());
+
+      default:
+        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+    }
+  }
+
+bool
+AIR_Node::
+fold_constant(cow_vector<AIR_Node>& code)
+  const
+  {
+    if(this->index() != index_apply_operator)
+      return false;
+
+    const auto& altr = this->m_stor.as<index_apply_operator>();
+    if(altr.assign)
+      return false;
+
+    // Get the number of operands.
+    // Operators that modify their operands are never folded.
+    size_t nops;
+    switch(altr.xop) {
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_iround:
+      case xop_ifloor:
+      case xop_iceil:
+      case xop_itrunc:
+        nops = 1;
+        break;
+
+      case xop_cmp_eq:
+      case xop_cmp_ne:
+      case xop_cmp_lt:
+      case xop_cmp_gt:
+      case xop_cmp_lte:
+      case xop_cmp_gte:
+      case xop_cmp_3way:
+      case xop_add:
+      case xop_sub:
+      case xop_mul:
+      case xop_div:
+      case xop_mod:
+      case xop_sll:
+      case xop_srl:
+      case xop_sla:
+      case xop_sra:
+      case xop_andb:
+      case xop_orb:
+      case xop_xorb:
+        nops = 2;
+        break;
+
+      case xop_fma:
+        nops = 3;
+        break;
+
+      case xop_inc_post:
+      case xop_dec_post:
+      case xop_subscr:
+      case xop_inc_pre:
+      case xop_dec_pre:
+      case xop_unset:
+      case xop_assign:
+      case xop_head:
+      case xop_tail:
+        return false;
+
+      default:
+        ASTERIA_TERMINATE("invalid operator type (xop `$1`)", altr.xop);
+    }
+
+    // All operands shall be constants.
+    if(code.size() < nops)
+      return false;
+
+    size_t bpos = code.size() - nops;
+    for(size_t k = bpos;  k != code.size();  ++k)
+      if(!code[k].get_constant_opt())
+        return false;
+
+    // Evaluate the operator in a constant context.
+    // If an exception is thrown, the operator will be evaluated at run time,
+    // where the exception can be handled by user code.
+    Reference_Stack stack;
+    Reference_Stack alt_stack;
+    for(size_t k = bpos;  k != code.size();  ++k)
+      stack.emplace_back_uninit().set_temporary(*(code[k].get_constant_opt()));
+
+    AVMC_Queue queue;
+    this->solidify(queue);
+
+    try {
+      Executive_Context ctx(Executive_Context::M_constant(), stack, alt_stack);
+      auto status = queue.execute(ctx);
+      if((status != air_status_next) || (stack.size() != 1))
+        return false;
+    }
+    catch(::std::exception& /*stdex*/) {
+      return false;
+    }
+
+    // Replace operands with the result.
+    S_push_bound_reference xnode;
+    xnode.ref.set_temporary(stack.back().dereference_readonly());
+    code.erase(bpos, nops);
+    code.emplace_back(::std::move(xnode));
+    return true;
+  }
+
+const Value*
+AIR_Node::
+get_constant_opt()
+  const noexcept
+  {
+    if(this->index() != index_push_bound_reference)
+      return nullptr;
+
+    const auto& ref = this->m_stor.as<index_push_bound_reference>().ref;
+    if(!ref.is_temporary() || ref.count_modifiers())
+      return nullptr;
+
+    return &(ref.dereference_readonly());
+  }
+
+bool
+AIR_Node::
+fuse_nodes(cow_vector<AIR_Node>& code)
+  {
+    bool dirty = false;
+
+    // Process nested blocks first.
+    const auto fuse_nested = [&](cow_vector<cow_vector<AIR_Node>>& seqs)
+      {
+        bool fused = false;
+        for(size_t k = 0;  k < seqs.size();  ++k) {
+          auto seq = seqs[k];
+          if(!fuse_nodes(seq))
+            continue;
+
+          seqs.mut(k) = ::std::move(seq);
+          fused = true;
+        }
+        return fused;
+      };
+
+    for(size_t i = 0;  i < code.size();  ++i)
+      switch(code[i].index()) {
+        case index_execute_block: {
+          auto altr = code[i].m_stor.as<index_execute_block>();
+          if(fuse_nodes(altr.code_body))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_if_statement: {
+          auto altr = code[i].m_stor.as<index_if_statement>();
+          if(fuse_nodes(altr.code_true) | fuse_nodes(altr.code_false))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_switch_statement: {
+          auto altr = code[i].m_stor.as<index_switch_statement>();
+          if(fuse_nested(altr.code_labels) | fuse_nested(altr.code_bodies))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_do_while_statement: {
+          auto altr = code[i].m_stor.as<index_do_while_statement>();
+          if(fuse_nodes(altr.code_body) | fuse_nodes(altr.code_cond))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_while_statement: {
+          auto altr = code[i].m_stor.as<index_while_statement>();
+          if(!(fuse_nodes(altr.code_cond) | fuse_nodes(altr.code_body)))
+            break;
+
+          // If the condition consists of a single comparison, fuse it into the
+          // loop, so it can be evaluated without a nested queue.
+          if((altr.code_cond.size() == 2)
+             && (altr.code_cond[0].index() == index_clear_stack)
+             && (altr.code_cond[1].index() == index_fused_apply_operator)
+             && !altr.code_cond[1].m_stor.as<index_fused_apply_operator>().assign) {
+            const auto& xcond = altr.code_cond[1].m_stor.as<index_fused_apply_operator>();
+            S_fused_while_statement xnode = { xcond.sloc, xcond.xop, xcond.lhs, xcond.rhs,
+                                              altr.negative, ::std::move(altr.code_body) };
+            code.mut(i) = ::std::move(xnode);
+          }
+          else
+            code.mut(i) = ::std::move(altr);
+          dirty = true;
+          break;
+        }
+
+        case index_for_each_statement: {
+          auto altr = code[i].m_stor.as<index_for_each_statement>();
+          if(fuse_nodes(altr.code_init) | fuse_nodes(altr.code_body))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_for_statement: {
+          auto altr = code[i].m_stor.as<index_for_statement>();
+          if(fuse_nodes(altr.code_init) | fuse_nodes(altr.code_cond) |
+             fuse_nodes(altr.code_step) | fuse_nodes(altr.code_body))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_try_statement: {
+          auto altr = code[i].m_stor.as<index_try_statement>();
+          if(fuse_nodes(altr.code_try) | fuse_nodes(altr.code_catch))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_branch_expression: {
+          auto altr = code[i].m_stor.as<index_branch_expression>();
+          if(fuse_nodes(altr.code_true) | fuse_nodes(altr.code_false))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_coalescence: {
+          auto altr = code[i].m_stor.as<index_coalescence>();
+          if(fuse_nodes(altr.code_null))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_defer_expression: {
+          auto altr = code[i].m_stor.as<index_defer_expression>();
+          if(fuse_nodes(altr.code_body))
+            code.mut(i) = ::std::move(altr), dirty = true;
+          break;
+        }
+
+        case index_clear_stack:
+        case index_declare_variable:
+        case index_initialize_variable:
+        case index_throw_statement:
+        case index_assert_statement:
+        case index_simple_status:
+        case index_convert_to_temporary:
+        case index_push_global_reference:
+        case index_push_local_reference:
+        case index_push_bound_reference:
+        case index_define_function:
+        case index_function_call:
+        case index_member_access:
+        case index_push_unnamed_array:
+        case index_push_unnamed_object:
+        case index_apply_operator:
+        case index_unpack_struct_array:
+        case index_unpack_struct_object:
+        case index_define_null_variable:
+        case index_single_step_trap:
+        case index_variadic_call:
+        case index_import_call:
+        case index_declare_reference:
+        case index_initialize_reference:
+        case index_fused_apply_operator:
+        case index_fused_if_statement:
+        case index_fused_while_statement:
+          // Bodies of closures have been processed by their own optimizers.
+          break;
+
+        default:
+          ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", code[i].index());
+      }
+
+    // Fuse binary operators with operands that are pushed immediately before
+    // them. As the operator pops exactly two operands, this is always safe.
+    const auto make_operand = [&](const AIR_Node& node)
+      {
+        Fused_Operand opnd = { };
+        if(node.index() == index_push_local_reference) {
+          const auto& altr = node.m_stor.as<index_push_local_reference>();
+          opnd.depth = altr.depth;
+          opnd.slot = altr.slot;
+          opnd.name = altr.name;
+        }
+        else
+          opnd.ref = node.m_stor.as<index_push_bound_reference>().ref;
+        return opnd;
+      };
+
+    const auto is_operand = [&](const AIR_Node& node)
+      {
+        return ::rocket::is_any_of(node.index(), { index_push_local_reference,
+                                                   index_push_bound_reference });
+      };
+
+    for(size_t i = 0;  i + 2 < code.size();  ++i) {
+      if(!is_operand(code[i]) || !is_operand(code[i+1]))
+        continue;
+
+      if(code[i+2].index() != index_apply_operator)
+        continue;
+
+      const auto& altr = code[i+2].m_stor.as<index_apply_operator>();
+      if(!do_is_fusible_xop(altr.xop))
+        continue;
+
+      S_fused_apply_operator xnode = { altr.sloc, altr.xop, altr.assign,
+                                       make_operand(code[i]), make_operand(code[i+1]) };
+
+      // If the result is tested by an `if` statement, fuse them, too.
+      size_t nfused = 3;
+      if(!xnode.assign && (i + 3 < code.size()) &&
+         (code[i+3].index() == index_if_statement)) {
+        const auto& xif = code[i+3].m_stor.as<index_if_statement>();
+        S_fused_if_statement xcond = { xnode.sloc, xnode.xop,
+                                       ::std::move(xnode.lhs), ::std::move(xnode.rhs),
+                                       xif.negative, xif.code_true, xif.code_false };
+        code.mut(i) = ::std::move(xcond);
+        nfused = 4;
+      }
+      else
+        code.mut(i) = ::std::move(xnode);
+
+      code.erase(i + 1, nfused - 1);
+      dirty = true;
+    }
+    return dirty;
+  }
+
+void
+AIR_Node::
+serialize(AIR_Bytecode_Writer& sw)
+  const
+  {
+    sw.put_uint(this->index());
+    switch(this->index()) {
+      case index_clear_stack:
+        return;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<index_execute_block>();
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      case index_declare_variable: {
+        const auto& altr = this->m_stor.as<index_declare_variable>();
+        sw.put_sloc(altr.sloc);
+        sw.put_string(altr.name.rdstr());
+        sw.put_uint(altr.escaping);
+        return;
+      }
+
+      case index_initialize_variable: {
+        const auto& altr = this->m_stor.as<index_initialize_variable>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.immutable);
+        return;
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<index_if_statement>();
+        sw.put_uint(altr.negative);
+        sw.put_code(altr.code_true);
+        sw.put_code(altr.code_false);
+        return;
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<index_switch_statement>();
+        sw.put_uint(altr.code_labels.size());
+        for(size_t i = 0;  i < altr.code_labels.size();  ++i) {
+          sw.put_code(altr.code_labels.at(i));
+          sw.put_code(altr.code_bodies.at(i));
+          sw.put_strings(altr.names_added.at(i));
+        }
+        return;
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<index_do_while_statement>();
+        sw.put_code(altr.code_body);
+        sw.put_uint(altr.negative);
+        sw.put_code(altr.code_cond);
+        return;
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<index_while_statement>();
+        sw.put_uint(altr.negative);
+        sw.put_code(altr.code_cond);
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<index_for_each_statement>();
+        sw.put_string(altr.name_key.rdstr());
+        sw.put_string(altr.name_mapped.rdstr());
+        sw.put_code(altr.code_init);
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<index_for_statement>();
+        sw.put_code(altr.code_init);
+        sw.put_code(altr.code_cond);
+        sw.put_code(altr.code_step);
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<index_try_statement>();
+        sw.put_sloc(altr.sloc_try);
+        sw.put_code(altr.code_try);
+        sw.put_sloc(altr.sloc_catch);
+        sw.put_string(altr.name_except.rdstr());
+        sw.put_code(altr.code_catch);
+        return;
+      }
+
+      case index_throw_statement: {
+        const auto& altr = this->m_stor.as<index_throw_statement>();
+        sw.put_sloc(altr.sloc);
+        return;
+      }
+
+      case index_assert_statement: {
+        const auto& altr = this->m_stor.as<index_assert_statement>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.negative);
+        sw.put_string(altr.msg);
+        return;
+      }
+
+      case index_simple_status: {
+        const auto& altr = this->m_stor.as<index_simple_status>();
+        sw.put_uint(altr.status);
+        return;
+      }
+
+      case index_convert_to_temporary: {
+        const auto& altr = this->m_stor.as<index_convert_to_temporary>();
+        sw.put_sloc(altr.sloc);
+        return;
+      }
+
+      case index_push_global_reference: {
+        const auto& altr = this->m_stor.as<index_push_global_reference>();
+        sw.put_sloc(altr.sloc);
+        sw.put_string(altr.name.rdstr());
+        return;
+      }
+
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<index_push_local_reference>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.depth);
+        sw.put_uint(altr.slot);
+        sw.put_string(altr.name.rdstr());
+        return;
+      }
+
+      case index_push_bound_reference: {
+        const auto& altr = this->m_stor.as<index_push_bound_reference>();
+        sw.put_reference(altr.ref);
+        return;
+      }
+
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<index_define_function>();
+        sw.put_options(altr.opts);
+        sw.put_sloc(altr.sloc);
+        sw.put_string(altr.func);
+        sw.put_strings(altr.params);
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<index_branch_expression>();
+        sw.put_sloc(altr.sloc);
+        sw.put_code(altr.code_true);
+        sw.put_code(altr.code_false);
+        sw.put_uint(altr.assign);
+        return;
+      }
+
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+        sw.put_sloc(altr.sloc);
+        sw.put_code(altr.code_null);
+        sw.put_uint(altr.assign);
+        return;
+      }
+
+      case index_function_call: {
+        const auto& altr = this->m_stor.as<index_function_call>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.nargs);
+        sw.put_int(altr.ptc);
+        return;
+      }
+
+      case index_member_access: {
+        const auto& altr = this->m_stor.as<index_member_access>();
+        sw.put_sloc(altr.sloc);
+        sw.put_string(altr.name.rdstr());
+        return;
+      }
+
+      case index_push_unnamed_array: {
+        const auto& altr = this->m_stor.as<index_push_unnamed_array>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.nelems);
+        return;
+      }
+
+      case index_push_unnamed_object: {
+        const auto& altr = this->m_stor.as<index_push_unnamed_object>();
+        sw.put_sloc(altr.sloc);
+        sw.put_strings(altr.keys);
+        return;
+      }
+
+      case index_apply_operator: {
+        const auto& altr = this->m_stor.as<index_apply_operator>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.xop);
+        sw.put_uint(altr.assign);
+        return;
+      }
+
+      case index_unpack_struct_array: {
+        const auto& altr = this->m_stor.as<index_unpack_struct_array>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.immutable);
+        sw.put_uint(altr.nelems);
+        return;
+      }
+
+      case index_unpack_struct_object: {
+        const auto& altr = this->m_stor.as<index_unpack_struct_object>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.immutable);
+        sw.put_strings(altr.keys);
+        return;
+      }
+
+      case index_define_null_variable: {
+        const auto& altr = this->m_stor.as<index_define_null_variable>();
+        sw.put_uint(altr.immutable);
+        sw.put_sloc(altr.sloc);
+        sw.put_string(altr.name.rdstr());
+        sw.put_uint(altr.escaping);
+        return;
+      }
+
+      case index_single_step_trap: {
+        const auto& altr = this->m_stor.as<index_single_step_trap>();
+        sw.put_sloc(altr.sloc);
+        return;
+      }
+
+      case index_variadic_call: {
+        const auto& altr = this->m_stor.as<index_variadic_call>();
+        sw.put_sloc(altr.sloc);
+        sw.put_int(altr.ptc);
+        return;
+      }
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<index_defer_expression>();
+        sw.put_sloc(altr.sloc);
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      case index_import_call: {
+        const auto& altr = this->m_stor.as<index_import_call>();
+        sw.put_options(altr.opts);
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.nargs);
+        return;
+      }
+
+      case index_declare_reference: {
+        const auto& altr = this->m_stor.as<index_declare_reference>();
+        sw.put_string(altr.name.rdstr());
+        return;
+      }
+
+      case index_initialize_reference: {
+        const auto& altr = this->m_stor.as<index_initialize_reference>();
+        sw.put_sloc(altr.sloc);
+        sw.put_string(altr.name.rdstr());
+        return;
+      }
+
+      case index_fused_apply_operator: {
+        const auto& altr = this->m_stor.as<index_fused_apply_operator>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.xop);
+        sw.put_uint(altr.assign);
+        do_put_operand(sw, altr.lhs);
+        do_put_operand(sw, altr.rhs);
+        return;
+      }
+
+      case index_fused_if_statement: {
+        const auto& altr = this->m_stor.as<index_fused_if_statement>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.xop);
+        do_put_operand(sw, altr.lhs);
+        do_put_operand(sw, altr.rhs);
+        sw.put_uint(altr.negative);
+        sw.put_code(altr.code_true);
+        sw.put_code(altr.code_false);
+        return;
+      }
+
+      case index_fused_while_statement: {
+        const auto& altr = this->m_stor.as<index_fused_while_statement>();
+        sw.put_sloc(altr.sloc);
+        sw.put_uint(altr.xop);
+        do_put_operand(sw, altr.lhs);
+        do_put_operand(sw, altr.rhs);
+        sw.put_uint(altr.negative);
+        sw.put_code(altr.code_body);
+        return;
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+    }
+  }
+
+AIR_Node
+AIR_Node::
+deserialize(AIR_Bytecode_Reader& sr)
+  {
+    uint64_t index = sr.get_uint();
+    switch(index) {
+      case index_clear_stack:
+        return S_clear_stack();
+
+      case index_execute_block: {
+        S_execute_block xnode;
+        xnode.code_body = sr.get_code(1);
+        return ::std::move(xnode);
+      }
+
+      case index_declare_variable: {
+        S_declare_variable xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.name = sr.get_string();
+        xnode.escaping = sr.get_uint();
+        return ::std::move(xnode);
+      }
+
+      case index_initialize_variable: {
+        S_initialize_variable xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.immutable = sr.get_uint();
+        return ::std::move(xnode);
+      }
+
+      case index_if_statement: {
+        S_if_statement xnode;
+        xnode.negative = sr.get_uint();
+        xnode.code_true = sr.get_code(1);
+        xnode.code_false = sr.get_code(1);
+        return ::std::move(xnode);
+      }
+
+      case index_switch_statement: {
+        S_switch_statement xnode;
+        size_t nclauses = sr.get_uint32();
+        for(size_t i = 0;  i < nclauses;  ++i) {
+          xnode.code_labels.emplace_back(sr.get_code());
+          xnode.code_bodies.emplace_back(sr.get_code(1));
+          xnode.names_added.emplace_back(sr.get_strings());
+        }
+        return ::std::move(xnode);
+      }
+
+      case index_do_while_statement: {
+        S_do_while_statement xnode;
+        xnode.code_body = sr.get_code(1);
+        xnode.negative = sr.get_uint();
+        xnode.code_cond = sr.get_code();
+        return ::std::move(xnode);
+      }
 
-      case index_push_unnamed_array:
-        return do_solidify<AIR_Traits_push_unnamed_array>(queue,
-                                     this->m_stor.as<index_push_unnamed_array>());
+      case index_while_statement: {
+        S_while_statement xnode;
+        xnode.negative = sr.get_uint();
+        xnode.code_cond = sr.get_code();
+        xnode.code_body = sr.get_code(1);
+        return ::std::move(xnode);
+      }
 
-      case index_push_unnamed_object:
-        return do_solidify<AIR_Traits_push_unnamed_object>(queue,
-                                     this->m_stor.as<index_push_unnamed_object>());
+      case index_for_each_statement: {
+        S_for_each_statement xnode;
+        xnode.name_key = sr.get_string();
+        xnode.name_mapped = sr.get_string();
+        xnode.code_init = sr.get_code(1);
+        xnode.code_body = sr.get_code(2);
+        return ::std::move(xnode);
+      }
 
-      case index_apply_operator: {
-        const auto& altr = this->m_stor.as<index_apply_operator>();
-        switch(altr.xop) {
-          case xop_inc_post:
-            return do_solidify<AIR_Traits_apply_operator_inc_post>(queue, altr);
+      case index_for_statement: {
+        S_for_statement xnode;
+        xnode.code_init = sr.get_code(1);
+        xnode.code_cond = sr.get_code(1);
+        xnode.code_step = sr.get_code(1);
+        xnode.code_body = sr.get_code(2);
+        return ::std::move(xnode);
+      }
 
-          case xop_dec_post:
-            return do_solidify<AIR_Traits_apply_operator_dec_post>(queue, altr);
+      case index_try_statement: {
+        S_try_statement xnode;
+        xnode.sloc_try = sr.get_sloc();
+        xnode.code_try = sr.get_code(1);
+        xnode.sloc_catch = sr.get_sloc();
+        xnode.name_except = sr.get_string();
+        xnode.code_catch = sr.get_code(1);
+        return ::std::move(xnode);
+      }
 
-          case xop_subscr:
-            return do_solidify<AIR_Traits_apply_operator_subscr>(queue, altr);
+      case index_throw_statement: {
+        S_throw_statement xnode;
+        xnode.sloc = sr.get_sloc();
+        return ::std::move(xnode);
+      }
 
-          case xop_pos:
-            return do_solidify<AIR_Traits_apply_operator_pos>(queue, altr);
+      case index_assert_statement: {
+        S_assert_statement xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.negative = sr.get_uint();
+        xnode.msg = sr.get_string();
+        return ::std::move(xnode);
+      }
 
-          case xop_neg:
-            return do_solidify<AIR_Traits_apply_operator_neg>(queue, altr);
+      case index_simple_status: {
+        S_simple_status xnode;
+        xnode.status = do_get_enum(sr, air_status_continue_for);
+        return ::std::move(xnode);
+      }
 
-          case xop_notb:
-            return do_solidify<AIR_Traits_apply_operator_notb>(queue, altr);
+      case index_convert_to_temporary: {
+        S_convert_to_temporary xnode;
+        xnode.sloc = sr.get_sloc();
+        return ::std::move(xnode);
+      }
 
-          case xop_notl:
-            return do_solidify<AIR_Traits_apply_operator_notl>(queue, altr);
+      case index_push_global_reference: {
+        S_push_global_reference xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.name = sr.get_string();
+        return ::std::move(xnode);
+      }
 
-          case xop_inc_pre:
-            return do_solidify<AIR_Traits_apply_operator_inc_pre>(queue, altr);
+      case index_push_local_reference: {
+        S_push_local_reference xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.depth = sr.get_depth();
+        xnode.slot = sr.get_uint32();
+        xnode.name = sr.get_string();
+        return ::std::move(xnode);
+      }
 
-          case xop_dec_pre:
-            return do_solidify<AIR_Traits_apply_operator_dec_pre>(queue, altr);
+      case index_push_bound_reference: {
+        S_push_bound_reference xnode;
+        xnode.ref = sr.get_reference();
+        return ::std::move(xnode);
+      }
 
-          case xop_unset:
-            return do_solidify<AIR_Traits_apply_operator_unset>(queue, altr);
+      case index_define_function: {
+        S_define_function xnode;
+        xnode.opts = sr.get_options();
+        xnode.sloc = sr.get_sloc();
+        xnode.func = sr.get_string();
+        xnode.params = sr.get_strings();
+        xnode.code_body = sr.get_code(1);
+        return ::std::move(xnode);
+      }
 
-          case xop_countof:
-            return do_solidify<AIR_Traits_apply_operator_countof>(queue, altr);
+      case index_branch_expression: {
+        S_branch_expression xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.code_true = sr.get_code();
+        xnode.code_false = sr.get_code();
+        xnode.assign = sr.get_uint();
+        return ::std::move(xnode);
+      }
 
-          case xop_typeof:
-            return do_solidify<AIR_Traits_apply_operator_typeof>(queue, altr);
+      case index_coalescence: {
+        S_coalescence xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.code_null = sr.get_code();
+        xnode.assign = sr.get_uint();
+        return ::std::move(xnode);
+      }
 
-          case xop_sqrt:
-            return do_solidify<AIR_Traits_apply_operator_sqrt>(queue, altr);
+      case index_function_call: {
+        S_function_call xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.nargs = sr.get_uint32();
+        xnode.ptc = do_get_ptc_aware(sr);
+        return ::std::move(xnode);
+      }
 
-          case xop_isnan:
-            return do_solidify<AIR_Traits_apply_operator_isnan>(queue, altr);
+      case index_member_access: {
+        S_member_access xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.name = sr.get_string();
+        return ::std::move(xnode);
+      }
 
-          case xop_isinf:
-            return do_solidify<AIR_Traits_apply_operator_isinf>(queue, altr);
+      case index_push_unnamed_array: {
+        S_push_unnamed_array xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.nelems = sr.get_uint32();
+        return ::std::move(xnode);
+      }
 
-          case xop_abs:
-            return do_solidify<AIR_Traits_apply_operator_abs>(queue, altr);
+      case index_push_unnamed_object: {
+        S_push_unnamed_object xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.keys = sr.get_strings();
+        return ::std::move(xnode);
+      }
 
-          case xop_sign:
-            return do_solidify<AIR_Traits_apply_operator_sign>(queue, altr);
+      case index_apply_operator: {
+        S_apply_operator xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.xop = do_get_enum(sr, xop_tail);
+        xnode.assign = sr.get_uint();
+        return ::std::move(xnode);
+      }
 
-          case xop_round:
-            return do_solidify<AIR_Traits_apply_operator_round>(queue, altr);
+      case index_unpack_struct_array: {
+        S_unpack_struct_array xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.immutable = sr.get_uint();
+        xnode.nelems = sr.get_uint32();
+        return ::std::move(xnode);
+      }
 
-          case xop_floor:
-            return do_solidify<AIR_Traits_apply_operator_floor>(queue, altr);
+      case index_unpack_struct_object: {
+        S_unpack_struct_object xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.immutable = sr.get_uint();
+        xnode.keys = sr.get_strings();
+        return ::std::move(xnode);
+      }
 
-          case xop_ceil:
-            return do_solidify<AIR_Traits_apply_operator_ceil>(queue, altr);
+      case index_define_null_variable: {
+        S_define_null_variable xnode;
+        xnode.immutable = sr.get_uint();
+        xnode.sloc = sr.get_sloc();
+        xnode.name = sr.get_string();
+        xnode.escaping = sr.get_uint();
+        return ::std::move(xnode);
+      }
 
-          case xop_trunc:
-            return do_solidify<AIR_Traits_apply_operator_trunc>(queue, altr);
+      case index_single_step_trap: {
+        S_single_step_trap xnode;
+        xnode.sloc = sr.get_sloc();
+        return ::std::move(xnode);
+      }
 
-          case xop_iround:
-            return do_solidify<AIR_Traits_apply_operator_iround>(queue, altr);
+      case index_variadic_call: {
+        S_variadic_call xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.ptc = do_get_ptc_aware(sr);
+        return ::std::move(xnode);
+      }
 
-          case xop_ifloor:
-            return do_solidify<AIR_Traits_apply_operator_ifloor>(queue, altr);
+      case index_defer_expression: {
+        S_defer_expression xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.code_body = sr.get_code();
+        return ::std::move(xnode);
+      }
 
-          case xop_iceil:
-            return do_solidify<AIR_Traits_apply_operator_iceil>(queue, altr);
+      case index_import_call: {
+        S_import_call xnode;
+        xnode.opts = sr.get_options();
+        xnode.sloc = sr.get_sloc();
+        xnode.nargs = sr.get_uint32();
+        return ::std::move(xnode);
+      }
 
-          case xop_itrunc:
-            return do_solidify<AIR_Traits_apply_operator_itrunc>(queue, altr);
+      case index_declare_reference: {
+        S_declare_reference xnode;
+        xnode.name = sr.get_string();
+        return ::std::move(xnode);
+      }
 
-          case xop_cmp_eq:
-            return do_solidify<AIR_Traits_apply_operator_cmp_eq>(queue, altr);
+      case index_initialize_reference: {
+        S_initialize_reference xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.name = sr.get_string();
+        return ::std::move(xnode);
+      }
 
-          case xop_cmp_ne:
-            return do_solidify<AIR_Traits_apply_operator_cmp_ne>(queue, altr);
+      case index_fused_apply_operator: {
+        S_fused_apply_operator xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.xop = do_get_fused_xop(sr);
+        xnode.assign = sr.get_uint();
+        xnode.lhs = do_get_operand(sr);
+        xnode.rhs = do_get_operand(sr);
+        return ::std::move(xnode);
+      }
 
-          case xop_cmp_lt:
-            return do_solidify<AIR_Traits_apply_operator_cmp_lt>(queue, altr);
+      case index_fused_if_statement: {
+        S_fused_if_statement xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.xop = do_get_fused_xop(sr);
+        xnode.lhs = do_get_operand(sr);
+        xnode.rhs = do_get_operand(sr);
+        xnode.negative = sr.get_uint();
+        xnode.code_true = sr.get_code(1);
+        xnode.code_false = sr.get_code(1);
+        return ::std::move(xnode);
+      }
 
-          case xop_cmp_gt:
-            return do_solidify<AIR_Traits_apply_operator_cmp_gt>(queue, altr);
+      case index_fused_while_statement: {
+        S_fused_while_statement xnode;
+        xnode.sloc = sr.get_sloc();
+        xnode.xop = do_get_fused_xop(sr);
+        xnode.lhs = do_get_operand(sr);
+        xnode.rhs = do_get_operand(sr);
+        xnode.negative = sr.get_uint();
+        xnode.code_body = sr.get_code(1);
+        return ::std::move(xnode);
+      }
 
-          case xop_cmp_lte:
-            return do_solidify<AIR_Traits_apply_operator_cmp_lte>(queue, altr);
+      default:
+        ASTERIA_THROW("Invalid AIR node type in bytecode (index `$1`)", index);
+    }
+  }
 
-          case xop_cmp_gte:
-            return do_solidify<AIR_Traits_apply_operator_cmp_gte>(queue, altr);
+bool
+AIR_Node::
+do_verify_stack(cow_vector<bool>& stack, const cow_vector<AIR_Node>& code)
+  {
+    // Bodies of statements are verified on an empty stack, which is always
+    // safe, as references below the top are never accessed. Nothing is known
+    // about the stack after a statement. The return value indicates whether
+    // `code` may return a status other than `air_status_next`.
+    const auto verify_body = [&](const cow_vector<AIR_Node>& body)
+      {
+        cow_vector<bool> temp;
+        return do_verify_stack(temp, body);
+      };
+
+    // Some code is expected to leave results on the stack, and must not
+    // transfer control elsewhere.
+    const auto verify_expression = [&](const cow_vector<AIR_Node>& body, size_t nresults)
+      {
+        cow_vector<bool> temp;
+        if(do_verify_stack(temp, body))
+          ASTERIA_THROW("Unexpected transfer of control in bytecode");
+        if(temp.size() < nresults)
+          ASTERIA_THROW("Missing result in bytecode");
+      };
+
+    // Subexpressions are evaluated on the current stack. See
+    // `do_evaluate_subexpression()`.
+    const auto verify_subexpression = [&](cow_vector<bool>& temp, bool assign,
+                                          const cow_vector<AIR_Node>& body)
+      {
+        if(body.empty())
+          return false;
+
+        if(!assign) {
+          do_verify_pop(temp, 1);
+          return do_verify_stack(temp, body);
+        }
 
-          case xop_cmp_3way:
-            return do_solidify<AIR_Traits_apply_operator_cmp_3way>(queue, altr);
+        if(do_verify_stack(temp, body))
+          ASTERIA_THROW("Unexpected transfer of control in bytecode");
+        do_verify_pop(temp, 1);
+        do_verify_replace_top(temp);
+        return false;
+      };
+
+    bool diverts = false;
+    for(const auto& node : code)
+      switch(node.index()) {
+        case index_clear_stack:
+          stack.clear();
+          break;
+
+        case index_execute_block: {
+          const auto& altr = node.m_stor.as<index_execute_block>();
+          diverts |= verify_body(altr.code_body);
+          stack.clear();
+          break;
+        }
 
-          case xop_add:
-            return do_solidify<AIR_Traits_apply_operator_add>(queue, altr);
+        case index_declare_variable:
+          stack.emplace_back(true);
+          break;
+
+        case index_initialize_variable:
+          do_verify_pop(stack, 1);
+          do_verify_pop_declared(stack, 1);
+          break;
+
+        case index_if_statement: {
+          const auto& altr = node.m_stor.as<index_if_statement>();
+          do_verify_pop(stack, 1);
+          diverts |= verify_body(altr.code_true);
+          diverts |= verify_body(altr.code_false);
+          stack.clear();
+          break;
+        }
 
-          case xop_sub:
-            return do_solidify<AIR_Traits_apply_operator_sub>(queue, altr);
+        case index_switch_statement: {
+          const auto& altr = node.m_stor.as<index_switch_statement>();
+          do_verify_pop(stack, 1);
+          for(const auto& label : altr.code_labels)
+            verify_expression(label, !label.empty());
+          for(const auto& body : altr.code_bodies)
+            diverts |= verify_body(body);
+          stack.clear();
+          break;
+        }
 
-          case xop_mul:
-            return do_solidify<AIR_Traits_apply_operator_mul>(queue, altr);
+        case index_do_while_statement: {
+          const auto& altr = node.m_stor.as<index_do_while_statement>();
+          diverts |= verify_body(altr.code_body);
+          verify_expression(altr.code_cond, 1);
+          stack.clear();
+          break;
+        }
 
-          case xop_div:
-            return do_solidify<AIR_Traits_apply_operator_div>(queue, altr);
+        case index_while_statement: {
+          const auto& altr = node.m_stor.as<index_while_statement>();
+          verify_expression(altr.code_cond, 1);
+          diverts |= verify_body(altr.code_body);
+          stack.clear();
+          break;
+        }
 
-          case xop_mod:
-            return do_solidify<AIR_Traits_apply_operator_mod>(queue, altr);
+        case index_for_each_statement: {
+          const auto& altr = node.m_stor.as<index_for_each_statement>();
+          verify_expression(altr.code_init, 1);
+          diverts |= verify_body(altr.code_body);
+          stack.clear();
+          break;
+        }
 
-          case xop_sll:
-            return do_solidify<AIR_Traits_apply_operator_sll>(queue, altr);
+        case index_for_statement: {
+          const auto& altr = node.m_stor.as<index_for_statement>();
+          verify_expression(altr.code_init, 0);
+          verify_expression(altr.code_cond, 0);
+          verify_expression(altr.code_step, 0);
+          diverts |= verify_body(altr.code_body);
+          stack.clear();
+          break;
+        }
 
-          case xop_srl:
-            return do_solidify<AIR_Traits_apply_operator_srl>(queue, altr);
+        case index_try_statement: {
+          const auto& altr = node.m_stor.as<index_try_statement>();
+          diverts |= verify_body(altr.code_try);
+          diverts |= verify_body(altr.code_catch);
+          stack.clear();
+          break;
+        }
 
-          case xop_sla:
-            return do_solidify<AIR_Traits_apply_operator_sla>(queue, altr);
+        case index_throw_statement:
+        case index_assert_statement:
+          do_verify_replace_top(stack);
+          break;
+
+        case index_simple_status: {
+          const auto& altr = node.m_stor.as<index_simple_status>();
+          if(altr.status == air_status_return_ref)
+            do_verify_replace_top(stack);
+          diverts |= altr.status != air_status_next;
+          break;
+        }
 
-          case xop_sra:
-            return do_solidify<AIR_Traits_apply_operator_sra>(queue, altr);
+        case index_convert_to_temporary:
+          do_verify_replace_top(stack);
+          break;
+
+        case index_push_global_reference:
+        case index_push_local_reference:
+        case index_push_bound_reference:
+          stack.emplace_back(false);
+          break;
+
+        case index_define_function: {
+          const auto& altr = node.m_stor.as<index_define_function>();
+          verify_body(altr.code_body);
+          stack.emplace_back(false);
+          break;
+        }
 
-          case xop_andb:
-            return do_solidify<AIR_Traits_apply_operator_andb>(queue, altr);
+        case index_branch_expression: {
+          const auto& altr = node.m_stor.as<index_branch_expression>();
+          do_verify_pop(stack, 1);
+          stack.emplace_back(false);
+          auto temp = stack;
+          diverts |= verify_subexpression(stack, altr.assign, altr.code_true);
+          diverts |= verify_subexpression(temp, altr.assign, altr.code_false);
+          do_verify_merge(stack, temp);
+          break;
+        }
 
-          case xop_orb:
-            return do_solidify<AIR_Traits_apply_operator_orb>(queue, altr);
+        case index_coalescence: {
+          const auto& altr = node.m_stor.as<index_coalescence>();
+          do_verify_pop(stack, 1);
+          stack.emplace_back(false);
+          auto temp = stack;
+          diverts |= verify_subexpression(temp, altr.assign, altr.code_null);
+          do_verify_merge(stack, temp);
+          break;
+        }
 
-          case xop_xorb:
-            return do_solidify<AIR_Traits_apply_operator_xorb>(queue, altr);
+        case index_function_call: {
+          const auto& altr = node.m_stor.as<index_function_call>();
+          do_verify_pop(stack, altr.nargs);
+          do_verify_replace_top(stack);
+          diverts |= altr.ptc != ptc_aware_none;
+          break;
+        }
 
-          case xop_assign:
-            return do_solidify<AIR_Traits_apply_operator_assign>(queue, altr);
+        case index_member_access:
+          do_verify_replace_top(stack);
+          break;
 
-          case xop_fma:
-            return do_solidify<AIR_Traits_apply_operator_fma>(queue, altr);
+        case index_push_unnamed_array: {
+          const auto& altr = node.m_stor.as<index_push_unnamed_array>();
+          do_verify_pop(stack, altr.nelems);
+          stack.emplace_back(false);
+          break;
+        }
 
-          case xop_head:
-            return do_solidify<AIR_Traits_apply_operator_head>(queue, altr);
+        case index_push_unnamed_object: {
+          const auto& altr = node.m_stor.as<index_push_unnamed_object>();
+          do_verify_pop(stack, altr.keys.size());
+          stack.emplace_back(false);
+          break;
+        }
 
-          case xop_tail:
-            return do_solidify<AIR_Traits_apply_operator_tail>(queue, altr);
+        case index_apply_operator: {
+          const auto& altr = node.m_stor.as<index_apply_operator>();
+          do_verify_pop(stack, do_get_xop_arity(altr.xop) - 1);
+          do_verify_replace_top(stack);
+          break;
+        }
 
-          default:
-            ASTERIA_TERMINATE("invalid operator type (xop `$1`)", altr.xop);
+        case index_unpack_struct_array: {
+          const auto& altr = node.m_stor.as<index_unpack_struct_array>();
+          do_verify_pop(stack, 1);
+          do_verify_pop_declared(stack, altr.nelems);
+          break;
         }
-      }
 
-      case index_unpack_struct_array:
-        return do_solidify<AIR_Traits_unpack_struct_array>(queue,
-                                     this->m_stor.as<index_unpack_struct_array>());
+        case index_unpack_struct_object: {
+          const auto& altr = node.m_stor.as<index_unpack_struct_object>();
+          do_verify_pop(stack, 1);
+          do_verify_pop_declared(stack, altr.keys.size());
+          break;
+        }
 
-      case index_unpack_struct_object:
-        return do_solidify<AIR_Traits_unpack_struct_object>(queue,
-                                     this->m_stor.as<index_unpack_struct_object>());
+        case index_define_null_variable:
+        case index_single_step_trap:
+          break;
 
-      case index_define_null_variable:
-        return do_solidify<AIR_Traits_define_null_variable>(queue,
-                                     this->m_stor.as<index_define_null_variable>());
+        case index_variadic_call: {
+          const auto& altr = node.m_stor.as<index_variadic_call>();
+          do_verify_pop(stack, 1);
+          do_verify_replace_top(stack);
+          diverts |= altr.ptc != ptc_aware_none;
+          break;
+        }
 
-      case index_single_step_trap:
-        return do_solidify<AIR_Traits_single_step_trap>(queue,
-                                     this->m_stor.as<index_single_step_trap>());
+        case index_defer_expression: {
+          // The result of a deferred expression is overwritten when a function
+          // returns by reference. See `Executive_Context::on_scope_exit()`.
+          const auto& altr = node.m_stor.as<index_defer_expression>();
+          verify_expression(altr.code_body, 1);
+          break;
+        }
 
-      case index_variadic_call:
-        return do_solidify<AIR_Traits_variadic_call>(queue,
-                                     this->m_stor.as<index_variadic_call>());
+        case index_import_call: {
+          const auto& altr = node.m_stor.as<index_import_call>();
+          if(altr.nargs == 0)
+            ASTERIA_THROW("Missing path for `import` in bytecode");
+          do_verify_pop(stack, altr.nargs - 1);
+          do_verify_replace_top(stack);
+          break;
+        }
 
-      case index_defer_expression:
-        return do_solidify<AIR_Traits_defer_expression>(queue,
-                                     this->m_stor.as<index_defer_expression>());
+        case index_declare_reference:
+          break;
 
-      case index_import_call:
-        return do_solidify<AIR_Traits_import_call>(queue,
-                                     this->m_stor.as<index_import_call>());
+        case index_initialize_reference:
+          do_verify_pop(stack, 1);
+          break;
 
-      case index_declare_reference:
-        return do_solidify<AIR_Traits_declare_reference>(queue,
-                                     this->m_stor.as<index_declare_reference>());
+        case index_fused_apply_operator:
+          stack.emplace_back(false);
+          break;
 
-      case index_initialize_reference:
-        return do_solidify<AIR_Traits_initialize_reference>(queue,
-                                     this->m_stor.as<index_initialize_reference>());
+        case index_fused_if_statement: {
+          const auto& altr = node.m_stor.as<index_fused_if_statement>();
+          diverts |= verify_body(altr.code_true);
+          diverts |= verify_body(altr.code_false);
+          stack.clear();
+          break;
+        }
 
-      default:
-        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
-    }
+        case index_fused_while_statement: {
+          const auto& altr = node.m_stor.as<index_fused_while_statement>();
+          diverts |= verify_body(altr.code_body);
+          stack.clear();
+          break;
+        }
+
+        default:
+          ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", node.index());
+      }
+    return diverts;
+  }
+
+void
+AIR_Node::
+verify_stack(const cow_vector<AIR_Node>& code)
+  {
+    cow_vector<bool> stack;
+    do_verify_stack(stack, code);
   }
 
 Variable_Callback&
@@ -5322,6 +7884,30 @@ enumerate_variables(Variable_Callback& callback)
       case index_initialize_reference:
         return callback;
 
+      case index_fused_apply_operator: {
+        const auto& altr = this->m_stor.as<index_fused_apply_operator>();
+        altr.lhs.ref.enumerate_variables(callback);
+        altr.rhs.ref.enumerate_variables(callback);
+        return callback;
+      }
+
+      case index_fused_if_statement: {
+        const auto& altr = this->m_stor.as<index_fused_if_statement>();
+        altr.lhs.ref.enumerate_variables(callback);
+        altr.rhs.ref.enumerate_variables(callback);
+        ::rocket::for_each(altr.code_true, callback);
+        ::rocket::for_each(altr.code_false, callback);
+        return callback;
+      }
+
+      case index_fused_while_statement: {
+        const auto& altr = this->m_stor.as<index_fused_while_statement>();
+        altr.lhs.ref.enumerate_variables(callback);
+        altr.rhs.ref.enumerate_variables(callback);
+        ::rocket::for_each(altr.code_body, callback);
+        return callback;
+      }
+
       default:
         ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
     }
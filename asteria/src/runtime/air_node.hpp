@@ -27,6 +27,7 @@ class AIR_Node
       {
         Source_Location sloc;
         phsh_string name;
+        bool escaping;
       };
 
     struct S_initialize_variable
@@ -120,6 +121,7 @@ class AIR_Node
       {
         Source_Location sloc;
         uint32_t depth;
+        uint32_t slot;
         phsh_string name;
       };
 
@@ -203,6 +205,7 @@ class AIR_Node
         bool immutable;
         Source_Location sloc;
         phsh_string name;
+        bool escaping;
       };
 
     struct S_single_step_trap
@@ -240,6 +243,46 @@ class AIR_Node
         phsh_string name;
       };
 
+    // This is an operand of a superinstruction. If `name` is empty, `ref` is
+    // pushed verbatim. Otherwise, it denotes a local reference.
+    struct Fused_Operand
+      {
+        uint32_t depth;
+        uint32_t slot;
+        phsh_string name;
+        Reference ref;
+      };
+
+    struct S_fused_apply_operator
+      {
+        Source_Location sloc;
+        Xop xop;
+        bool assign;
+        Fused_Operand lhs;
+        Fused_Operand rhs;
+      };
+
+    struct S_fused_if_statement
+      {
+        Source_Location sloc;
+        Xop xop;
+        Fused_Operand lhs;
+        Fused_Operand rhs;
+        bool negative;
+        cow_vector<AIR_Node> code_true;
+        cow_vector<AIR_Node> code_false;
+      };
+
+    struct S_fused_while_statement
+      {
+        Source_Location sloc;
+        Xop xop;
+        Fused_Operand lhs;
+        Fused_Operand rhs;
+        bool negative;
+        cow_vector<AIR_Node> code_body;
+      };
+
     enum Index : uint8_t
       {
         index_clear_stack            =  0,
@@ -277,6 +320,9 @@ class AIR_Node
         index_import_call            = 32,
         index_declare_reference      = 33,
         index_initialize_reference   = 34,
+        index_fused_apply_operator   = 35,
+        index_fused_if_statement     = 36,
+        index_fused_while_statement  = 37,
       };
 
   private:
@@ -317,9 +363,16 @@ class AIR_Node
         ,S_import_call            // 32,
         ,S_declare_reference      // 33,
         ,S_initialize_reference   // 34,
+        ,S_fused_apply_operator   // 35,
+        ,S_fused_if_statement     // 36,
+        ,S_fused_while_statement  // 37,
       )>
       m_stor;
 
+    static
+    bool
+    do_verify_stack(cow_vector<bool>& stack, const cow_vector<AIR_Node>& code);
+
   public:
     // Constructors and assignment operators
     template<typename XNodeT,
@@ -368,6 +421,46 @@ class AIR_Node
     solidify(AVMC_Queue& queue)
       const;
 
+    // Evaluate this node at compile time, if it is an operator that has no side
+    // effects and all of its operands are constants at the end of `code`. If the
+    // result can be determined, operands are replaced with it and `true` is
+    // returned. Otherwise, `code` is left intact and `false` is returned.
+    bool
+    fold_constant(cow_vector<AIR_Node>& code)
+      const;
+
+    // Get the value of this node if it pushes a constant, i.e. a temporary
+    // reference. Otherwise, a null pointer is returned.
+    const Value*
+    get_constant_opt()
+      const noexcept;
+
+    // Replace common sequences of nodes in `code` with superinstructions, which
+    // are executed with fewer dispatches. Nested blocks are processed recursively,
+    // but bodies of closures are not, as they have been processed on creation.
+    // The return value indicates whether `code` has been modified.
+    static
+    bool
+    fuse_nodes(cow_vector<AIR_Node>& code);
+
+    // Write this node to a binary stream, or read a node from it. Bound references
+    // which are not constants cannot be written.
+    void
+    serialize(AIR_Bytecode_Writer& sw)
+      const;
+
+    static
+    AIR_Node
+    deserialize(AIR_Bytecode_Reader& sr);
+
+    // Check whether `code` can be executed on an empty stack without accessing
+    // references that do not exist. Code that has been read from a binary stream
+    // is not trusted, so it must be checked this way. An exception is thrown if
+    // the check fails.
+    static
+    void
+    verify_stack(const cow_vector<AIR_Node>& code);
+
     // This is needed because the body of a closure should not be solidified.
     Variable_Callback&
     enumerate_variables(Variable_Callback& callback)
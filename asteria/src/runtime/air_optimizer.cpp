@@ -5,12 +5,22 @@
 #include "air_optimizer.hpp"
 #include "analytic_context.hpp"
 #include "instantiated_function.hpp"
+#include "air_bytecode.hpp"
 #include "enums.hpp"
 #include "../compiler/statement.hpp"
 #include "../compiler/expression_unit.hpp"
 #include "../utils.hpp"
 
 namespace asteria {
+namespace {
+
+// Bytecode starts with this magic number, followed by the version of the format,
+// which shall be updated whenever the layout of a node is changed.
+// The first character never starts a valid script.
+constexpr char s_bytecode_magic[8] = { '\x7F','A','S','T','E','R','I','A' };
+constexpr uint64_t s_bytecode_version = 2;
+
+}  // namespace
 
 AIR_Optimizer::
 ~AIR_Optimizer()
@@ -32,6 +42,16 @@ reload(Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
     Analytic_Context ctx_func(Analytic_Context::M_function(),
                               ctx_opt, this->m_params);
 
+    // Find local variables that may escape from this function. Those that
+    // can't will not be tracked by the garbage collector.
+    cow_vector<phsh_string> escaping;
+    if(this->m_opts.optimization_level >= 2) {
+      for(const auto& stmt : stmts)
+        stmt.collect_escaping_names(escaping, false);
+
+      ctx_func.set_escaping_names(&escaping);
+    }
+
     // Generate code for all statements.
     for(size_t i = 0;  i + 1 < stmts.size();  ++i)
       stmts.at(i).generate_code(this->m_code, nullptr, ctx_func, this->m_opts,
@@ -41,10 +61,14 @@ reload(Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
             ptc_aware_void);
 
     // Check whether optimization is enabled during translation.
+    // Note that constant folding and propagation of immutable variables have
+    // been performed during code generation, where scopes of names are known.
     if(this->m_opts.optimization_level < 2)
       return *this;
 
-    // TODO: Insert optimization passes
+    // Replace common sequences with superinstructions. Fused nodes can still be
+    // rebound, so this is done before any references are bound.
+    AIR_Node::fuse_nodes(this->m_code);
     return *this;
   }
 
@@ -77,6 +101,56 @@ rebind(Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
     return *this;
   }
 
+const AIR_Optimizer&
+AIR_Optimizer::
+serialize(tinybuf& cbuf)
+  const
+  {
+    AIR_Bytecode_Writer sw(cbuf);
+    sw.put_bytes(s_bytecode_magic, sizeof(s_bytecode_magic));
+    sw.put_uint(s_bytecode_version);
+    sw.put_options(this->m_opts);
+    sw.put_strings(this->m_params);
+    sw.put_code(this->m_code);
+    cbuf.flush();
+    return *this;
+  }
+
+AIR_Optimizer&
+AIR_Optimizer::
+deserialize(tinybuf& cbuf)
+  {
+    AIR_Bytecode_Reader sr(cbuf);
+    char magic[sizeof(s_bytecode_magic)];
+    sr.get_bytes(magic, sizeof(magic));
+    if(::std::memcmp(magic, s_bytecode_magic, sizeof(magic)) != 0)
+      ASTERIA_THROW("Invalid bytecode signature");
+
+    uint64_t version = sr.get_uint();
+    if(version != s_bytecode_version)
+      ASTERIA_THROW("Bytecode version not supported (version `$1`)", version);
+
+    // Read everything before modifying `*this`.
+    auto opts = sr.get_options();
+    auto params = sr.get_strings();
+    // The body of a function is executed in its own context, which is the only
+    // one that local references can denote at the top level.
+    auto code = sr.get_code(1);
+    AIR_Node::verify_stack(code);
+
+    this->m_opts = opts;
+    this->m_params = ::std::move(params);
+    this->m_code = ::std::move(code);
+    return *this;
+  }
+
+bool
+AIR_Optimizer::
+is_bytecode(tinybuf& cbuf)
+  {
+    return cbuf.peekc() == static_cast<unsigned char>(s_bytecode_magic[0]);
+  }
+
 cow_function
 AIR_Optimizer::
 create_function(const Source_Location& sloc, const cow_string& name)
@@ -73,6 +73,21 @@ class AIR_Optimizer
     rebind(Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
            const cow_vector<AIR_Node>& code);
 
+    // These functions convert code to and from bytecode, which can be loaded
+    // without being parsed again. Only code that has not been rebound can be
+    // serialized. Options are stored along with the code.
+    const AIR_Optimizer&
+    serialize(tinybuf& cbuf)
+      const;
+
+    AIR_Optimizer&
+    deserialize(tinybuf& cbuf);
+
+    // Check whether `cbuf` starts with bytecode. No character is consumed.
+    static
+    bool
+    is_bytecode(tinybuf& cbuf);
+
     // Create a closure value that can be assigned to a variable.
     cow_function
     create_function(const Source_Location& sloc, const cow_string& name);
@@ -28,12 +28,9 @@ Analytic_Context(M_function, Abstract_Context* parent_opt,
       this->do_open_named_reference(nullptr, name).set_uninit();
     }
 
-    // Set pre-defined references.
-    // N.B. If you have ever changed these, remember to update 'executive_context.cpp'
-    // as well.
-    this->do_open_named_reference(nullptr, sref("__varg")).set_uninit();
-    this->do_open_named_reference(nullptr, sref("__this")).set_uninit();
-    this->do_open_named_reference(nullptr, sref("__func")).set_uninit();
+    // Pre-defined references are created lazily, like in executive contexts,
+    // so slot indices of other names are the same in both.
+    this->m_func = true;
   }
 
 Analytic_Context::
@@ -41,4 +38,25 @@ Analytic_Context::
   {
   }
 
+Reference*
+Analytic_Context::
+do_create_lazy_reference(Reference* hint_opt, const phsh_string& name)
+  const
+  {
+    if(!this->m_func)
+      return nullptr;
+
+    // Create pre-defined references as needed.
+    // N.B. If you have ever changed these, remember to update 'executive_context.cpp'
+    // as well.
+    if((name == "__varg") || (name == "__this") || (name == "__func")) {
+      // Its contents are out of interest.
+      auto& ref = this->do_open_named_reference(hint_opt, name);
+      ref.set_uninit();
+      return &ref;
+    }
+
+    return nullptr;
+  }
+
 }  // namespace asteria
@@ -14,6 +14,11 @@ class Analytic_Context
   {
   private:
     Abstract_Context* m_parent_opt;
+    bool m_func = false;  // is this a function context?
+
+    // These are names of local variables that may escape from the function.
+    // If this is null, all local variables are considered escaping.
+    const cow_vector<phsh_string>* m_escaping_opt = nullptr;
 
   public:
     // A plain context must have a parent context.
@@ -21,7 +26,11 @@ class Analytic_Context
     explicit
     Analytic_Context(M_plain, Abstract_Context& parent)
       : m_parent_opt(::std::addressof(parent))
-      { }
+      {
+        // Plain contexts belong to the same function as their parents.
+        if(parent.is_analytic())
+          this->m_escaping_opt = static_cast<Analytic_Context&>(parent).m_escaping_opt;
+      }
 
     // A function context may have a parent.
     // Names found in ancestor contexts will be bound into the
@@ -42,9 +51,8 @@ class Analytic_Context
       { return this->get_parent_opt();  }
 
     Reference*
-    do_create_lazy_reference(Reference* /*hint_opt*/, const phsh_string& /*name*/)
-      const override
-      { return nullptr;  }
+    do_create_lazy_reference(Reference* hint_opt, const phsh_string& name)
+      const override;
 
   public:
     ASTERIA_NONCOPYABLE_DESTRUCTOR(Analytic_Context);
@@ -58,6 +66,17 @@ class Analytic_Context
     get_parent_opt()
       const noexcept
       { return this->m_parent_opt;  }
+
+    // The vector shall outlast this context and all its descendants.
+    Analytic_Context&
+    set_escaping_names(const cow_vector<phsh_string>* names_opt)
+      noexcept
+      { return this->m_escaping_opt = names_opt, *this;  }
+
+    bool
+    is_escaping(const phsh_string& name)
+      const
+      { return !this->m_escaping_opt || ::rocket::find(*(this->m_escaping_opt), name);  }
   };
 
 }  // namespace asteria
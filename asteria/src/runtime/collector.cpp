@@ -5,7 +5,9 @@
 #include "collector.hpp"
 #include "variable.hpp"
 #include "variable_callback.hpp"
+#include "abstract_hooks.hpp"
 #include "../utils.hpp"
+#include <time.h>  // ::clock_gettime()
 
 namespace asteria {
 namespace {
@@ -33,19 +35,38 @@ class Sentry
       { return this->m_old == 0;  }
   };
 
-template<typename FuncT>
+inline
+uint64_t
+do_get_monotonic_nsecs()
+  noexcept
+  {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+  }
+
+struct Shared_Descender
+  {
+    bool
+    operator()(const Value& /*value*/, const void* /*key*/, long /*nref*/)
+      const noexcept
+      { return true;  }
+  };
+
+template<typename FuncT, typename SharedFuncT>
 class Variable_Walker
   final
   : public Variable_Callback
   {
   private:
     ::std::reference_wrapper<FuncT> m_func;
+    ::std::reference_wrapper<SharedFuncT> m_shared_func;
 
   public:
     explicit
-    Variable_Walker(FuncT& func)
+    Variable_Walker(FuncT& func, SharedFuncT& shared_func)
       noexcept
-      : m_func(func)
+      : m_func(func), m_shared_func(shared_func)
       { }
 
   protected:
@@ -53,27 +74,52 @@ class Variable_Walker
     do_process_one(const rcptr<Variable>& var)
       override
       { return this->m_func(var);  }
+
+    bool
+    do_process_shared(const Value& value, const void* key, long nref)
+      override
+      { return this->m_shared_func(value, key, nref);  }
   };
 
-template<typename ContT, typename FuncT>
+template<typename ContT, typename FuncT, typename SharedFuncT = Shared_Descender>
 void
-do_traverse(const ContT& cont, FuncT&& func)
+do_traverse(const ContT& cont, FuncT&& func, SharedFuncT&& shared_func = SharedFuncT())
   {
-    Variable_Walker<FuncT> walker(func);
+    using walker_type = Variable_Walker<typename ::std::remove_reference<FuncT>::type,
+                                        typename ::std::remove_reference<SharedFuncT>::type>;
+    walker_type walker(func, shared_func);
     cont.enumerate_variables(walker);
   }
 
-template<typename FuncT>
+template<typename FuncT, typename SharedFuncT = Shared_Descender>
 void
-do_traverse(const Variable& var, FuncT&& func)
+do_traverse(const Variable& var, FuncT&& func, SharedFuncT&& shared_func = SharedFuncT())
   {
     if(ROCKET_EXPECT(var.get_value().is_scalar()))
       return;
 
-    Variable_Walker<FuncT> walker(func);
+    using walker_type = Variable_Walker<typename ::std::remove_reference<FuncT>::type,
+                                        typename ::std::remove_reference<SharedFuncT>::type>;
+    walker_type walker(func, shared_func);
     var.enumerate_variables_descent(walker);
   }
 
+template<typename FuncT, typename SharedFuncT>
+void
+do_traverse_shared(const void* key, const Value& value, FuncT&& func, SharedFuncT&& shared_func)
+  {
+    // Enumerate children of `value`, which would otherwise be reported to
+    // `shared_func` first, as it is shared.
+    auto self_func = [&](const Value& other, const void* other_key, long nref) {
+      return (other_key == key) || shared_func(other, other_key, nref);
+    };
+
+    using walker_type = Variable_Walker<typename ::std::remove_reference<FuncT>::type,
+                                        decltype(self_func)>;
+    walker_type walker(func, self_func);
+    value.enumerate_variables(walker);
+  }
+
 class Variable_Wiper
   final
   : public Variable_Callback
@@ -108,7 +154,10 @@ track_variable(const rcptr<Variable>& var)
     if(ROCKET_UNEXPECT(this->m_counter > this->m_threshold))
       this->auto_collect();
 
-    return this->m_tracked.insert(var);
+    // Defer the decision until the next collection.
+    var->set_gc_deferred(true);
+    this->m_deferred.emplace_back(var);
+    return true;
   }
 
 bool
@@ -116,97 +165,249 @@ Collector::
 untrack_variable(const rcptr<Variable>& var)
   noexcept
   {
-    return this->m_tracked.erase(var);
+    bool erased = this->m_tracked.erase(var);
+    erased |= this->m_pending.erase(var);
+    return erased;
   }
 
 Collector*
 Collector::
-collect_single_opt()
+do_sweep_deferred()
   {
-    // Ignore recursive requests.
-    const Sentry sentry(this->m_recur);
-    if(!sentry)
-      return nullptr;
+    Collector* next = nullptr;
+    auto output = this->m_output_opt;
+    auto tied = this->m_tied_opt;
+    size_t nfreed = 0;
+    size_t npromoted = 0;
+    size_t nsurvived = 0;
+
+    auto bptr = this->m_deferred.mut_data();
+    auto eptr = bptr + this->m_deferred.size();
+    auto kptr = bptr;
+
+    for(auto qvar = bptr;  qvar != eptr;  ++qvar) {
+      auto& var = *qvar;
+      if(var->use_count() <= 1) {
+        // This is the last reference, so free this variable.
+        var->set_gc_deferred(false);
+        var->uninitialize();
+        nfreed ++;
+
+        // Cache this variable for reallocation.
+        if(output)
+          output->push(var);
+        continue;
+      }
+
+      if(var->is_initialized() && !var->get_value().is_scalar()) {
+        // This variable might be involved in cycles, so track it. It will be
+        // counted when tracked variables are scanned.
+        var->set_gc_deferred(false);
+        this->m_tracked.insert(var);
+        continue;
+      }
+
+      nsurvived ++;
+
+      if(tied) {
+        // Transfer this variable to the next generational collector, but
+        // keep it deferred.
+        tied->m_deferred.emplace_back(::std::move(var));
+        npromoted ++;
+
+        // Check whether the next generation needs to be checked as well.
+        if(tied->m_counter++ >= tied->m_threshold)
+          next = tied;
+        continue;
+      }
+
+      // Keep this variable deferred.
+      if(kptr != qvar)
+        *kptr = ::std::move(var);
+      kptr ++;
+    }
+    this->m_deferred.pop_back(static_cast<size_t>(eptr - kptr));
+
+    // Update statistics.
+    this->m_cycle_scanned += nfreed + nsurvived;
+    this->m_cycle_collected += nfreed;
+    this->m_cycle_survived += nsurvived;
+
+    auto& stats = this->m_stats;
+    stats.traversed += nfreed + nsurvived;
+    stats.freed += nfreed;
+    stats.promoted += npromoted;
+    return next;
+  }
 
+Collector*
+Collector::
+do_collect_from(Variable_HashSet& roots, size_t budget)
+  {
     // The algorithm here is described at
     //   https://pythoninternal.wordpress.com/2014/08/04/the-garbage-collector/
 
     // We initialize `gc_ref` to zero then increment it, rather than initialize
     // `gc_ref` to the reference count then decrement it. This saves us a phase
     // below.
+    const auto qhooks = this->m_hooks_opt;
+    if(qhooks)
+      qhooks->on_gc_collect_begin(this->m_gen);
+
+    uint64_t time_start = do_get_monotonic_nsecs();
+    size_t nfreed = 0;
+    size_t npromoted = 0;
+    size_t nsurvived = 0;
+
     Collector* next = nullptr;
     auto output = this->m_output_opt;
     auto tied = this->m_tied_opt;
     this->m_staging.clear();
+    this->m_staged_values.clear();
+
+    // If the budget is limited, not all variables that are reachable from `roots`
+    // will be staged. References from those that are not staged are considered
+    // external, so their targets will not be collected. This is conservative,
+    // and allows collection to be performed in slices, with no write barrier.
+    bool partial = budget != SIZE_MAX;
+
+    // A shared value may be referenced from places that are not staged, such as
+    // an unstaged variable or the native stack. References from it are dropped
+    // only once, and only if all references to it come from staged values.
+    // Otherwise, variables that are reachable through it are kept alive.
+    auto stage_shared = [&](const Value& value, const void* key, long nref) {
+      // Enumerate children of `value` only once.
+      return this->m_staged_values.try_emplace(key, Staged_Value{ &value, nref, 0 }).second;
+    };
+
+    // Remove a variable from all sets of this collector.
+    auto untrack = [&](const rcptr<Variable>& var) {
+      roots.erase(var);
+      if(&roots != &(this->m_tracked))
+        this->untrack_variable(var);
+    };
 
     // Add variables that are either tracked or reachable indirectly into the
     // staging area.
-    do_traverse(this->m_tracked,
+    do_traverse(roots,
       [&](const rcptr<Variable>& root) {
         // Add a variable that is reachable directly.
-        // The reference from `m_tracked` should be excluded, so we initialize
+        // The reference from `roots` should be excluded, so we initialize
         // the `gc_ref` counter to 1.
         root->reset_gc_ref(1);
 
         // If this variable has been inserted indirectly, finish.
+        // N.B. Variables shall not be uninitialized here, even if `root` is the
+        // last reference, as that may unshare values which have been staged,
+        // whose children would then be counted twice below. Such variables
+        // are collected after marking anyway.
         if(!this->m_staging.insert(root))
           return false;
 
-        // If `root` is the last reference to this variable, it can be marked
-        // for collection immediately.
-        if(root->use_count() <= 2) {
-          root->uninitialize();
-          return false;
-        }
-
         // Enumerate variables that are reachable from `root` indirectly.
         do_traverse(*root,
           [&](const rcptr<Variable>& child) {
+            // Skip variables that have not been tracked yet. References from
+            // them are considered external.
+            if(child->is_gc_deferred())
+              return false;
+
             // If this variable has been inserted indirectly, finish.
             if(!this->m_staging.insert(child))
               return false;
 
             // Initialize the `gc_ref` counter.
-            // N.B. If this variable is encountered later from `m_tracked`,
+            // N.B. If this variable is encountered later from `roots`,
             // the `gc_ref` counter will be overwritten with 1.
             child->reset_gc_ref(0);
-            return true;
-          });
+
+            // If this variable is tracked but not in `roots`, the reference
+            // from the other set should be excluded as well.
+            if(partial)
+              child->reset_gc_ref(this->m_tracked.has(child) + this->m_pending.has(child));
+
+            // Stop if the budget has been exhausted.
+            return this->m_staging.size() < budget;
+          },
+          stage_shared);
         return false;
       });
 
+    size_t ntraversed = this->m_staging.size();
+
     // Drop references directly or indirectly from `m_staging`.
+    auto drop_child = [&](const rcptr<Variable>& child) {
+      // Skip variables that have not been staged.
+      if(child->is_gc_deferred() || (partial && !this->m_staging.has(child)))
+        return false;
+
+      // Drop an indirect reference.
+      child->add_gc_ref();
+      ROCKET_ASSERT(child->get_gc_ref() <= child->use_count());
+      return false;
+    };
+
+    auto drop_shared = [&](const Value& /*value*/, const void* key, long /*nref*/) {
+      // Drop a reference to a shared value. Its children are enumerated below.
+      auto qstaged = this->m_staged_values.mut_ptr(key);
+      if(qstaged)
+        qstaged->gc_ref ++;
+      return false;
+    };
+
     do_traverse(this->m_staging,
       [&](const rcptr<Variable>& root) {
         // Drop a direct reference.
-        bool marked = root->add_gc_ref();
+        root->add_gc_ref();
         ROCKET_ASSERT(root->get_gc_ref() <= root->use_count());
-        if(marked)
-          return false;
 
         if(!root->is_initialized()) {
           // Zombie variables can now be erased safely.
           root->uninitialize();
-          this->m_tracked.erase(root);
+          untrack(root);
+          nfreed ++;
 
           // Cache this variable for reallocation.
           if(output)
-            output->insert(root);
+            output->push(root);
           return false;
         }
 
         // Enumerate variables that are reachable from `root` indirectly.
-        do_traverse(*root,
-          [&](const rcptr<Variable>& child) {
-            // Drop an indirect reference.
-            child->add_gc_ref();
-            ROCKET_ASSERT(child->get_gc_ref() <= child->use_count());
-            return false;
-          });
+        do_traverse(*root, drop_child, drop_shared);
         return false;
       });
 
+    for(const auto& pair : this->m_staged_values)
+      do_traverse_shared(pair.first, *(pair.second.value), drop_child, drop_shared);
+
     // Mark variables reachable indirectly from those reachable directly.
+    auto mark_child = [&](const rcptr<Variable>& child) {
+      // Skip variables that have already been marked.
+      if(child->get_gc_ref() < 0)
+        return false;
+
+      // Skip variables that have not been staged.
+      if(child->is_gc_deferred() || (partial && !this->m_staging.has(child)))
+        return false;
+
+      // Mark it and its children recursively.
+      child->reset_gc_ref(-1);
+      return true;
+    };
+
+    auto mark_shared = [&](const Value& /*value*/, const void* key, long /*nref*/) {
+      // Skip values that have not been staged, as references from them have
+      // not been dropped. Skip values that have already been marked.
+      auto qstaged = this->m_staged_values.mut_ptr(key);
+      if(!qstaged || (qstaged->gc_ref < 0))
+        return false;
+
+      // Mark it and its children recursively.
+      qstaged->gc_ref = -1;
+      return true;
+    };
+
     do_traverse(this->m_staging,
       [&](const rcptr<Variable>& root) {
         // Skip variables that are possibly unreachable.
@@ -217,39 +418,49 @@ collect_single_opt()
         root->reset_gc_ref(-1);
 
         // Mark all children reachable as well.
-        do_traverse(*root,
-          [&](const rcptr<Variable>& child) {
-            // Skip variables that have already been marked.
-            if(child->get_gc_ref() < 0)
-              return false;
-
-            // Mark it and its children recursively.
-            child->reset_gc_ref(-1);
-            return true;
-          });
+        do_traverse(*root, mark_child, mark_shared);
         return false;
       });
 
+    for(auto it = this->m_staged_values.mut_begin();  it != this->m_staged_values.mut_end();  ++it) {
+      // Skip values that are possibly unreachable, or have been marked.
+      auto& staged = it->second;
+      if((staged.gc_ref < 0) || (staged.gc_ref >= staged.nref))
+        continue;
+
+      // Mark this value and its children reachable.
+      staged.gc_ref = -1;
+      do_traverse_shared(it->first, *(staged.value), mark_child, mark_shared);
+    }
+
     // Collect unreachable variables.
     do_traverse(this->m_staging,
       [&](const rcptr<Variable>& root) {
+        // Skip zombie variables, which have been collected already.
+        if(!root->is_initialized())
+          return false;
+
         // All variables that are reachable shall have negative `gc_ref` values.
         if(root->get_gc_ref() >= 0) {
           // Break reference cycles.
           root->uninitialize();
-          this->m_tracked.erase(root);
+          untrack(root);
+          nfreed ++;
 
           // Cache this variable for reallocation.
           if(output)
-            output->insert(root);
+            output->push(root);
           return false;
         }
 
+        nsurvived ++;
+
         if(tied) {
           // Transfer this variable to the next generational collector, if one
           // has been tied.
           tied->m_tracked.insert(root);
-          this->m_tracked.erase(root);
+          untrack(root);
+          npromoted ++;
 
           // Check whether the next generation needs to be checked as well.
           if(tied->m_counter++ >= tied->m_threshold)
@@ -262,7 +473,135 @@ collect_single_opt()
       });
 
     this->m_staging.clear();
+    this->m_staged_values.clear();
+
+    // Update statistics.
+    this->m_cycle_scanned += ntraversed;
+    this->m_cycle_collected += nfreed;
+    this->m_cycle_survived += nsurvived;
+
+    uint64_t pause = do_get_monotonic_nsecs() - time_start;
+    size_t bucket = 0;
+    for(uint64_t bound = 10'000;  (bucket < 5) && (pause >= bound);  bound *= 10)
+      bucket ++;
+
+    auto& stats = this->m_stats;
+    stats.collections ++;
+    stats.traversed += ntraversed;
+    stats.freed += nfreed;
+    stats.promoted += npromoted;
+    stats.pause_total += pause;
+    stats.pause_max = ::rocket::max(stats.pause_max, pause);
+    stats.pause_histogram[bucket] ++;
+
+    if(qhooks)
+      qhooks->on_gc_collect_end(this->m_gen, ntraversed, nfreed, pause);
+    return next;
+  }
+
+void
+Collector::
+do_finish_cycle()
+  noexcept
+  {
+    auto scanned = this->m_cycle_scanned;
+    auto collected = this->m_cycle_collected;
+    auto survived = this->m_cycle_survived;
+
+    this->m_cycle_scanned = 0;
+    this->m_cycle_collected = 0;
+    this->m_cycle_survived = 0;
     this->m_counter = 0;
+
+    if(!this->m_adaptive)
+      return;
+
+    // Calculate the new threshold.
+    uint64_t base = this->m_base_threshold;
+    uint64_t thres = this->m_threshold;
+
+    if(scanned == 0)
+      // If nothing has been scanned, there is nothing to learn from, so decay
+      // towards the base threshold.
+      thres = (thres + base) / 2;
+    else if(collected * 8 <= scanned)
+      // If few variables have been collected, this cycle was mostly a waste of
+      // time, so back off.
+      thres = thres * 2;
+    else if(survived * 20 <= scanned)
+      // If almost all variables have died young, larger cycles are cheaper, as
+      // the fixed cost is spread over more variables.
+      thres = thres * 3 / 2;
+    else
+      // Otherwise, decay towards the base threshold.
+      thres = (thres + base) / 2;
+
+    uint64_t limit = ::rocket::min(base * 64, UINT32_MAX);
+    this->m_threshold = static_cast<uint32_t>(::rocket::clamp(thres, base, limit));
+  }
+
+Collector*
+Collector::
+collect_single_opt()
+  {
+    // Ignore recursive requests.
+    const Sentry sentry(this->m_recur);
+    if(!sentry)
+      return nullptr;
+
+    // Abandon the incremental cycle in progress, if any.
+    while(auto var = this->m_pending.erase_random_opt())
+      this->m_tracked.insert(var);
+
+    this->m_cycle_scanned = 0;
+    this->m_cycle_collected = 0;
+    this->m_cycle_survived = 0;
+
+    // Scan all tracked variables, including new ones that may be involved in cycles.
+    auto next = this->do_sweep_deferred();
+    if(auto qnext = this->do_collect_from(this->m_tracked, SIZE_MAX))
+      next = qnext;
+    this->do_finish_cycle();
+    return next;
+  }
+
+Collector*
+Collector::
+collect_slice_opt(size_t budget)
+  {
+    // Ignore recursive requests.
+    const Sentry sentry(this->m_recur);
+    if(!sentry)
+      return nullptr;
+
+    // Start a new cycle if there is none in progress. Variables that are tracked
+    // after this point will be scanned in the next cycle.
+    Collector* next = nullptr;
+    if(this->m_pending.empty()) {
+      this->m_cycle_scanned = 0;
+      this->m_cycle_collected = 0;
+      this->m_cycle_survived = 0;
+      next = this->do_sweep_deferred();
+      this->m_pending.swap(this->m_tracked);
+    }
+
+    // Take some variables as roots of this slice.
+    budget = ::rocket::max(budget, size_t(1));
+    this->m_slice.clear();
+    while((this->m_slice.size() < budget) && !this->m_pending.empty())
+      this->m_slice.insert(this->m_pending.erase_random_opt());
+
+    // Scan them. Variables that are neither collected nor transferred remain
+    // tracked by this collector.
+    if(auto qnext = this->do_collect_from(this->m_slice, budget))
+      next = qnext;
+    while(auto var = this->m_slice.erase_random_opt())
+      this->m_tracked.insert(var);
+
+    // Until this cycle completes, every new variable triggers a slice, so the
+    // collector is not outpaced by allocation.
+    if(this->m_pending.empty())
+      this->do_finish_cycle();
     return next;
   }
 
@@ -272,7 +611,10 @@ auto_collect()
   {
     auto qnext = this;
     do
-      qnext = qnext->collect_single_opt();
+      if(qnext->m_budget)
+        qnext = qnext->collect_slice_opt(qnext->m_budget);
+      else
+        qnext = qnext->collect_single_opt();
     while(qnext);
   }
 
@@ -289,6 +631,9 @@ wipe_out_variables()
     // Wipe all variables recursively.
     Variable_Wiper wiper;
     this->m_tracked.enumerate_variables(wiper);
+    this->m_pending.enumerate_variables(wiper);
+    for(const auto& var : this->m_deferred)
+      wiper.process(var);
     return *this;
   }
 
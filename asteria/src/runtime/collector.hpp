@@ -5,39 +5,124 @@
 #define ASTERIA_RUNTIME_COLLECTOR_HPP_
 
 #include "../fwd.hpp"
+#include "abstract_hooks.hpp"
 #include "../llds/variable_hashset.hpp"
+#include "../llds/variable_pool.hpp"
 
 namespace asteria {
 
+struct Collector_Statistics
+  {
+    // These are cumulative counts. A collection is either a full collection
+    // or a slice of an incremental cycle.
+    uint64_t collections = 0;
+    uint64_t traversed = 0;
+    uint64_t freed = 0;
+    uint64_t promoted = 0;
+    uint64_t reused = 0;
+
+    // These are pause durations, in nanoseconds.
+    uint64_t pause_total = 0;
+    uint64_t pause_max = 0;
+
+    // This is a histogram of pause durations. The upper bounds of buckets are
+    // 10us, 100us, 1ms, 10ms, 100ms and infinity, respectively.
+    uint64_t pause_histogram[6] = { };
+  };
+
 class Collector
   {
   private:
-    Variable_HashSet* m_output_opt;
+    GC_Generation m_gen;
+    rcptr<Abstract_Hooks> m_hooks_opt;
+    Variable_Pool* m_output_opt;
     Collector* m_tied_opt;
     uint32_t m_threshold;
+    uint32_t m_base_threshold;
+    uint32_t m_budget = 0;  // zero means non-incremental
+    bool m_adaptive = false;
 
     uint32_t m_counter = 0;
     long m_recur = 0;
     Variable_HashSet m_tracked;
     Variable_HashSet m_staging;
 
+    // Shared values (arrays, objects, functions and opaque values) that are
+    // reachable from staged variables are staged as well, as they may also be
+    // referenced from outside. `gc_ref` counts references from staged values.
+    struct Staged_Value
+      {
+        const Value* value;
+        long nref;
+        long gc_ref;
+      };
+
+    ::rocket::cow_hashmap<const void*, Staged_Value, ::std::hash<const void*>> m_staged_values;
+
+    // New variables are appended here. Most of them hold scalar values, which
+    // can't form cycles. Before a collection, those that have died are freed,
+    // and those that hold other values are moved into `m_tracked`.
+    cow_vector<rcptr<Variable>> m_deferred;
+
+    // These are used by incremental collection. A cycle starts with all tracked
+    // variables moved into `m_pending`, which are then scanned in slices.
+    Variable_HashSet m_pending;
+    Variable_HashSet m_slice;
+
+    // These are statistics of the current cycle, which are used to tune the
+    // threshold adaptively.
+    size_t m_cycle_scanned = 0;
+    size_t m_cycle_collected = 0;
+    size_t m_cycle_survived = 0;
+
+    Collector_Statistics m_stats;
+
   public:
     explicit
-    Collector(Variable_HashSet* output_opt, Collector* tied_opt, uint32_t threshold)
+    Collector(GC_Generation gen, Variable_Pool* output_opt, Collector* tied_opt,
+              uint32_t threshold)
       noexcept
-      : m_output_opt(output_opt), m_tied_opt(tied_opt), m_threshold(threshold)
+      : m_gen(gen), m_output_opt(output_opt), m_tied_opt(tied_opt), m_threshold(threshold),
+        m_base_threshold(threshold)
       { }
 
+  private:
+    Collector*
+    do_sweep_deferred();
+
+    Collector*
+    do_collect_from(Variable_HashSet& roots, size_t budget);
+
+    void
+    do_finish_cycle()
+      noexcept;
+
   public:
     ASTERIA_NONCOPYABLE_DESTRUCTOR(Collector);
 
-    Variable_HashSet*
+    GC_Generation
+    get_generation()
+      const noexcept
+      { return this->m_gen;  }
+
+    // These hooks are notified before and after each collection.
+    const rcptr<Abstract_Hooks>&
+    get_hooks_opt()
+      const noexcept
+      { return this->m_hooks_opt;  }
+
+    Collector&
+    set_hooks(rcptr<Abstract_Hooks> hooks_opt)
+      noexcept
+      { return this->m_hooks_opt = ::std::move(hooks_opt), *this;  }
+
+    Variable_Pool*
     get_output_pool_opt()
       const noexcept
       { return this->m_output_opt;  }
 
     Collector&
-    set_output_pool(Variable_HashSet* output_opt)
+    set_output_pool(Variable_Pool* output_opt)
       noexcept
       { return this->m_output_opt = output_opt, *this;  }
 
@@ -56,15 +141,71 @@ class Collector
       const noexcept
       { return this->m_threshold;  }
 
+    // If adaptive tuning is enabled, this is the initial threshold. Otherwise it
+    // equals `get_threshold()`.
+    uint32_t
+    get_base_threshold()
+      const noexcept
+      { return this->m_base_threshold;  }
+
     Collector&
     set_threshold(uint32_t threshold)
       noexcept
-      { return this->m_threshold = threshold, *this;  }
+      { return this->m_threshold = this->m_base_threshold = threshold, *this;  }
+
+    bool
+    is_adaptive()
+      const noexcept
+      { return this->m_adaptive;  }
+
+    // If adaptive tuning is enabled, the threshold is adjusted after each cycle,
+    // according to the fraction of variables that have been collected. When it
+    // is disabled, the base threshold is restored.
+    Collector&
+    set_adaptive(bool adaptive)
+      noexcept
+      {
+        this->m_adaptive = adaptive;
+        this->m_threshold = this->m_base_threshold;
+        return *this;
+      }
+
+    uint32_t
+    get_slice_budget()
+      const noexcept
+      { return this->m_budget;  }
+
+    Collector&
+    set_slice_budget(uint32_t budget)
+      noexcept
+      { return this->m_budget = budget, *this;  }
 
     size_t
     count_tracked_variables()
       const noexcept
-      { return this->m_tracked.size();  }
+      { return this->m_tracked.size() + this->m_pending.size() + this->m_deferred.size();  }
+
+    size_t
+    count_pending_variables()
+      const noexcept
+      { return this->m_pending.size();  }
+
+    const Collector_Statistics&
+    get_statistics()
+      const noexcept
+      { return this->m_stats;  }
+
+    Collector&
+    clear_statistics()
+      noexcept
+      { return this->m_stats = Collector_Statistics(), *this;  }
+
+    // This is called when a variable is allocated from the pool instead of the
+    // heap, on behalf of this collector.
+    Collector&
+    note_reused_variable()
+      noexcept
+      { return this->m_stats.reused ++, *this;  }
 
     bool
     track_variable(const rcptr<Variable>& var);
@@ -76,6 +217,11 @@ class Collector
     Collector*
     collect_single_opt();
 
+    // Performs a slice of an incremental collection cycle, starting a new cycle
+    // if none is in progress. About `budget` variables are scanned.
+    Collector*
+    collect_slice_opt(size_t budget);
+
     void
     auto_collect();
 
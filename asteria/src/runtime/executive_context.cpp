@@ -3,6 +3,7 @@
 
 #include "../precompiled.hpp"
 #include "executive_context.hpp"
+#include "global_context.hpp"
 #include "runtime_error.hpp"
 #include "ptc_arguments.hpp"
 #include "enums.hpp"
@@ -20,14 +21,17 @@ Executive_Context(M_function, Global_Context& global, Reference_Stack& stack,
     m_global(&global), m_stack(&stack), m_alt_stack(&alt_stack),
     m_zvarg(zvarg)
   {
-    // Set the `this` reference.
-    // If the self reference is null, it is likely that `this` isn't ever referenced
-    // in this function, so perform lazy initialization to avoid this overhead.
+    // Reuse storage from previous calls, if any.
+    auto dict = global.acquire_reference_dictionary();
+    this->do_mut_named_references().swap(dict);
+
+    // Stash the `this` reference.
+    // It is not declared here, like other pre-defined references, so slot indices
+    // of parameters and local references match those assigned by the compiler.
     if(self.is_uninit() || self.is_void())
       ASTERIA_THROW("Invalid `this` reference passed to `$1`", zvarg->func());
 
-    if(!(self.is_temporary() && self.dereference_readonly().is_null()))
-      this->do_open_named_reference(nullptr, sref("__this")) = ::std::move(self);
+    this->m_self = ::std::move(self);
 
     // Set arguments. As arguments are evaluated from left to right, the reference at
     // the top is the last argument.
@@ -65,6 +69,10 @@ Executive_Context(M_function, Global_Context& global, Reference_Stack& stack,
 Executive_Context::
 ~Executive_Context()
   {
+    // Give storage back for reuse. Constant contexts are not associated with any
+    // global context.
+    if(this->m_global)
+      this->m_global->release_reference_dictionary(this->do_mut_named_references());
   }
 
 Reference*
@@ -83,10 +91,9 @@ do_create_lazy_reference(Reference* hint_opt, const phsh_string& name)
     }
 
     if(name == "__this") {
-      // Note: This can only happen inside a function context and the `this` argument
-      // is null.
+      // Note: This can only happen inside a function context.
       auto& ref = this->do_open_named_reference(hint_opt, name);
-      ref.set_temporary(nullopt);
+      ref = this->m_self;
       return &ref;
     }
 
@@ -25,6 +25,7 @@ class Executive_Context
     cow_bivector<Source_Location, AVMC_Queue> m_defer;
     rcptr<Variadic_Arguer> m_zvarg;
     cow_vector<Reference> m_lazy_args;
+    Reference m_self;
 
   public:
     // A plain context must have a parent context.
@@ -48,6 +49,15 @@ class Executive_Context
         m_defer(::std::move(defer))
       { }
 
+    // A constant context is used to evaluate constant expressions at compile time.
+    // It has no parent context or global context, so only nodes that have no side
+    // effects may be executed in it.
+    explicit
+    Executive_Context(M_constant, Reference_Stack& stack, Reference_Stack& alt_stack)
+      : m_parent_opt(),
+        m_global(), m_stack(&stack), m_alt_stack(&alt_stack)
+      { }
+
     // A function context has no parent.
     // The caller shall define a global context and evaluation stack, both of which
     // shall outlast this context.
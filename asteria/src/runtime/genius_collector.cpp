@@ -42,9 +42,11 @@ create_variable(GC_Generation gc_hint)
     auto& coll = this->*(this->do_locate(gc_hint));
 
     // Try allocating a variable from the pool.
-    auto var = this->m_pool.erase_random_opt();
+    auto var = this->m_pool.pop_opt();
     if(ROCKET_UNEXPECT(!var))
       var = ::rocket::make_refcnt<Variable>();
+    else
+      coll.note_reused_variable();
     coll.track_variable(var);
 
     // Mark it uninitialized.
@@ -52,17 +54,52 @@ create_variable(GC_Generation gc_hint)
     return var;
   }
 
+rcptr<Variable>
+Genius_Collector::
+create_untracked_variable()
+  {
+    // Try allocating a variable from the pool.
+    auto var = this->m_pool.pop_opt();
+    if(ROCKET_UNEXPECT(!var))
+      var = ::rocket::make_refcnt<Variable>();
+    else
+      this->m_newest.note_reused_variable();
+
+    // Mark it uninitialized.
+    var->uninitialize();
+    return var;
+  }
+
 size_t
 Genius_Collector::
 collect_variables(GC_Generation gc_limit)
   {
     // Collect variables from the newest generation to the oldest.
+    size_t nvars = 0;
     for(auto p = ::std::make_pair(&(this->m_newest), gc_limit + 1);
-          p.first && p.second;  p.first = p.first->get_tied_collector_opt(), p.second--)
+          p.first && p.second;  p.first = p.first->get_tied_collector_opt(), p.second--) {
+      uint64_t nfreed = p.first->get_statistics().freed;
       p.first->collect_single_opt();
+      nvars += static_cast<size_t>(p.first->get_statistics().freed - nfreed);
+    }
+
+    // Clear the variable pool.
+    this->m_pool.clear();
+    return nvars;
+  }
+
+size_t
+Genius_Collector::
+collect_variables_slice(GC_Generation gc_gen, size_t budget)
+  {
+    // Perform a slice on this generation only. If the next generation needs
+    // to be checked, it will be checked when it tracks more variables.
+    auto& coll = this->*(this->do_locate(gc_gen));
+    uint64_t nfreed = coll.get_statistics().freed;
+    coll.collect_slice_opt(budget);
+    size_t nvars = static_cast<size_t>(coll.get_statistics().freed - nfreed);
 
     // Clear the variable pool.
-    auto nvars = this->m_pool.size();
     this->m_pool.clear();
     return nvars;
   }
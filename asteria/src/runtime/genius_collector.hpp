@@ -6,7 +6,7 @@
 
 #include "../fwd.hpp"
 #include "collector.hpp"
-#include "../llds/variable_hashset.hpp"
+#include "../llds/variable_pool.hpp"
 
 namespace asteria {
 
@@ -16,7 +16,7 @@ class Genius_Collector
   {
   private:
     // Mind the order of construction and destruction.
-    Variable_HashSet m_pool;
+    Variable_Pool m_pool;
     Collector m_oldest;
     Collector m_middle;
     Collector m_newest;
@@ -25,9 +25,9 @@ class Genius_Collector
     explicit
     Genius_Collector()
       noexcept
-      : m_oldest(&(this->m_pool), nullptr, 10),
-        m_middle(&(this->m_pool), &(this->m_oldest), 60),
-        m_newest(&(this->m_pool), &(this->m_middle), 800)
+      : m_oldest(gc_generation_oldest, &(this->m_pool), nullptr, 10),
+        m_middle(gc_generation_middle, &(this->m_pool), &(this->m_oldest), 60),
+        m_newest(gc_generation_newest, &(this->m_pool), &(this->m_middle), 800)
       { }
 
   private:
@@ -43,6 +43,22 @@ class Genius_Collector
       const noexcept
       { return this->m_pool.size();  }
 
+    // Dead variables are retained for reallocation, up to this limit.
+    size_t
+    get_pool_limit()
+      const noexcept
+      { return this->m_pool.get_limit();  }
+
+    Genius_Collector&
+    set_pool_limit(uint32_t limit)
+      noexcept
+      { return this->m_pool.set_limit(limit), *this;  }
+
+    Genius_Collector&
+    trim_pool(size_t count)
+      noexcept
+      { return this->m_pool.trim(count), *this;  }
+
     Genius_Collector&
     clear_pool()
       noexcept
@@ -57,12 +73,42 @@ class Genius_Collector
     open_collector(GC_Generation gc_gen)
       { return this->*(this->do_locate(gc_gen));  }
 
+    // Enables or disables adaptive tuning of thresholds of all generations.
+    Genius_Collector&
+    set_adaptive(bool adaptive)
+      noexcept
+      {
+        this->m_oldest.set_adaptive(adaptive);
+        this->m_middle.set_adaptive(adaptive);
+        this->m_newest.set_adaptive(adaptive);
+        return *this;
+      }
+
+    // Sets hooks of all generations.
+    Genius_Collector&
+    set_hooks(const rcptr<Abstract_Hooks>& hooks_opt)
+      noexcept
+      {
+        this->m_oldest.set_hooks(hooks_opt);
+        this->m_middle.set_hooks(hooks_opt);
+        this->m_newest.set_hooks(hooks_opt);
+        return *this;
+      }
+
     rcptr<Variable>
     create_variable(GC_Generation gc_hint = gc_generation_newest);
 
+    // Variables that are created by this function are not tracked by any collector.
+    // They must not be involved in cycles, as such cycles cannot be broken.
+    rcptr<Variable>
+    create_untracked_variable();
+
     size_t
     collect_variables(GC_Generation gc_limit = gc_generation_oldest);
 
+    size_t
+    collect_variables_slice(GC_Generation gc_gen, size_t budget);
+
     Genius_Collector&
     wipe_out_variables()
       noexcept;
@@ -6,6 +6,8 @@
 #include "genius_collector.hpp"
 #include "random_engine.hpp"
 #include "loader_lock.hpp"
+#include "module_cache.hpp"
+#include "thread_pool.hpp"
 #include "variable.hpp"
 #include "abstract_hooks.hpp"
 #include "../library/version.hpp"
@@ -19,6 +21,7 @@
 #include "../library/filesystem.hpp"
 #include "../library/checksum.hpp"
 #include "../library/json.hpp"
+#include "../library/msgpack.hpp"
 #include "../library/io.hpp"
 #include "../utils.hpp"
 
@@ -45,6 +48,7 @@ constexpr s_modules[] =
     { api_version_0001_0000,  "filesystem",  create_bindings_filesystem  },
     { api_version_0001_0000,  "checksum",    create_bindings_checksum    },
     { api_version_0001_0000,  "json",        create_bindings_json        },
+    { api_version_0001_0000,  "msgpack",     create_bindings_msgpack     },
     { api_version_0001_0000,  "io",          create_bindings_io          },
   };
 
@@ -75,7 +79,9 @@ Global_Context::
 Global_Context(API_Version version)
   : m_gcoll(::rocket::make_refcnt<Genius_Collector>()),
     m_prng(::rocket::make_refcnt<Random_Engine>()),
-    m_ldrlk(::rocket::make_refcnt<Loader_Lock>())
+    m_ldrlk(::rocket::make_refcnt<Loader_Lock>()),
+    m_mcache(::rocket::make_refcnt<Module_Cache>()),
+    m_tpool(::rocket::make_refcnt<Thread_Pool>())
   {
     const auto gcoll = unerase_cast<Genius_Collector*>(this->m_gcoll);
     ROCKET_ASSERT(gcoll);
@@ -119,6 +125,19 @@ Global_Context::
     gcoll->wipe_out_variables();
   }
 
+Global_Context&
+Global_Context::
+set_hooks(rcptr<Abstract_Hooks> hooks_opt)
+  noexcept
+  {
+    const auto gcoll = unerase_cast<Genius_Collector*>(this->m_gcoll);
+    ROCKET_ASSERT(gcoll);
+
+    gcoll->set_hooks(hooks_opt);
+    this->m_qhooks = ::std::move(hooks_opt);
+    return *this;
+  }
+
 API_Version
 Global_Context::
 max_api_version()
@@ -6,6 +6,8 @@
 
 #include "../fwd.hpp"
 #include "abstract_context.hpp"
+#include "../llds/reference_stack.hpp"
+#include "../llds/reference_dictionary.hpp"
 #include "../recursion_sentry.hpp"
 
 namespace asteria {
@@ -20,8 +22,14 @@ class Global_Context
     rcfwdp<Genius_Collector> m_gcoll;
     rcfwdp<Random_Engine> m_prng;
     rcfwdp<Loader_Lock> m_ldrlk;
+    rcfwdp<Module_Cache> m_mcache;
+    rcfwdp<Thread_Pool> m_tpool;
     rcfwdp<Variable> m_vstd;
 
+    // These are pools of storage for function calls.
+    sso_vector<Reference_Stack, 64> m_stack_pool;
+    sso_vector<Reference_Dictionary, 64> m_dict_pool;
+
   public:
     // A global context has no parent.
     explicit
@@ -79,11 +87,10 @@ class Global_Context
       const noexcept
       { return unerase_pointer_cast<Abstract_Hooks>(this->m_qhooks);  }
 
-    ASTERIA_INCOMPLET(Abstract_Hooks)
+    // The hooks are also installed into the garbage collector.
     Global_Context&
     set_hooks(rcptr<Abstract_Hooks> hooks_opt)
-      noexcept
-      { return this->m_qhooks = ::std::move(hooks_opt), *this;  }
+      noexcept;
 
     // These are interfaces for individual global components.
     ASTERIA_INCOMPLET(Genius_Collector)
@@ -104,12 +111,77 @@ class Global_Context
       const noexcept
       { return unerase_pointer_cast<Loader_Lock>(this->m_ldrlk);  }
 
+    ASTERIA_INCOMPLET(Module_Cache)
+    rcptr<Module_Cache>
+    module_cache()
+      const noexcept
+      { return unerase_pointer_cast<Module_Cache>(this->m_mcache);  }
+
+    ASTERIA_INCOMPLET(Thread_Pool)
+    rcptr<Thread_Pool>
+    thread_pool()
+      const noexcept
+      { return unerase_pointer_cast<Thread_Pool>(this->m_tpool);  }
+
     ASTERIA_INCOMPLET(Variable)
     rcptr<Variable>
     std_variable()
       const noexcept
       { return unerase_pointer_cast<Variable>(this->m_vstd);  }
 
+    // These functions lend storage to function calls, which shall be given back
+    // when calls return, so plain calls don't allocate memory in the steady state.
+    // Storage that is not given back (e.g. due to exceptions) is simply freed.
+    Reference_Stack
+    acquire_reference_stack()
+      noexcept
+      {
+        Reference_Stack stack;
+        if(this->m_stack_pool.size()) {
+          stack.swap(this->m_stack_pool.mut_back());
+          this->m_stack_pool.pop_back();
+        }
+        return stack;
+      }
+
+    Global_Context&
+    release_reference_stack(Reference_Stack& stack)
+      noexcept
+      {
+        if(!stack.bottom() || (this->m_stack_pool.size() == this->m_stack_pool.capacity()))
+          return *this;
+
+        // References must not outlive calls.
+        stack.clear_cache();
+        this->m_stack_pool.emplace_back().swap(stack);
+        return *this;
+      }
+
+    Reference_Dictionary
+    acquire_reference_dictionary()
+      noexcept
+      {
+        Reference_Dictionary dict;
+        if(this->m_dict_pool.size()) {
+          dict.swap(this->m_dict_pool.mut_back());
+          this->m_dict_pool.pop_back();
+        }
+        return dict;
+      }
+
+    Global_Context&
+    release_reference_dictionary(Reference_Dictionary& dict)
+      noexcept
+      {
+        if(!dict.capacity() || (this->m_dict_pool.size() == this->m_dict_pool.capacity()))
+          return *this;
+
+        // References must not outlive scopes.
+        dict.clear();
+        this->m_dict_pool.emplace_back().swap(dict);
+        return *this;
+      }
+
     // Get the maximum API version that is supported when this library is built.
     // N.B. This function must not be inlined for this reason.
     API_Version
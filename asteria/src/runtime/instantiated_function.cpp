@@ -48,8 +48,26 @@ Instantiated_Function::
 invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stack)
   const
   {
-    // Create the stack and context for this function.
-    Reference_Stack alt_stack;
+    // The stack for nested calls is borrowed from the global context.
+    auto alt_stack = global.acquire_reference_stack();
+    try {
+      this->invoke_ptc_aware(self, global, ::std::move(stack), alt_stack);
+    }
+    catch(...) {
+      global.release_reference_stack(alt_stack);
+      throw;
+    }
+    global.release_reference_stack(alt_stack);
+    return self;
+  }
+
+Reference&
+Instantiated_Function::
+invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stack,
+                 Reference_Stack& alt_stack)
+  const
+  {
+    // Create the context for this function.
     Executive_Context ctx_func(Executive_Context::M_function(), global, stack,
                                alt_stack, this->m_zvarg, this->m_params, ::std::move(self));
     AIR_Status status;
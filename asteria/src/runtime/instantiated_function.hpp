@@ -43,6 +43,13 @@ class Instantiated_Function
     Reference&
     invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stack)
       const override;
+
+    // This is the same as the function above, except that the stack for nested
+    // calls is provided by the caller, so it can be reused by repeated calls.
+    Reference&
+    invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stack,
+                     Reference_Stack& alt_stack)
+      const;
   };
 
 }  // namespace asteria
@@ -0,0 +1,99 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "module_cache.hpp"
+#include "../utils.hpp"
+#include <sys/stat.h>
+#include <unistd.h>  // ::fstat()
+
+namespace asteria {
+namespace {
+
+bool
+do_compare_options(const Compiler_Options& lhs, const Compiler_Options& rhs)
+  noexcept
+  {
+    // All members are single bytes, so there is no padding.
+    static_assert(::std::is_trivially_copyable<Compiler_Options>::value, "");
+    return ::std::memcmp(&lhs, &rhs, sizeof(Compiler_Options)) == 0;
+  }
+
+}  // namespace
+
+Module_Cache::
+~Module_Cache()
+  {
+  }
+
+Module_Cache::Entry
+Module_Cache::
+do_make_entry(const cow_string& path, int fd, const Compiler_Options& opts)
+  {
+    struct ::stat info;
+    if(::fstat(fd, &info))
+      ASTERIA_THROW("Could not get information about script file '$2'\n"
+                    "[`fstat()` failed: $1]",
+                    format_errno(errno), path);
+
+    Entry entry;
+    entry.dev = static_cast<uint64_t>(info.st_dev);
+    entry.ino = static_cast<uint64_t>(info.st_ino);
+    entry.size = static_cast<int64_t>(info.st_size);
+    entry.mtime_sec = static_cast<int64_t>(info.st_mtim.tv_sec);
+    entry.mtime_nsec = static_cast<int64_t>(info.st_mtim.tv_nsec);
+    entry.opts = opts;
+    return entry;
+  }
+
+cow_function
+Module_Cache::
+get_function_opt(const cow_string& path, int fd, const Compiler_Options& opts)
+  const
+  {
+    auto qent = this->m_entries.find(path);
+    if(qent == this->m_entries.end())
+      return nullptr;
+
+    // Check whether the file has been modified.
+    auto cur = do_make_entry(path, fd, opts);
+    const auto& old = qent->second;
+    if((cur.dev != old.dev) || (cur.ino != old.ino) || (cur.size != old.size) ||
+       (cur.mtime_sec != old.mtime_sec) || (cur.mtime_nsec != old.mtime_nsec))
+      return nullptr;
+
+    if(!do_compare_options(cur.opts, old.opts))
+      return nullptr;
+
+    return old.target;
+  }
+
+Module_Cache&
+Module_Cache::
+set_function(const cow_string& path, int fd, const Compiler_Options& opts,
+             const cow_function& target)
+  {
+    auto entry = do_make_entry(path, fd, opts);
+    entry.target = target;
+    this->m_entries.insert_or_assign(path, ::std::move(entry));
+    return *this;
+  }
+
+size_t
+Module_Cache::
+invalidate(const cow_string& path)
+  {
+    return this->m_entries.erase(path);
+  }
+
+size_t
+Module_Cache::
+clear()
+  noexcept
+  {
+    size_t count = this->m_entries.size();
+    this->m_entries.clear();
+    return count;
+  }
+
+}  // namespace asteria
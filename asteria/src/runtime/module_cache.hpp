@@ -0,0 +1,77 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_MODULE_CACHE_HPP_
+#define ASTERIA_RUNTIME_MODULE_CACHE_HPP_
+
+#include "../fwd.hpp"
+
+namespace asteria {
+
+class Module_Cache
+  final
+  : public Rcfwd<Module_Cache>
+  {
+  private:
+    struct Entry
+      {
+        // These identify a particular revision of a file.
+        uint64_t dev;
+        uint64_t ino;
+        int64_t size;
+        int64_t mtime_sec;
+        int64_t mtime_nsec;
+
+        // Scripts compiled with different options are distinct.
+        Compiler_Options opts;
+        cow_function target;
+      };
+
+    cow_dictionary<Entry> m_entries;
+
+  public:
+    explicit
+    Module_Cache()
+      noexcept
+      { }
+
+  private:
+    static
+    Entry
+    do_make_entry(const cow_string& path, int fd, const Compiler_Options& opts);
+
+  public:
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(Module_Cache);
+
+    size_t
+    size()
+      const noexcept
+      { return this->m_entries.size();  }
+
+    // Get the function that has been compiled from the file `path`. `fd` shall
+    // be an open file descriptor of it. If the file has been modified since it
+    // was cached, or it was compiled with different options, a null pointer is
+    // returned.
+    cow_function
+    get_function_opt(const cow_string& path, int fd, const Compiler_Options& opts)
+      const;
+
+    // Store a function that has been compiled from the file `path`, replacing
+    // any existing one.
+    Module_Cache&
+    set_function(const cow_string& path, int fd, const Compiler_Options& opts,
+                 const cow_function& target);
+
+    // These functions remove cached functions, so the next `import` of these
+    // files will compile them again. The number of entries removed is returned.
+    size_t
+    invalidate(const cow_string& path);
+
+    size_t
+    clear()
+      noexcept;
+  };
+
+}  // namespace asteria
+
+#endif
@@ -0,0 +1,54 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "prepared_call.hpp"
+#include "instantiated_function.hpp"
+#include "global_context.hpp"
+#include "../utils.hpp"
+
+namespace asteria {
+
+Prepared_Call::
+Prepared_Call(Global_Context& global, const cow_function& target)
+  : m_global(&global), m_target(target),
+    m_inst_opt(target.get_opt<Instantiated_Function>())
+  {
+    // Borrow a stack for nested calls for the lifetime of this object, if
+    // it will be used at all.
+    if(this->m_inst_opt)
+      this->m_alt_stack = global.acquire_reference_stack();
+  }
+
+Prepared_Call::
+~Prepared_Call()
+  {
+    this->m_global->release_reference_stack(this->m_alt_stack);
+  }
+
+Reference&
+Prepared_Call::
+invoke()
+  {
+    // The `this` reference is always `null`.
+    this->m_self.set_temporary(nullopt);
+
+    try {
+      if(this->m_inst_opt)
+        this->m_inst_opt->invoke_ptc_aware(this->m_self, *(this->m_global),
+                                           ::std::move(this->m_stack), this->m_alt_stack);
+      else
+        this->m_target.invoke_ptc_aware(this->m_self, *(this->m_global),
+                                        ::std::move(this->m_stack));
+    }
+    catch(...) {
+      this->m_stack.clear();
+      throw;
+    }
+    this->m_stack.clear();
+
+    // Unpack proper tail calls, if any.
+    return this->m_self.finish_call(*(this->m_global));
+  }
+
+}  // namespace asteria
@@ -0,0 +1,57 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_PREPARED_CALL_HPP_
+#define ASTERIA_RUNTIME_PREPARED_CALL_HPP_
+
+#include "../fwd.hpp"
+#include "reference.hpp"
+#include "../llds/reference_stack.hpp"
+
+namespace asteria {
+
+// This is used by native functions that call a function repeatedly, such as
+// comparators and predicators. Stacks are set up once and reused by all calls.
+// If the target is a script function, it is invoked directly, bypassing the
+// stack pool of the global context.
+class Prepared_Call
+  {
+  private:
+    Global_Context* m_global;
+    cow_function m_target;
+    rcptr<const Instantiated_Function> m_inst_opt;
+
+    Reference_Stack m_stack;
+    Reference_Stack m_alt_stack;  // for nested calls
+    Reference m_self;
+
+  public:
+    explicit
+    Prepared_Call(Global_Context& global, const cow_function& target);
+
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(Prepared_Call);
+
+    const cow_function&
+    target()
+      const noexcept
+      { return this->m_target;  }
+
+    // Arguments are pushed from left to right. They are consumed by the next
+    // call to `invoke()`.
+    template<typename XValT>
+    Prepared_Call&
+    push_argument(XValT&& xval)
+      {
+        this->m_stack.emplace_back_uninit().set_temporary(::std::forward<XValT>(xval));
+        return *this;
+      }
+
+    // Calls the target function with arguments that have been pushed, and
+    // returns a reference to its result, which is valid until the next call.
+    Reference&
+    invoke();
+  };
+
+}  // namespace asteria
+
+#endif
@@ -216,6 +216,9 @@ dereference_mutable()
         if(!qvar->is_initialized())
           ASTERIA_THROW("Attempt to read from an uninitialized variable");
 
+        if(qvar->is_immutable())
+          ASTERIA_THROW("Attempt to modify a `const` variable `$1`", qvar->get_value());
+
         qval = &(qvar->open_value());
         break;
       }
@@ -264,6 +267,9 @@ dereference_unset()
         if(!qvar->is_initialized())
           ASTERIA_THROW("Attempt to read from an uninitialized variable");
 
+        if(qvar->is_immutable())
+          ASTERIA_THROW("Attempt to modify a `const` variable `$1`", qvar->get_value());
+
         qval = &(qvar->open_value());
         break;
       }
@@ -0,0 +1,145 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "thread_pool.hpp"
+#include "../utils.hpp"
+#include <signal.h>  // ::sigfillset()
+
+namespace asteria {
+
+Thread_Pool::
+~Thread_Pool()
+  {
+    this->do_join_workers();
+  }
+
+void*
+Thread_Pool::
+do_worker_thread(void* param)
+  {
+    auto tpool = static_cast<Thread_Pool*>(param);
+    ::rocket::mutex::unique_lock lock(tpool->m_mutex);
+    for(;;) {
+      tpool->m_avail.wait(lock,
+          [&] { return tpool->m_stop || (tpool->m_batch &&
+                         (tpool->m_batch->next != tpool->m_batch->ntasks));  });
+
+      if(tpool->m_stop)
+        return nullptr;
+
+      tpool->do_run_batch(lock, *(tpool->m_batch));
+    }
+  }
+
+void
+Thread_Pool::
+do_spawn_workers(::rocket::mutex::unique_lock& lock)
+  noexcept
+  {
+    ROCKET_ASSERT(lock.is_locking(this->m_mutex));
+
+    // Signals shall be delivered to the calling thread.
+    ::sigset_t sigset, sigset_old;
+    ::sigfillset(&sigset);
+    ::pthread_sigmask(SIG_SETMASK, &sigset, &sigset_old);
+
+    while(this->m_workers.size() < this->m_nthreads) {
+      // If a thread can't be created, work with existent ones.
+      ::pthread_t thr;
+      if(::pthread_create(&thr, nullptr, do_worker_thread, this) != 0)
+        break;
+
+      this->m_workers.emplace_back(thr);
+    }
+    ::pthread_sigmask(SIG_SETMASK, &sigset_old, nullptr);
+  }
+
+void
+Thread_Pool::
+do_join_workers()
+  noexcept
+  {
+    ::rocket::mutex::unique_lock lock(this->m_mutex);
+    ROCKET_ASSERT(!this->m_batch);
+    this->m_stop = true;
+    this->m_avail.notify_all();
+    lock.unlock();
+
+    for(auto thr : this->m_workers)
+      ::pthread_join(thr, nullptr);
+
+    lock.lock(this->m_mutex);
+    this->m_workers.clear();
+    this->m_stop = false;
+  }
+
+void
+Thread_Pool::
+do_run_batch(::rocket::mutex::unique_lock& lock, Batch& batch)
+  noexcept
+  {
+    ROCKET_ASSERT(lock.is_locking(this->m_mutex));
+
+    while(batch.next != batch.ntasks) {
+      size_t index = batch.next++;
+      lock.unlock();
+
+      ::std::exception_ptr eptr;
+      try {
+        batch.func(batch.param, index);
+      }
+      catch(...) {
+        eptr = ::std::current_exception();
+      }
+
+      // Only the first exception is kept.
+      lock.lock(this->m_mutex);
+      if(eptr && !batch.eptr)
+        batch.eptr = ::std::move(eptr);
+
+      if(++(batch.ndone) == batch.ntasks)
+        this->m_done.notify_all();
+    }
+  }
+
+Thread_Pool&
+Thread_Pool::
+set_thread_count(uint32_t nthreads)
+  noexcept
+  {
+    this->do_join_workers();
+    this->m_nthreads = nthreads;
+    return *this;
+  }
+
+void
+Thread_Pool::
+run_tasks(size_t ntasks, task_callback* func, void* param)
+  {
+    if(ntasks == 0)
+      return;
+
+    Batch batch;
+    batch.func = func;
+    batch.param = param;
+    batch.ntasks = ntasks;
+
+    ::rocket::mutex::unique_lock lock(this->m_mutex);
+    ROCKET_ASSERT(!this->m_batch);
+    this->do_spawn_workers(lock);
+
+    // Publish this batch, and join workers.
+    this->m_batch = &batch;
+    this->m_avail.notify_all();
+    this->do_run_batch(lock, batch);
+
+    this->m_done.wait(lock, [&] { return batch.ndone == batch.ntasks;  });
+    this->m_batch = nullptr;
+    lock.unlock();
+
+    if(batch.eptr)
+      ::std::rethrow_exception(batch.eptr);
+  }
+
+}  // namespace asteria
@@ -0,0 +1,116 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_THREAD_POOL_HPP_
+#define ASTERIA_RUNTIME_THREAD_POOL_HPP_
+
+#include "../fwd.hpp"
+#include "../../rocket/mutex.hpp"
+#include "../../rocket/condition_variable.hpp"
+
+namespace asteria {
+
+class Thread_Pool
+  final
+  : public Rcfwd<Thread_Pool>
+  {
+  public:
+    // A task is identified by its index in a batch.
+    using task_callback  = void (void* param, size_t index);
+
+  private:
+    struct Batch
+      {
+        task_callback* func;
+        void* param;
+        size_t ntasks;
+        size_t next = 0;
+        size_t ndone = 0;
+        ::std::exception_ptr eptr;
+      };
+
+    ::rocket::mutex m_mutex;
+    ::rocket::condition_variable m_avail;
+    ::rocket::condition_variable m_done;
+    cow_vector<::pthread_t> m_workers;
+    Batch* m_batch = nullptr;
+    bool m_stop = false;
+
+    // Workers are created lazily. Zero means operations are performed
+    // on the calling thread only.
+    uint32_t m_nthreads = 0;
+    uint32_t m_cutoff = 100000;
+
+  public:
+    explicit
+    Thread_Pool()
+      noexcept
+      { }
+
+  private:
+    static
+    void*
+    do_worker_thread(void* param);
+
+    void
+    do_spawn_workers(::rocket::mutex::unique_lock& lock)
+      noexcept;
+
+    void
+    do_join_workers()
+      noexcept;
+
+    void
+    do_run_batch(::rocket::mutex::unique_lock& lock, Batch& batch)
+      noexcept;
+
+  public:
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(Thread_Pool);
+
+    uint32_t
+    get_thread_count()
+      const noexcept
+      { return this->m_nthreads;  }
+
+    // Existent workers are stopped. New workers will be created when
+    // the next batch is run.
+    Thread_Pool&
+    set_thread_count(uint32_t nthreads)
+      noexcept;
+
+    // This is the minimum number of elements for an operation to be
+    // performed in parallel.
+    uint32_t
+    get_cutoff()
+      const noexcept
+      { return this->m_cutoff;  }
+
+    Thread_Pool&
+    set_cutoff(uint32_t cutoff)
+      noexcept
+      { return this->m_cutoff = cutoff, *this;  }
+
+    bool
+    should_parallelize(size_t nelems)
+      const noexcept
+      { return (this->m_nthreads != 0) && (nelems >= this->m_cutoff);  }
+
+    // Calls `func(param, index)` for each `index` in [0,ntasks) on workers and
+    // the calling thread, then waits for all tasks to complete. If any task
+    // throws an exception, one of them is rethrown. Batches shall not nest.
+    void
+    run_tasks(size_t ntasks, task_callback* func, void* param);
+
+    template<typename FuncT>
+    void
+    run_tasks(size_t ntasks, FuncT&& func)
+      {
+        this->run_tasks(ntasks,
+            [](void* param, size_t index) { (*static_cast<FuncT*>(param))(index);  },
+            ::std::addressof(func));
+      }
+  };
+
+}  // namespace asteria
+
+#endif
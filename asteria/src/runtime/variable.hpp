@@ -26,6 +26,10 @@ class Variable
     bool m_gc_mark;
     long m_gc_ref;
 
+    // This is set when a collector has not decided whether to track this
+    // variable. Such variables are ignored by cycle detection.
+    bool m_gc_deferred = false;
+
   public:
     explicit
     Variable()
@@ -102,6 +106,16 @@ class Variable
         return m;
       }
 
+    bool
+    is_gc_deferred()
+      const noexcept
+      { return this->m_gc_deferred;  }
+
+    Variable&
+    set_gc_deferred(bool deferred)
+      noexcept
+      { return this->m_gc_deferred = deferred, *this;  }
+
     Variable_Callback&
     enumerate_variables_descent(Variable_Callback& callback)
       const;
@@ -11,4 +11,11 @@ Variable_Callback::
   {
   }
 
+bool
+Variable_Callback::
+do_process_shared(const Value& /*value*/, const void* /*key*/, long /*nref*/)
+  {
+    return true;
+  }
+
 }  // namespace asteria
@@ -20,6 +20,14 @@ class Variable_Callback
     do_process_one(const rcptr<Variable>& var)
       = 0;
 
+    // This is called before the children of a shared value (an array, object,
+    // function or opaque value) are enumerated. `key` identifies its storage
+    // and `nref` is its reference count. The return value indicates whether
+    // to enumerate its children. The default implementation returns `true`.
+    virtual
+    bool
+    do_process_shared(const Value& value, const void* key, long nref);
+
   public:
     virtual
     ~Variable_Callback();
@@ -32,6 +40,10 @@ class Variable_Callback
         return *this;
       }
 
+    bool
+    process_shared(const Value& value, const void* key, long nref)
+      { return this->do_process_shared(value, key, nref);  }
+
     template<typename ContainerT>
     Variable_Callback&
     operator()(ContainerT& cont)
@@ -13,24 +13,43 @@
 
 namespace asteria {
 
-Simple_Script&
-Simple_Script::
-reload(const cow_string& name, int line, tinybuf& cbuf)
+namespace {
+
+void
+do_load_code(AIR_Optimizer& optmz, const cow_vector<phsh_string>& params,
+             const cow_string& name, int line, tinybuf& cbuf)
   {
+    // Load bytecode if it has been compiled already.
+    if(AIR_Optimizer::is_bytecode(cbuf)) {
+      optmz.deserialize(cbuf);
+      return;
+    }
+
     // Parse source code.
-    Token_Stream tstrm(this->m_opts);
+    Token_Stream tstrm(optmz.get_options());
     tstrm.reload(name, line, cbuf);
 
-    Statement_Sequence stmtq(this->m_opts);
+    Statement_Sequence stmtq(optmz.get_options());
     stmtq.reload(tstrm);
 
-    // Instantiate the function.
-    const Source_Location sloc(name, 0, 0);
+    // Generate code.
+    optmz.reload(nullptr, params, stmtq);
+  }
+
+}  // namespace
+
+Simple_Script&
+Simple_Script::
+reload(const cow_string& name, int line, tinybuf& cbuf)
+  {
     if(ROCKET_UNEXPECT(this->m_params.empty()))
       this->m_params.emplace_back(sref("..."));
 
     AIR_Optimizer optmz(this->m_opts);
-    optmz.reload(nullptr, this->m_params, stmtq);
+    do_load_code(optmz, this->m_params, name, line, cbuf);
+
+    // Instantiate the function.
+    const Source_Location sloc(name, 0, 0);
     this->m_func = optmz.create_function(sloc, sref("[file scope]"));
     return *this;
   }
@@ -85,6 +104,37 @@ reload_file(const char* path)
     return this->reload(cow_string(abspath), 1, cbuf);
   }
 
+const Simple_Script&
+Simple_Script::
+compile(tinybuf& obuf, const cow_string& name, int line, tinybuf& cbuf)
+  const
+  {
+    const cow_vector<phsh_string> params(1, sref("..."));
+
+    AIR_Optimizer optmz(this->m_opts);
+    do_load_code(optmz, params, name, line, cbuf);
+    optmz.serialize(obuf);
+    return *this;
+  }
+
+const Simple_Script&
+Simple_Script::
+compile_file(tinybuf& obuf, const char* path)
+  const
+  {
+    // Resolve the path to an absolute one.
+    auto abspath = ::rocket::make_unique_handle(::realpath(path, nullptr), ::free);
+    if(!abspath)
+      ASTERIA_THROW("Could not open script file '$2'\n"
+                    "[`realpath()` failed: $1]",
+                    format_errno(errno), path);
+
+    // Open the file denoted by this path.
+    ::rocket::tinybuf_file cbuf;
+    cbuf.open(abspath, tinybuf::open_read);
+    return this->compile(obuf, cow_string(abspath), 1, cbuf);
+  }
+
 Reference
 Simple_Script::
 execute(Global_Context& global, Reference_Stack&& stack)
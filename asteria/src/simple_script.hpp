@@ -82,7 +82,8 @@ class Simple_Script
       const noexcept
       { return this->m_func;  }
 
-    // Load a script.
+    // Load a script. If the stream starts with bytecode, it is loaded instead of
+    // being parsed.
     Simple_Script&
     reload(const cow_string& name, int line, tinybuf& cbuf);
 
@@ -101,6 +102,16 @@ class Simple_Script
     Simple_Script&
     reload_file(const char* path);
 
+    // Compile a script into bytecode and write it into `obuf`, which can be
+    // loaded later. The script that has been loaded is not affected.
+    const Simple_Script&
+    compile(tinybuf& obuf, const cow_string& name, int line, tinybuf& cbuf)
+      const;
+
+    const Simple_Script&
+    compile_file(tinybuf& obuf, const char* path)
+      const;
+
     // Execute the script that has been loaded.
     Reference
     execute(Global_Context& global, Reference_Stack&& stack)
@@ -81,6 +81,14 @@ do_xstrerror_r(int errnum, char *strerrbuf, size_t buflen)
                strerrbuf);
   }
 
+constexpr
+int
+do_normalize_fwide(int wide)
+  noexcept
+  {
+    return (wide == 0) ? 0 : ((wide >> (WORD_BIT - 1)) | 1);
+  }
+
 }  // namespace
 
 namespace details_utils {
@@ -441,6 +449,23 @@ wrap_index(int64_t index, size_t size)
     return w;
   }
 
+bool
+set_file_orientation(::FILE* fp, const char* mode, int wide)
+  {
+    // Get the current orientation.
+    int wcomp = do_normalize_fwide(wide);
+    if(do_normalize_fwide(::fwide(fp, wide)) != wcomp) {
+      // Clear the current orientation and try resetting it.
+      // XXX: Is it safe to do so when the file has been locked?
+      if(!::freopen(nullptr, mode, fp))
+        ::abort();
+
+      if(do_normalize_fwide(::fwide(fp, wide)) != wcomp)
+        return false;
+    }
+    return true;
+  }
+
 uint64_t
 generate_random_seed()
   noexcept
@@ -174,6 +174,12 @@ Wrapped_Index
 wrap_index(int64_t index, size_t size)
   noexcept;
 
+// Sets the orientation of a standard I/O stream, which is byte-oriented if
+// `wide` is negative, or wide-oriented if `wide` is positive. If the stream
+// has another orientation, it is reopened with `mode`.
+bool
+set_file_orientation(::FILE* fp, const char* mode, int wide);
+
 // Note that all bits in the result are filled.
 uint64_t
 generate_random_seed()
@@ -3,6 +3,7 @@
 
 #include "precompiled.hpp"
 #include "value.hpp"
+#include "runtime/variable_callback.hpp"
 #include "utils.hpp"
 
 namespace asteria {
@@ -335,21 +336,47 @@ enumerate_variables(Variable_Callback& callback)
       case type_string:
         return callback;
 
-      case type_opaque:
-        return this->m_stor.as<type_opaque>().enumerate_variables(callback);
+      case type_opaque: {
+        const auto& altr = this->m_stor.as<type_opaque>();
+        if((altr.use_count() > 1) && !callback.process_shared(*this, altr.get_ptr_opt(), altr.use_count()))
+          return callback;
 
-      case type_function:
-        return this->m_stor.as<type_function>().enumerate_variables(callback);
+        return altr.enumerate_variables(callback);
+      }
 
-      case type_array:
-        ::rocket::for_each(this->m_stor.as<type_array>(),
+      case type_function: {
+        const auto& altr = this->m_stor.as<type_function>();
+        if((altr.use_count() > 1) && !callback.process_shared(*this, altr.get_ptr_opt(), altr.use_count()))
+          return callback;
+
+        return altr.enumerate_variables(callback);
+      }
+
+      case type_array: {
+        const auto& altr = this->m_stor.as<type_array>();
+        if(altr.empty())
+          return callback;
+
+        if((altr.use_count() > 1) && !callback.process_shared(*this, altr.data(), altr.use_count()))
+          return callback;
+
+        ::rocket::for_each(altr,
             [&](const auto& val) { val.enumerate_variables(callback);  });
         return callback;
+      }
 
-      case type_object:
-        ::rocket::for_each(this->m_stor.as<type_object>(),
+      case type_object: {
+        const auto& altr = this->m_stor.as<type_object>();
+        if(altr.empty())
+          return callback;
+
+        if((altr.use_count() > 1) && !callback.process_shared(*this, &*(altr.begin()), altr.use_count()))
+          return callback;
+
+        ::rocket::for_each(altr,
             [&](const auto& pair) { pair.second.enumerate_variables(callback);  });
         return callback;
+      }
 
       default:
         ASTERIA_TERMINATE("invalid value type (type `$1`)", this->type());
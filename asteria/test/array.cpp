@@ -204,6 +204,18 @@ int main()
         assert std.array.sort(["abb","baa","aaa","bbb","aba","bab","aab","bba"], func(x, y) = std.string.compare(x, y, 2))
                            == ["aaa","aab","abb","aba","baa","bab","bbb","bba"];
 
+        assert std.array.sort([3,std.numeric.integer_max,-1,0,std.numeric.integer_min,-300,70000])
+                           == [std.numeric.integer_min,-300,-1,0,3,70000,std.numeric.integer_max];
+        assert std.array.sort([2.5,-infinity,1.0e100,-0.0,0.0,-1.0e-300,infinity])
+                           == [-infinity,-1.0e-300,0,0,2.5,1.0e100,infinity];
+        assert std.array.sort([3,1.5,2]) == [1.5,2,3];
+        var zeroes = std.array.sort([0.0,1.0,-0.0,-1.0,-0.0,0.0]);
+        assert zeroes == [-1.0,0.0,0.0,0.0,0.0,1.0];
+        assert [std.numeric.sign(zeroes[1]),std.numeric.sign(zeroes[2]),std.numeric.sign(zeroes[3]),
+                std.numeric.sign(zeroes[4])] == [0,-1,-1,0];
+        try { std.array.sort([1.0,nan,2.0]);  assert false;  }
+          catch(e) { assert std.string.find(e, "Assertion failure") == null;  }
+
         assert std.array.sortu([17,13,14,11,16,18,10,15,12,19])
                             == [10,11,12,13,14,15,16,17,18,19];
         assert std.array.sortu([32,14,11,22,21,34,31,13,23,24,12,33], func(x, y) = (x % 10 <=> y % 10))
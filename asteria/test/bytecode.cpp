@@ -0,0 +1,82 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/reference.hpp"
+#include "../src/value.hpp"
+#include "../rocket/tinybuf_str.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str src;
+    src.set_string(sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+      const k = 10 * 4;
+      func fib(n) { return n <= 1 ? n : fib(n - 1) + fib(n - 2);  }
+
+      var s = 0;
+      for(var i = 0;  i < 10;  ++i)
+        if(i % 2 == 0)
+          s += i;
+
+      var o = { a: [ 1, 2.5, "x", null, true ], b: k };
+      switch(s) {
+        case 20:
+          s = "twenty";
+          break;
+        default:
+          s = "?";
+      }
+
+      try {
+        throw "meow";
+      }
+      catch(e)
+        assert e == "meow";
+
+      var [ p, q ] = [ 1, 2 ];
+      var { a } = o;
+      while(p < 5)
+        ++p;
+
+      for(each key, val -> o)
+        assert o[key] == val;
+
+      return std.string.format("$1 $2 $3 $4 $5 $6", fib(15), s, o.b, p, a[1], __varg(0));
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    // Compile the script into bytecode.
+    Simple_Script code;
+    ::rocket::tinybuf_str obuf(tinybuf::open_write);
+    code.compile(obuf, sref(__FILE__), __LINE__, src);
+    ASTERIA_TEST_CHECK(!code);
+
+    auto bytes = obuf.get_string();
+    ASTERIA_TEST_CHECK(bytes.size() > 8);
+    ASTERIA_TEST_CHECK(bytes[0] == '\x7F');
+
+    // Load and execute it.
+    ::rocket::tinybuf_str ibuf(bytes, tinybuf::open_read);
+    code.reload(sref("bytecode"), 1, ibuf);
+    ASTERIA_TEST_CHECK(code);
+
+    Global_Context global;
+    auto ref = code.execute(global, { sref("meow") });
+    ASTERIA_TEST_CHECK(ref.dereference_readonly().as_string() == "610 twenty 40 5 2.5 meow");
+
+    // Truncated or corrupted bytecode shall be rejected.
+    ibuf.set_string(cow_string(bytes.data(), bytes.size() / 2), tinybuf::open_read);
+    ASTERIA_TEST_CHECK_CATCH(code.reload(sref("bytecode"), 1, ibuf));
+
+    auto corrupted = bytes;
+    corrupted.mut(8) = '\x7F';
+    ibuf.set_string(corrupted, tinybuf::open_read);
+    ASTERIA_TEST_CHECK_CATCH(code.reload(sref("bytecode"), 1, ibuf));
+  }
@@ -0,0 +1,91 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/reference.hpp"
+#include "../src/value.hpp"
+#include "../rocket/tinybuf_str.hpp"
+
+using namespace asteria;
+
+namespace {
+
+bool
+do_load_and_execute(const cow_string& bytes)
+  {
+    Simple_Script code;
+    ::rocket::tinybuf_str ibuf(bytes, tinybuf::open_read);
+    try {
+      code.reload(sref("mutated"), 1, ibuf);
+    }
+    catch(exception& stdex) {
+      return false;
+    }
+
+    // The code may be valid but do something else. It must not crash.
+    Global_Context global;
+    try {
+      code.execute(global);
+    }
+    catch(exception& stdex) {
+    }
+    return true;
+  }
+
+}  // namespace
+
+int main()
+  {
+    // This script shall not contain loops, as mutations of conditions may make
+    // them infinite.
+    ::rocket::tinybuf_str src;
+    src.set_string(sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+      var a = 1, b = 2;
+      func add(x, y) { return x + y + a;  }
+
+      if(a < b) {
+        var c = [ a, b, { k: "meow" } ];
+        try {
+          switch(b) {
+            default:
+              c = null;
+            case 2:
+              c[0] = add(b, c[1]);
+              break;
+          }
+          throw c;
+        }
+        catch(e)
+          b = e[0] * a ?? 3;
+      }
+      return [ a, b ];
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code;
+    ::rocket::tinybuf_str obuf(tinybuf::open_write);
+    code.compile(obuf, sref(__FILE__), __LINE__, src);
+    auto bytes = obuf.get_string();
+
+    // The original bytecode shall be loaded.
+    ASTERIA_TEST_CHECK(do_load_and_execute(bytes));
+
+    // Truncated bytecode shall be rejected. An empty string is not bytecode, but
+    // an empty script.
+    for(size_t k = 1;  k != bytes.size();  ++k)
+      ASTERIA_TEST_CHECK(!do_load_and_execute(cow_string(bytes.data(), k)));
+
+    // Corrupted bytecode shall be either rejected or executed safely.
+    static constexpr unsigned char masks[] = { 0x01, 0x02, 0x04, 0x07, 0x40, 0x80, 0xFF };
+    for(size_t k = 0;  k != bytes.size();  ++k)
+      for(unsigned char mask : masks) {
+        auto mutated = bytes;
+        mutated.mut(k) = static_cast<char>(mutated[k] ^ mask);
+        do_load_and_execute(mutated);
+      }
+  }
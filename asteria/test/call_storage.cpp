@@ -0,0 +1,69 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Storage of calls is reused. Make sure nothing leaks from one call into
+        // another, including calls that are deeper than the pool.
+        func sum(n) {
+          if(n == 0)
+            return 0;
+          var t = n;
+          return t + sum(n - 1);
+        }
+        assert sum(10) == 55;
+        assert sum(200) == 20100;
+        assert sum(10) == 55;
+
+        // Closures keep captured variables after storage is recycled.
+        func make(x) {
+          var y = x * 2;
+          return func() { return x + y;  };
+        }
+        var fs = [];
+        for(var i = 0;  i < 100;  ++i)
+          fs[i] = make(i);
+        for(var i = 0;  i < 100;  ++i)
+          assert fs[i]() == i * 3;
+
+        // Storage is not reused after exceptions, but calls still work.
+        func fail(n) {
+          var z = n;
+          if(n == 0)
+            throw "boom";
+          return fail(n - 1);
+        }
+        for(var i = 0;  i < 3;  ++i) {
+          try {
+            fail(100);
+            assert false;
+          }
+          catch(e)
+            assert e == "boom";
+        }
+        assert sum(100) == 5050;
+
+        // Variadic arguments and nested calls.
+        func va(...) {
+          return __varg();
+        }
+        assert va(1, 2, 3) == 3;
+        assert va(va(1), va(2, 3)) == 2;
+        assert va() == 0;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
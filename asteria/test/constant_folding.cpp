@@ -0,0 +1,109 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    // The behavior shall not depend on the optimization level.
+    for(int8_t level = 0;  level <= 3;  ++level) {
+      Compiler_Options opts;
+      opts.optimization_level = level;
+      Simple_Script code(opts);
+      code.reload_string(
+        sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        const kib = 1024;
+        const mib = kib * kib;
+        const name = "meow" + "MEOW";
+        assert mib == 1048576;
+        assert name == "meowMEOW";
+        assert countof name == 8;
+        assert __fma(2, 3.0, 4) == 10.0;
+        assert -(1 << 3) == -8;
+        assert typeof (1 + 2.5) == "real";
+
+        func get_mib() { return mib; }
+        assert get_mib() == 1048576;
+
+        // Operators that throw exceptions shall not be evaluated at compile time.
+        try {
+          var x = 1 / 0;
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "division by zero") != null;
+        }
+
+        try {
+          var x = 0x7FFFFFFFFFFFFFFF + 1;
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "overflow") != null;
+        }
+
+        // Immutable variables cannot be modified, even if they are constants.
+        try {
+          kib = 42;
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "Attempt to modify") != null;
+          assert kib == 1024;
+        }
+
+        try {
+          ++kib;
+          assert false;
+        }
+        catch(e) {
+          assert kib == 1024;
+        }
+
+        const arr = [ 1, 2 ];
+        try {
+          arr[0] = 3;
+          assert false;
+        }
+        catch(e) {
+          assert arr[0] == 1;
+        }
+
+        // Redeclaration hides the constant.
+        {
+          const k = 1;
+          var k = 2;
+          k += 3;
+          assert k == 5;
+        }
+
+        // Initialization of a constant in a `switch` clause may be bypassed.
+        func sw(x) {
+          switch(x) {
+          case 1:
+            const c = 10;
+          case 2:
+            return c;
+          }
+        }
+        assert sw(1) == 10;
+        try {
+          sw(2);
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "bypassed variable") != null;
+        }
+
+///////////////////////////////////////////////////////////////////////////////
+        )__"));
+      Global_Context global;
+      code.execute(global);
+    }
+  }
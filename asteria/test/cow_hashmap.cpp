@@ -0,0 +1,81 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/fwd.hpp"
+#include <map>
+#include <random>
+
+using namespace asteria;
+
+int main()
+  {
+    cow_dictionary<int> dict;
+    ::std::map<cow_string, int> ref;
+    ::std::mt19937 prng(12345);
+
+    // Perform random insertions and removals, which cause rehashes and
+    // wrapping probe sequences, and compare the table against a reference.
+    for(long r = 0;  r != 100000;  ++r) {
+      cow_string key = sref("k");
+      key += ::std::to_string(prng() % 3000).c_str();
+      int val = static_cast<int>(prng() % 1000);
+
+      switch(prng() % 4) {
+        case 0:
+        case 1:
+          dict.insert_or_assign(key, val);
+          ref[key] = val;
+          break;
+
+        case 2:
+          ASTERIA_TEST_CHECK(dict.erase(key) == ref.erase(key));
+          break;
+
+        case 3: {
+          auto qval = dict.ptr(key);
+          auto it = ref.find(key);
+          if(it == ref.end())
+            ASTERIA_TEST_CHECK(qval == nullptr);
+          else
+            ASTERIA_TEST_CHECK(qval && (*qval == it->second));
+          break;
+        }
+
+        default:
+          ASTERIA_TERMINATE("invalid operation");
+      }
+      ASTERIA_TEST_CHECK(dict.size() == ref.size());
+    }
+
+    // Copies share storage until they are modified.
+    auto copy = dict;
+    for(const auto& pair : ref)
+      ASTERIA_TEST_CHECK(copy.erase(pair.first));
+    ASTERIA_TEST_CHECK(copy.empty());
+    ASTERIA_TEST_CHECK(dict.size() == ref.size());
+
+    for(const auto& pair : ref) {
+      auto qval = dict.ptr(pair.first);
+      ASTERIA_TEST_CHECK(qval && (*qval == pair.second));
+    }
+
+    // All elements are enumerated exactly once.
+    size_t count = 0;
+    for(const auto& pair : dict) {
+      ASTERIA_TEST_CHECK(ref.at(pair.first) == pair.second);
+      count ++;
+    }
+    ASTERIA_TEST_CHECK(count == ref.size());
+
+    // All buckets are cleared, not only the first `size()` ones.
+    dict.clear();
+    ASTERIA_TEST_CHECK(dict.empty());
+    ASTERIA_TEST_CHECK(dict.begin() == dict.end());
+    for(const auto& pair : ref)
+      ASTERIA_TEST_CHECK(dict.ptr(pair.first) == nullptr);
+
+    dict.try_emplace(sref("meow"), 42);
+    ASTERIA_TEST_CHECK(dict.size() == 1);
+    ASTERIA_TEST_CHECK(*(dict.ptr(sref("meow"))) == 42);
+  }
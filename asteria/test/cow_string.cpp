@@ -0,0 +1,77 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/fwd.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    cow_string::hash hf;
+    ::rocket::details_cow_string::basic_hasher<char, ::rocket::char_traits<char>> hr;
+
+    // Hash values don't depend on how characters are appended.
+    cow_string str = sref("the quick brown fox jumps over the lazy dog");
+    size_t hval = hf(str);
+    ASTERIA_TEST_CHECK(hf(str.c_str()) == hval);
+    for(size_t k = 0;  k != str.size();  ++k)
+      hr.append(str[k]);
+    ASTERIA_TEST_CHECK(hr.finish() == hval);
+    hr.append(str.data(), 3).append(str.data() + 3, 10).append(str.c_str() + 13);
+    ASTERIA_TEST_CHECK(hr.finish() == hval);
+
+    // Trailing null characters make a difference.
+    ASTERIA_TEST_CHECK(hf(cow_string(4, 'a')) != hf(cow_string("aaaa\0", 5)));
+    ASTERIA_TEST_CHECK(hf(cow_string()) != hf(cow_string(1, '\0')));
+
+    // Cached hash values are discarded when strings are modified.
+    cow_string copy = str;
+    ASTERIA_TEST_CHECK(hf(copy) == hval);
+    copy.mut(4) = 'Q';
+    ASTERIA_TEST_CHECK(hf(copy) != hval);
+    ASTERIA_TEST_CHECK(hf(copy) == hf(cow_string(copy.data(), copy.size())));
+    ASTERIA_TEST_CHECK(hf(str) == hval);
+
+    str.pop_back();
+    ASTERIA_TEST_CHECK(hf(str) != hval);
+    ASTERIA_TEST_CHECK(hf(str) == hf(cow_string(str.data(), str.size())));
+    str.push_back('g');
+    ASTERIA_TEST_CHECK(hf(str) == hval);
+
+    // Strings that are not shared may be modified through iterators that were
+    // obtained before they were hashed.
+    cow_string uniq(str.data(), str.size());
+    auto it = uniq.mut_begin();
+    ASTERIA_TEST_CHECK(hf(uniq) == hval);
+    *it = 'T';
+    ASTERIA_TEST_CHECK(hf(uniq) != hval);
+    ASTERIA_TEST_CHECK(hf(uniq) == hf(cow_string(uniq.data(), uniq.size())));
+
+    // Hash values that were cached while strings were shared shall not be used
+    // after the strings become unique.
+    copy = uniq;
+    size_t cval = hf(copy);
+    ASTERIA_TEST_CHECK(hf(uniq) == cval);
+    copy.clear();
+    *it = 'x';
+    ASTERIA_TEST_CHECK(hf(uniq) != cval);
+    ASTERIA_TEST_CHECK(hf(uniq) == hf(cow_string(uniq.data(), uniq.size())));
+
+    // Cached and uncached hash values are identical.
+    copy = uniq;
+    cval = hf(copy);
+    ASTERIA_TEST_CHECK(hf(copy) == cval);
+    ASTERIA_TEST_CHECK(hf(copy.c_str()) == cval);
+    ASTERIA_TEST_CHECK(hr.append(copy.data(), copy.size()).finish() == cval);
+    ASTERIA_TEST_CHECK(cval <= UINT32_MAX);
+
+    // Insertion that causes reallocation shall preserve existent characters.
+    cow_string data;
+    data.append(10, '*');
+    data.shrink_to_fit();
+    auto pos = data.insert(data.end(), 100000, '/');
+    ASTERIA_TEST_CHECK(pos - data.begin() == 10);
+    data.erase(pos, data.end());
+    ASTERIA_TEST_CHECK(data == sref("**********"));
+  }
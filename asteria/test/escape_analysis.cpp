@@ -0,0 +1,90 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/genius_collector.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Global_Context global;
+    auto gcoll = global.genius_collector();
+    auto& newest = gcoll->open_collector(gc_generation_newest);
+    newest.set_threshold(1000000);
+
+    // Local variables that can't escape are not tracked.
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var sum = 0;
+        for(var i = 0;  i < 1000;  ++i) {
+          var x = i;
+          const y = x * 2;
+          var z;
+          z = [ x, y ];
+          sum += z[1];
+        }
+        assert sum == 999000;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    size_t before = newest.count_tracked_variables();
+    code.execute(global);
+    ASTERIA_TEST_CHECK(newest.count_tracked_variables() - before < 10);
+
+    // Local variables that may escape are tracked.
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Captured by closures
+        var fns = [];
+        for(var i = 0;  i < 1000;  ++i) {
+          var x = i;
+          fns[$] = func() { return x;  };
+        }
+        assert fns[42]() == 42;
+
+        // Bound by named references
+        var a = 1;
+        ref ra -> a;
+        ra = 2;
+        assert a == 2;
+
+        // Passed by reference
+        func set(r, v) { r = v;  }
+        var b = 3;
+        set(-> b, 4);
+        assert b == 4;
+
+        // Bound to `this`
+        var obj = { };
+        obj.init = func() { this.get = func() { return this.val;  };  };
+        obj.val = 5;
+        obj.init();
+        assert obj.get() == 5;
+
+        // Returned by reference
+        func get_c() { var c = 6;  return ref c;  }
+        ref rc -> get_c();
+        assert rc == 6;
+
+        // Recursive functions
+        func fib(n) { return (n <= 1) ? n : fib(n - 1) + fib(n - 2);  }
+        assert fib(10) == 55;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    before = newest.count_tracked_variables();
+    code.execute(global);
+    ASTERIA_TEST_CHECK(newest.count_tracked_variables() - before >= 1000);
+
+    // Cycles are still collected.
+    gcoll->collect_variables();
+    ASTERIA_TEST_CHECK(newest.count_tracked_variables() == 0);
+  }
@@ -0,0 +1,83 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/genius_collector.hpp"
+#include "../src/runtime/collector.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func make_closures(n, keep) {
+          for(var i = 0;  i < n;  ++i) {
+            var x = i;
+            keep[$] = func() { return x;  };
+          }
+        }
+
+        func make_cycles(n) {
+          for(var i = 0;  i < n;  ++i) {
+            var a, b;
+            a = func() { return b;  };
+            b = func() { return a;  };
+          }
+        }
+
+        // Adaptive tuning is enabled by the host.
+        assert std.system.gc_get_adaptive(0) == true;
+        assert std.system.gc_get_adaptive(3) == null;
+        std.system.gc_collect();
+        assert std.system.gc_set_threshold(0, 100) >= 800;
+
+        // Collections that find nothing back off.
+        var keep = [];
+        make_closures(5000, -> keep);
+        var thres = std.system.gc_get_threshold(0);
+        assert thres > 100;
+        assert thres <= 6400;
+
+        // The threshold decays when there are both survivors and garbage.
+        for(var i = 0;  i < 20;  ++i) {
+          make_closures(200, -> keep);
+          make_cycles(200);
+        }
+        assert std.system.gc_get_threshold(0) < thres;
+        keep = null;
+
+        // Almost all variables dying young makes cycles larger.
+        std.system.gc_set_threshold(0, 100);
+        make_cycles(5000);
+        assert std.system.gc_get_threshold(0) > 100;
+        assert std.system.gc_get_threshold(0) <= 6400;
+
+        // The base threshold is restored when adaptive tuning is disabled.
+        assert std.system.gc_set_adaptive(0, false) == true;
+        assert std.system.gc_get_threshold(0) == 100;
+        make_cycles(5000);
+        assert std.system.gc_get_threshold(0) == 100;
+
+        std.system.gc_collect();
+        assert std.system.gc_count_variables(0) + std.system.gc_count_variables(1)
+               + std.system.gc_count_variables(2) < 10;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    global.genius_collector()->set_adaptive(true);
+    code.execute(global);
+
+    // Collections that scan nothing leave the threshold intact.
+    Collector coll(gc_generation_newest, nullptr, nullptr, 100);
+    coll.set_adaptive(true);
+    for(int k = 0;  k < 10;  ++k)
+      coll.collect_single_opt();
+    ASTERIA_TEST_CHECK(coll.get_threshold() == 100);
+  }
@@ -0,0 +1,78 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/genius_collector.hpp"
+#include "../src/runtime/variable.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Global_Context global;
+    auto gcoll = global.genius_collector();
+
+    // Variables that hold scalar values are not tracked.
+    auto var = gcoll->create_variable();
+    var->initialize(V_integer(42), false);
+    ASTERIA_TEST_CHECK(var->is_gc_deferred());
+    gcoll->collect_variables();
+    ASTERIA_TEST_CHECK(var->is_gc_deferred());
+    ASTERIA_TEST_CHECK(var->get_value().as_integer() == 42);
+
+    // They are tracked after being assigned other values.
+    var->open_value() = V_array(3);
+    gcoll->collect_variables();
+    ASTERIA_TEST_CHECK(!var->is_gc_deferred());
+    ASTERIA_TEST_CHECK(var->get_value().as_array().size() == 3);
+
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Variables that are initialized to `null` and are assigned closures
+        // later can still form cycles.
+        func make_cycles(n) {
+          for(var i = 0;  i < n;  ++i) {
+            var a, b;
+            a = func() { return b;  };
+            b = func() { return a;  };
+          }
+        }
+
+        std.system.gc_collect();
+        make_cycles(1000);
+        std.system.gc_collect();
+        assert std.system.gc_count_variables(0) + std.system.gc_count_variables(1)
+               + std.system.gc_count_variables(2) < 10;
+
+        // Scalars that are captured by closures survive collections.
+        var fns = [];
+        for(var i = 0;  i < 1000;  ++i) {
+          var x = i;
+          fns[$] = func() { return x;  };
+        }
+        std.system.gc_collect();
+        for(each k, f -> fns)
+          assert f() == k;
+
+        // Variables that are transferred to the next generation while still
+        // deferred count towards its threshold, so it doesn't grow unbounded.
+        func call_closure(n) {
+          var x = n * 2;
+          return (func() = x + 1)();
+        }
+
+        fns = null;
+        std.system.gc_collect();
+        for(var i = 0;  i < 200000;  ++i)
+          assert call_closure(i) == i * 2 + 1;
+        assert std.system.gc_count_variables(1) <= std.system.gc_get_threshold(1) + 10;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute(global);
+  }
@@ -0,0 +1,83 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func make_cycles(n, keep) {
+          for(var i = 0;  i < n;  ++i) {
+            var a, b;
+            a = func() { return b;  };
+            b = func() { return a;  };
+            if(i % 2 == 0)
+              keep[$] = a;
+          }
+        }
+
+        // Manual slices
+        std.system.gc_collect();
+        assert std.system.gc_set_threshold(0, 100000) == 800;
+
+        var keep = [];
+        make_cycles(1000, -> keep);
+        assert std.system.gc_count_variables(0) >= 2000;
+
+        var nslices = 0;
+        var nvars = 0;
+        while(std.system.gc_count_variables(0) > 0) {
+          nvars += std.system.gc_collect_slice(0, 10);
+          ++nslices;
+        }
+        assert nslices > 100;
+        assert nvars >= 1000;
+        assert std.system.gc_count_variables(1) >= 1000;
+
+        // Live variables have been transferred, but are intact.
+        for(each k, f -> keep)
+          assert typeof f()() == "function";
+
+        // Invalid generations
+        assert std.system.gc_collect_slice(3, 10) == null;
+        assert std.system.gc_get_slice_budget(-1) == null;
+
+        // Time-budgeted slices
+        keep = null;
+        var trash = [];
+        make_cycles(1000, -> trash);
+        trash = null;
+        nvars = std.system.gc_collect_timed(1000000);
+        assert nvars >= 1000;
+        assert std.system.gc_count_variables(0) + std.system.gc_count_variables(1)
+               + std.system.gc_count_variables(2) < 10;
+
+        // Automatic incremental collection
+        assert std.system.gc_set_threshold(0, 800) == 100000;
+        assert std.system.gc_set_slice_budget(0, 50) == 0;
+        assert std.system.gc_get_slice_budget(0) == 50;
+        keep = [];
+        make_cycles(10000, -> keep);
+        assert std.system.gc_count_variables(0) < 5000;
+        for(each k, f -> keep)
+          assert typeof f()() == "function";
+
+        assert std.system.gc_set_slice_budget(0, 0) == 50;
+        keep = null;
+        std.system.gc_collect();
+        assert std.system.gc_count_variables(0) + std.system.gc_count_variables(1)
+               + std.system.gc_count_variables(2) < 10;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
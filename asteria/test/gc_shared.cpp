@@ -0,0 +1,102 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func count_all() {
+          return std.system.gc_count_variables(0) + std.system.gc_count_variables(1)
+                 + std.system.gc_count_variables(2);
+        }
+
+        // Cycles through arrays that are shared by two variables
+        func make_cycles(n) {
+          for(var i = 0;  i < n;  ++i) {
+            var a, b;
+            a = [ func() { return [a,b];  } ];
+            b = a;
+          }
+        }
+
+        std.system.gc_collect();
+        var base = count_all();
+        make_cycles(2000);
+        std.system.gc_collect();
+        std.system.gc_collect();
+        assert count_all() <= base + 10;
+
+        make_cycles(2000);
+        std.system.gc_collect_timed(1000000);
+        assert count_all() <= base + 10;
+
+        // Variables that are reachable through shared arrays, which are also
+        // referenced by live variables that are not scanned in the same slice
+        func make_shared(n, keep) {
+          for(var i = 0;  i < n;  ++i) {
+            var c = [i];
+            var v;
+            v = [ func() { return c;  }, func() { return v;  } ];
+            keep[$] = v;
+          }
+        }
+
+        var keep = [];
+        make_shared(1000, -> keep);
+        while(std.system.gc_count_variables(0) > 0)
+          std.system.gc_collect_slice(0, 10);
+
+        for(each k, v -> keep) {
+          assert v[0]()[0] == k;
+          assert countof v[1]() == 2;
+        }
+
+        keep = [];
+        std.system.gc_collect();
+        assert count_all() <= base + 10;
+
+        // Cycles through objects, arrays and closures, a few of which are kept
+        func mk(n) {
+          var a = { n: n };
+          var b = [a];
+          a.b = b;
+          var c = func() { return a.n + b[0].n;  };
+          a.c = c;
+          return [c,a];
+        }
+
+        for(var i = 0;  i < 20000;  ++i) {
+          var r = mk(i);
+          if(i % 97 == 0)
+            keep[$] = r;
+        }
+        std.system.gc_collect();
+        for(each k, r -> keep)
+          assert r[0]() == k * 194;
+
+        keep = [];
+        for(var g = 0;  g < 3;  ++g)
+          std.system.gc_set_slice_budget(g, 10);
+        for(var i = 0;  i < 20000;  ++i) {
+          var r = mk(i);
+          if(i % 97 == 0)
+            keep[$] = r;
+        }
+        std.system.gc_collect();
+        for(each k, r -> keep)
+          assert r[0]() == k * 194;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,87 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/abstract_hooks.hpp"
+
+using namespace asteria;
+
+namespace {
+
+struct Test_Hooks
+  final
+  : Abstract_Hooks
+  {
+    long nbegin = 0;
+    long nend = 0;
+    size_t ntotal_freed = 0;
+
+    void
+    on_gc_collect_begin(GC_Generation /*gc_gen*/)
+      override
+      {
+        ASTERIA_TEST_CHECK(this->nbegin == this->nend);
+        this->nbegin ++;
+      }
+
+    void
+    on_gc_collect_end(GC_Generation /*gc_gen*/, size_t ntraversed, size_t nfreed,
+                      uint64_t /*pause_ns*/)
+      override
+      {
+        ASTERIA_TEST_CHECK(nfreed <= ntraversed);
+        this->nend ++;
+        this->ntotal_freed += nfreed;
+      }
+  };
+
+}  // namespace
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func make_cycles(n) {
+          for(var i = 0;  i < n;  ++i) {
+            var a, b;
+            a = func() { return b;  };
+            b = func() { return a;  };
+          }
+        }
+
+        var stats = std.system.gc_stats();
+        assert countof stats == 3;
+        assert stats[0].collections == 0;
+
+        make_cycles(5000);
+        std.system.gc_collect();
+        stats = std.system.gc_stats();
+        assert stats[0].collections > 0;
+        assert stats[0].traversed >= 10000;
+        assert stats[0].freed + stats[1].freed + stats[2].freed >= 10000;
+        assert stats[0].reused > 0;
+        assert stats[2].collections > 0;
+        assert stats[0].pause_total >= stats[0].pause_max;
+        assert countof stats[0].pause_histogram == 6;
+
+        var nhist = 0;
+        for(each k, v -> stats[0].pause_histogram)
+          nhist += v;
+        assert nhist == stats[0].collections;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    auto hooks = ::rocket::make_refcnt<Test_Hooks>();
+    global.set_hooks(hooks);
+    code.execute(global);
+
+    ASTERIA_TEST_CHECK(hooks->nbegin > 0);
+    ASTERIA_TEST_CHECK(hooks->nbegin == hooks->nend);
+    ASTERIA_TEST_CHECK(hooks->ntotal_freed >= 10000);
+  }
@@ -0,0 +1,54 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/module_cache.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    const ::rocket::unique_ptr<char, void (&)(void*)> abspath(::realpath(__FILE__, nullptr), ::free);
+    ROCKET_ASSERT(abspath);
+
+    Simple_Script code;
+    code.reload_string(
+      cow_string(abspath), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Cached functions are reused.
+        var sub = std.string.slice(__file, 0, std.string.rfind(__file, "/") + 1) + "import_sub.txt";
+        assert import(sub, 3, 5) == -2;
+        assert import(sub, 7, 1) == 6;
+        assert std.system.import_invalidate_cache(sub) == 1;
+        assert std.system.import_invalidate_cache(sub) == 0;
+        assert import(sub, 3, 5) == -2;
+
+        // Modified files are compiled again.
+        var path = std.string.format("/tmp/asteria_import_cache_$1.txt", std.system.proc_get_pid());
+        std.filesystem.file_write(path, "return 42;");
+        defer std.filesystem.file_remove(path);
+
+        assert import(path) == 42;
+        assert import(path) == 42;
+        std.filesystem.file_write(path, "return 12345;");
+        assert import(path) == 12345;
+
+        // Failed compilation shall not be cached.
+        std.filesystem.file_write(path, "return ;;; + ;");
+        try {  import(path);  assert false;  }
+          catch(e) {  assert std.string.find(e, "Assertion failure") == null;  }
+
+        std.filesystem.file_write(path, "return 'meow';");
+        assert import(path) == "meow";
+        assert std.system.import_invalidate_cache() == 2;
+        assert std.system.import_invalidate_cache() == 0;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+    ASTERIA_TEST_CHECK(global.module_cache()->size() == 0);
+  }
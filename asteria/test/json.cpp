@@ -107,6 +107,44 @@ int main()
         assert countof r[1].c == 0;
         assert r[1].d == 4;
 
+        assert std.json.parse("/* one */ [1, // two\n 2]") == [1,2];
+        try { std.json.parse("[1 /* two");  assert false;  }
+          catch(e) assert std.string.find(e, "comment") != null;
+        assert std.json.parse("'a\\'b\\x41\\U01F600'") == "a'bA😀";
+        assert std.json.parse("'喵喵喵喵喵喵喵喵 long enough for vectors'") == "喵喵喵喵喵喵喵喵 long enough for vectors";
+        try { std.json.parse("'unclosed");  assert false;  }
+          catch(e) assert std.string.find(e, "string") != null;
+        try { std.json.parse("'\\q'");  assert false;  }
+          catch(e) assert std.string.find(e, "escape") != null;
+        assert std.json.parse("[0x10,0b11,-1.5e2,+7,1`000]") == [16,3,-150,7,1000];
+        assert std.json.parse("-Infinity") == -infinity;
+        try { std.json.parse("12abc");  assert false;  }
+          catch(e) assert std.string.find(e, "suffix") != null;
+        try { std.json.parse("[1,\n 2,\n foo]");  assert false;  }
+          catch(e) assert std.string.find(e, "line 3, column 2") != null;
+        try { std.json.parse("[1 2]");  assert false;  }
+          catch(e) assert std.string.find(e, "line 1, column 4") != null;
+        try { std.json.parse("{a 1}");  assert false;  }
+          catch(e) assert std.string.find(e, "`:`") != null;
+
+        r = std.json.parse("[{key:1},{key:2},{'key':3}]");
+        assert r[0].key + r[1].key + r[2].key == 6;
+
+        const chars = "0123456789abcdefghijklmnopqrstuvwxyz";
+        // We presume these random strings will never match any real files.
+        var fname = ".json-test_file_" + std.string.implode(std.array.shuffle(std.string.explode(chars)));
+        var v = { a: [1, 2.5, "x\"y\\z\n\t\u0001\u007F喵"], b: null, c: { d: true } };
+        std.json.format_to_file(fname, v);
+        assert std.filesystem.file_read(fname) == std.json.format(v);
+        std.json.format_to_file(fname, v, 2);
+        assert std.filesystem.file_read(fname) == std.json.format(v, 2);
+        std.json.format_to_file(fname, v, "\t");
+        assert std.filesystem.file_read(fname) == std.json.format(v, "\t");
+        assert std.json.parse_file(fname).a == v.a;
+        std.filesystem.remove_recursive(fname);
+
+        std.json.format_to_stdout(v);
+
         const depth = 1000;
         var r = [];
         for(var i = 1; i < depth; ++i) {
@@ -0,0 +1,85 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var out = [];
+        func collect(i, v) {
+          assert i == countof out;
+          out[$] = v;
+        }
+
+        // Top-level arrays
+        assert std.json.parse_stream("[1, 'a', {x:[2]}, ]", collect) == 3;
+        assert out[0] == 1;
+        assert out[1] == "a";
+        assert out[2].x == [2];
+
+        out = [];
+        assert std.json.parse_stream(" [ ] ", collect) == 0;
+        assert std.json.parse_stream("  ", collect) == 0;
+        assert out == [];
+
+        // Sequences of values
+        out = [];
+        assert std.json.parse_stream("{\"a\":1}\n{\"a\":2}\n\n[3] 4", collect) == 4;
+        assert out[0].a == 1;
+        assert out[1].a == 2;
+        assert out[2] == [3];
+        assert out[3] == 4;
+
+        // Errors
+        func ignore(i, v) { }
+        try { std.json.parse_stream("[1] 2", ignore);  assert false;  }
+          catch(e) assert std.string.find(e, "Excess text") != null;
+        try { std.json.parse_stream("[1,\n 2 3]", ignore);  assert false;  }
+          catch(e) assert std.string.find(e, "line 2, column 4") != null;
+
+        // Files, which are read in chunks
+        const chars = "0123456789abcdefghijklmnopqrstuvwxyz";
+        // We presume these random strings will never match any real files.
+        var fname = ".json_stream-test_file_" + std.string.implode(std.array.shuffle(std.string.explode(chars)));
+
+        var lines = [];
+        for(var i = 0;  i < 50000;  ++i)
+          lines[$] = std.json.format({ id: i, name: std.string.format("user $1 喵", i) });
+        std.filesystem.file_write(fname, std.string.implode(lines, "\n"));
+
+        var sum = 0;
+        assert std.json.parse_file_stream(fname,
+            func(i, v) {
+              assert v.id == i;
+              assert v.name == std.string.format("user $1 喵", i);
+              sum += i;
+            }) == 50000;
+        assert sum == 1249975000;
+
+        std.filesystem.file_write(fname, "[1,\"" + "ab\\n" * 1000000 + "\",2]");
+        out = [];
+        assert std.json.parse_file_stream(fname, collect) == 3;
+        assert out[0] == 1;
+        assert out[1] == "ab\n" * 1000000;
+        assert out[2] == 2;
+
+        std.filesystem.file_write(fname, "[1,2,\n 3 x]");
+        try { std.json.parse_file_stream(fname, ignore);  assert false;  }
+          catch(e) assert std.string.find(e, "line 2, column 4") != null;
+
+        std.filesystem.remove_recursive(fname);
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,82 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Pre-defined references are created lazily, so they may occupy
+        // different slots at compile time and at run time.
+        func lazy(c, ...) {
+          if(c)
+            assert __varg() == 2;
+          var a = 1;
+          var b = this;
+          var d = __func;
+          return [ a, b, c, d ];
+        }
+        var r = lazy(true, 5, 6);
+        assert r[0] == 1;
+        assert r[1] == null;
+        assert r[2] == true;
+        assert std.string.find(r[3], "lazy") == 0;
+        r = lazy(false);
+        assert r[0] == 1;
+        assert r[1] == null;
+        assert r[2] == false;
+        assert std.string.find(r[3], "lazy") == 0;
+
+        var obj = { x: 42 };
+        obj.get = func() {
+          var y = 1;
+          return this.x + y;
+        };
+        assert obj.get() == 43;
+
+        // Declarations in `switch` statements may be bypassed.
+        func sw(x) {
+          switch(x) {
+          case 1:
+            var p = 10;
+          case 2:
+            var q = 20;
+            return q;
+          }
+          return -1;
+        }
+        assert sw(1) == 20;
+        assert sw(2) == 20;
+        assert sw(3) == -1;
+
+        // Nested scopes and closures.
+        var s = 0;
+        for(var i = 0;  i < 10;  ++i) {
+          var t = i * 2;
+          {
+            var t = i;
+            s += t;
+          }
+          s += t;
+        }
+        assert s == 135;
+
+        func mk(k) {
+          var u = k + 1;
+          return func(v) = u * v + k;
+        }
+        assert mk(3)(5) == 23;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,110 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func rt(v) {
+          return std.msgpack.decode(std.msgpack.encode(v));
+        }
+
+        // Scalars and lengths across all forms
+        for(each k, v -> [ null, true, false, 0, 1, 127, 128, 255, 256, 65535, 65536,
+                           4294967295, 4294967296, 0x7FFFFFFFFFFFFFFF, -1, -32, -33, -128,
+                           -129, -32768, -32769, -2147483648, -2147483649,
+                           -0x7FFFFFFFFFFFFFFF - 1, 0.5, -2.5, 1.0e100, "", "abc",
+                           "x" * 31, "x" * 32, "y" * 300, "z" * 70000, [], [1,[2,[3]]] ])
+          assert rt(v) == v;
+
+        assert typeof rt(1) == "integer";
+        assert typeof rt(1.0) == "real";
+        assert rt(-infinity) == -infinity;
+        assert __isnan rt(nan);
+        assert rt(std.msgpack.encode) == null;
+        assert countof rt({}) == 0;
+
+        var r = rt({ a: 1, b: [1.5, "s"], c: { d: null } });
+        assert r.a == 1;
+        assert r.b == [1.5, "s"];
+        assert r.c.d == null;
+        assert countof r.c == 1;
+
+        // Encoded bytes
+        assert std.msgpack.encode([1, -1, "a", { k: true }, 1.5, null])
+               == "\x96\x01\xFF\xA1a\x81\xA1k\xC3\xCA\x3F\xC0\x00\x00\xC0";
+        assert std.msgpack.encode(300) == "\xCD\x01\x2C";
+        assert std.msgpack.encode(-200) == "\xD1\xFF\x38";
+
+        // Other producers may use `bin` and non-shortest forms.
+        assert std.msgpack.decode("\xC4\x03abc") == "abc";
+        assert std.msgpack.decode("\xD3\x00\x00\x00\x00\x00\x00\x00\x05") == 5;
+        assert std.msgpack.decode("\xDC\x00\x02\xC2\xC3") == [false, true];
+
+        // Errors
+        try { std.msgpack.decode("\xC1");  assert false;  }
+          catch(e) assert std.string.find(e, "invalid type byte") != null;
+        try { std.msgpack.decode("\x92\x01");  assert false;  }
+          catch(e) assert std.string.find(e, "unexpected end") != null;
+        try { std.msgpack.decode("\x01\x02");  assert false;  }
+          catch(e) assert std.string.find(e, "excess data") != null;
+        try { std.msgpack.decode("\x81\x01\x02");  assert false;  }
+          catch(e) assert std.string.find(e, "not a string") != null;
+        try { std.msgpack.decode("\xCF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF");  assert false;  }
+          catch(e) assert std.string.find(e, "out of range") != null;
+        try { std.msgpack.decode("\xD4\x01\x00");  assert false;  }
+          catch(e) assert std.string.find(e, "extension") != null;
+
+        // Streams
+        var out = [];
+        assert std.msgpack.decode_stream(std.msgpack.encode(1) + std.msgpack.encode("two")
+                                         + std.msgpack.encode([3]),
+                                         func(i, v) { out[$] = v;  }) == 3;
+        assert out == [1, "two", [3]];
+        assert std.msgpack.decode_stream("", func(i, v) { assert false;  }) == 0;
+
+        // Files
+        const chars = "0123456789abcdefghijklmnopqrstuvwxyz";
+        // We presume these random strings will never match any real files.
+        var fname = ".msgpack-test_file_" + std.string.implode(std.array.shuffle(std.string.explode(chars)));
+
+        var data = "";
+        for(var i = 0;  i < 50000;  ++i)
+          data += std.msgpack.encode({ id: i, s: "x" * (i % 50) });
+        std.filesystem.file_write(fname, data + std.msgpack.encode("x" * 3000000));
+
+        var sum = 0;
+        assert std.msgpack.decode_file_stream(fname,
+            func(i, v) {
+              if(i == 50000) {
+                assert v == "x" * 3000000;
+                return;
+              }
+              assert v.id == i;
+              assert v.s == "x" * (i % 50);
+              sum += i;
+            }) == 50001;
+        assert sum == 1249975000;
+
+        std.msgpack.encode_to_file(fname, [1, "two", { c: 3 }]);
+        r = std.msgpack.decode_file(fname);
+        assert r[0] == 1;
+        assert r[1] == "two";
+        assert r[2].c == 3;
+
+        std.filesystem.remove_recursive(fname);
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
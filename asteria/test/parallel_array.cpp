@@ -0,0 +1,61 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func run_all(data) {
+          return [ std.array.sort(data), std.array.sortu(data),
+                   std.array.find(data, 42), std.array.find(data, 100, 42),
+                   std.array.find(data, -1), std.array.count(data, 42),
+                   std.array.count(data, 10, 1000, 42), std.array.exclude(data, 42),
+                   std.array.exclude(data, 5, 100, 42) ];
+        }
+
+        var ints = [], mixed = [], strs = [];
+        for(var i = 0;  i < 5000;  ++i) {
+          ints[$] = std.numeric.ifloor(std.numeric.random(100));
+          mixed[$] = (i % 2) ? ints[i] : std.numeric.random(100.0);
+          strs[$] = std.string.format("$1", ints[i]);
+        }
+
+        // Parallel operations are disabled by default.
+        assert std.system.parallel_get_threads() == 0;
+        var serial = [ run_all(ints), run_all(mixed), run_all(strs) ];
+
+        assert std.system.parallel_set_threads(4) == 0;
+        assert std.system.parallel_get_threads() == 4;
+        assert std.system.parallel_set_cutoff(100) == 100000;
+        assert std.system.parallel_get_cutoff() == 100;
+        var parallel = [ run_all(ints), run_all(mixed), run_all(strs) ];
+        assert parallel == serial;
+
+        // Arrays that are shorter than the cutoff are processed serially.
+        assert std.array.sort([3,1,2]) == [1,2,3];
+
+        // Exceptions are propagated from workers.
+        mixed[2500] = nan;
+        try { std.array.sort(mixed);  assert false;  }
+          catch(e) { assert std.string.find(e, "Assertion failure") == null;  }
+
+        // Workers may be stopped and restarted.
+        assert std.system.parallel_set_threads(2) == 4;
+        assert std.array.sort(ints) == serial[0][0];
+        assert std.system.parallel_set_threads(0) == 2;
+        assert std.array.sort(ints) == serial[0][0];
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,74 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var data = [ 5, 3, 8, 1, 9, 2, 7 ];
+
+        // Script comparators, with and without proper tail calls
+        func cmp(x, y) { return x <=> y;  }
+        func rcmp(x, y) { return cmp(y, x);  }
+
+        assert std.array.sort(data, cmp) == [ 1, 2, 3, 5, 7, 8, 9 ];
+        assert std.array.sort(data, rcmp) == [ 9, 8, 7, 5, 3, 2, 1 ];
+        assert std.array.sortu([ 5, 3, 8, 1, 9, 2, 7, 9, 1, 5 ], rcmp) == [ 9, 8, 7, 5, 3, 2, 1 ];
+        assert std.array.is_sorted([ 9, 8, 1 ], rcmp) == true;
+        assert std.array.max_of(data, rcmp) == 1;
+        assert std.array.min_of(data, rcmp) == 9;
+        assert std.array.binary_search([ 7, 5, 3, 1 ], 3, rcmp) == 2;
+        assert std.array.equal_range([ 7, 5, 5, 1 ], 5, rcmp) == [ 1, 2 ];
+
+        // Native comparators
+        assert std.array.sort([ "b", "c", "a" ], std.string.compare) == [ "a", "b", "c" ];
+
+        // Nested callbacks
+        var n = 0;
+        assert std.array.sort(data,
+            func(x, y) {
+              assert std.array.count_if(data, func(z) = z > x) >= 0;
+              ++n;
+              return y <=> x;
+            }) == [ 9, 8, 7, 5, 3, 2, 1 ];
+        assert n > 0;
+
+        // Exceptions thrown from callbacks
+        n = 0;
+        try {
+          std.array.sort(data, func(x, y) { if(++n == 5) throw "boom";  return x <=> y;  });
+          assert false;
+        }
+        catch(e)
+          assert e == "boom";
+
+        try {
+          std.array.find_if(data, func() = true);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "Too many arguments") != null;
+
+        // Predictors and generators
+        assert std.array.find_if(data, func(x) = x == 9) == 4;
+        assert std.array.rfind_if_not(data, func(x) = x > 2) == 5;
+        assert std.array.count_if(data, func(x) = x > 4) == 4;
+        assert std.array.exclude_if(data, func(x) = x % 2) == [ 8, 2 ];
+        assert std.array.generate(func(...) = __varg(), 3) == [ 2, 2, 2 ];
+        assert std.array.generate(func(i, p) = i + (p ?? 10), 4) == [ 10, 11, 13, 16 ];
+        assert std.array.generate(func(i, p) { return __this;  }, 2) == [ null, null ];
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
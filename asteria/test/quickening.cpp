@@ -0,0 +1,149 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/reference.hpp"
+#include "../src/value.hpp"
+#include <thread>
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Operator nodes with a constant operand shall work when the other
+        // operand changes its type.
+        func inc(x) { return x + 1;  }
+        func half(x) { return x * 0.5;  }
+        func pre(x) { return "a" + x;  }
+        func small(x) { return x < 10;  }
+
+        for(var i = 0;  i < 3;  ++i) {
+          assert inc(1) == 2;
+          assert inc(1.5) == 2.5;
+          assert half(3.0) == 1.5;
+          assert half(3) == 1.5;
+          assert pre("b") == "ab";
+          assert small(1) == true;
+          assert small(10.5) == false;
+        }
+
+        // Each operator node sees operands of various types.
+        func add(x, y) { return x + y;  }
+        func sub(x, y) { return x - y;  }
+        func mul(x, y) { return x * y;  }
+        func lt(x, y) { return x < y;  }
+        func eq(x, y) { return x == y;  }
+
+        for(var i = 0;  i < 3;  ++i) {
+          assert add(1, 2) == 3;
+          assert add(1.5, 2.0) == 3.5;
+          assert add("a", "b") == "ab";
+          assert add(1, 2.5) == 3.5;
+          assert add(true, false) == true;
+          assert sub(5, 7) == -2;
+          assert sub(5.0, 7) == -2.0;
+          assert mul(6, 7) == 42;
+          assert mul("ab", 2) == "abab";
+          assert mul(0.5, 0.5) == 0.25;
+          assert lt(1, 2) == true;
+          assert lt(2.0, 1.0) == false;
+          assert lt("a", "b") == true;
+          assert lt(1, 1.5) == true;
+          assert eq(1, 1) == true;
+          assert eq(1, 1.0) == true;
+          assert eq(nan, nan) == false;
+          assert eq("x", "x") == true;
+          assert eq(null, 0) == false;
+          assert eq([1], [1]) == true;
+        }
+
+        // Errors shall be reported by specialized forms as usual.
+        func iadd(x, y) { return x + y;  }
+        assert iadd(1, 2) == 3;
+        try {
+          iadd(0x7FFFFFFFFFFFFFFF, 1);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "overflow") != null;
+
+        func rlt(x, y) { return x < y;  }
+        assert rlt(1.0, 2.0) == true;
+        try {
+          rlt(nan, 2.0);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "not comparable") != null;
+
+        // Compound assignment operators modify their left-hand operands.
+        var s = 0;
+        var r = 0.0;
+        var t = "";
+        for(var i = 0;  i < 10;  ++i) {
+          s += i;
+          r -= 0.5;
+          t += "x";
+        }
+        assert s == 45;
+        assert r == -5.0;
+        assert t == "xxxxxxxxxx";
+
+        var u = 1;
+        for(each k, v -> [ 2, 3, 0.5, 4 ])
+          u *= v;
+        assert u == 12.0;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+
+    // Nodes may be quickened by threads that are executing the same code, with
+    // operands of different types.
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var a = __varg(0), n = 0;
+        for(var i = 0;  i < 20000;  ++i)
+          if(a + a == a * 2)
+            n += 1;
+        return n;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+
+    ::std::thread threads[6];
+    Value results[6];
+    for(size_t k = 0;  k != 6;  ++k)
+      threads[k] = ::std::thread(
+        [&, k] {
+          Global_Context tglobal;
+          cow_vector<Value> args;
+          switch(k % 3) {
+            case 0:
+              args.emplace_back(1);
+              break;
+            case 1:
+              args.emplace_back(1.5);
+              break;
+            default:
+              args.emplace_back(sref("meow"));
+              break;
+          }
+          results[k] = code.execute(tglobal, ::std::move(args)).dereference_readonly();
+        });
+
+    for(auto& thr : threads)
+      thr.join();
+    for(const auto& res : results)
+      ASTERIA_TEST_CHECK(res.as_integer() == 20000);
+  }
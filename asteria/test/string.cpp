@@ -381,6 +381,44 @@ int main()
         assert std.string.pcre_replace("a11b2c333d4e555", '(\d{3})(\w)', '$2$1') == "a11b2cd3334e555";
         assert std.string.pcre_replace("a11b2c333d4e555", '\d{34}\w', '#') == "a11b2c333d4e555";
 
+        // Cached patterns are reused.
+        for(var i = 0;  i < 100;  ++i) {
+          assert std.string.pcre_find("a11b2c333d4e555", '\d{3}\w') == [6,4];
+          assert std.string.pcre_find("a11b2c333d4e555", 3, '\d{3}\w') == [6,4];
+          assert std.string.pcre_find("a11b2c333d4e555", std.string.format('\d{$1}\w', i % 3 + 1)) != null;
+        }
+
+        var re = std.string.pcre_compile('(?<xx>\d+\w)(?<yy>22)?(?<zz>\d+\w)');
+        assert typeof re == "opaque";
+        assert std.string.pcre_find("a11b2c333d4e555", re) == [1,5];
+        assert std.string.pcre_find("a11b2c333d4e555", 5, re) == [6,6];
+        assert std.string.pcre_find("a11b2c333d4e555", 5, 3, re) == null;
+        assert std.string.pcre_match("a11b2c333d4e555", re) == [ "11b2c", "11b", null, "2c" ];
+        m = std.string.pcre_named_match("a11b2c333d4e555", re);
+        assert m.xx == "11b";
+        assert m.yy == null;
+        assert m.zz == "2c";
+        assert std.string.pcre_replace("a11b2c333d4e555", re, '#') == "a##555";
+        assert std.string.pcre_replace("a11b2c333d4e555", 6, re, '#') == "a11b2c#555";
+
+        re = std.string.pcre_compile('^B\d$', [ "caseless", "multiline" ]);
+        assert std.string.pcre_match("a1\nb2\nc3", re) == [ "b2" ];
+        assert std.string.pcre_match("a1\nb2\nc3", '^B\d$') == null;
+
+        try {
+          std.string.pcre_compile('a', [ "nonexistent" ]);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "Invalid regular expression option") != null;
+
+        try {
+          std.string.pcre_compile('(');
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "Invalid regular expression") != null;
+
 ///////////////////////////////////////////////////////////////////////////////
       )__"));
     Global_Context global;
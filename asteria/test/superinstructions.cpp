@@ -0,0 +1,86 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // local-op-constant in a loop condition, and `x += k`
+        var i = 0;
+        var sum = 0;
+        while(i < 100) {
+          sum += i;
+          i += 1;
+        }
+        assert i == 100;
+        assert sum == 4950;
+
+        // local-op-local, in a function whose body is rebound
+        func dot(n, step) {
+          var r = 0;
+          var k = 0;
+          while(k != n) {
+            if(k < step)
+              r += k;
+            else
+              r -= step;
+            k += 1;
+          }
+          return r;
+        }
+        assert dot(10, 5) == 0 + 1 + 2 + 3 + 4 - 5 * 5;
+
+        // `break` and `continue` in fused loops
+        var n = 0;
+        while(n < 1000) {
+          n += 1;
+          if(n % 2 == 0)
+            continue;
+          if(n >= 15)
+            break;
+        }
+        assert n == 15;
+
+        // comparison results remain usable as values
+        var a = 3;
+        var b = 4;
+        assert (a < b) == true;
+        assert (a <=> b) == -1;
+        var c = a * b;
+        assert c == 12;
+
+        // closures capturing operands
+        var fs = [];
+        for(var j = 0;  j < 3;  ++j) {
+          var x = j;
+          fs[j] = func() { return x * x;  };
+        }
+        assert fs[0]() == 0;
+        assert fs[1]() == 1;
+        assert fs[2]() == 4;
+
+        // errors are reported as usual
+        var big = 0x7FFFFFFFFFFFFFFF;
+        try {
+          big += 1;
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "overflow") != null;
+          assert big == 0x7FFFFFFFFFFFFFFF;
+        }
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,72 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func first(x) {
+          var r = 0;
+          switch(x) {
+            default:
+              r += 10;
+            case 1:
+              r += 1;
+              break;
+            case 3:
+              r += 3;
+          }
+          return r;
+        }
+        assert first(1) == 1;
+        assert first(3) == 3;
+        assert first(5) == 11;
+
+        func middle(x) {
+          var r = 0;
+          switch(x) {
+            case 1:
+              r += 1;
+            default:
+              r += 10;
+              break;
+            case 3:
+              r += 3;
+          }
+          return r;
+        }
+        assert middle(1) == 11;
+        assert middle(3) == 3;
+        assert middle(5) == 10;
+
+        func last(x) {
+          var r = 0;
+          switch(x) {
+            case 1:
+              r += 1;
+              break;
+            case 3:
+              r += 3;
+            default:
+              r += 10;
+          }
+          return r;
+        }
+        assert last(1) == 1;
+        assert last(3) == 13;
+        assert last(5) == 10;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    Global_Context global;
+    code.execute(global);
+  }
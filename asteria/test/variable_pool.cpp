@@ -0,0 +1,56 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2021, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../src/llds/variable_pool.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/genius_collector.hpp"
+
+using namespace asteria;
+
+int main()
+  {
+    Variable_Pool pool(3);
+    ASTERIA_TEST_CHECK(pool.empty());
+    ASTERIA_TEST_CHECK(pool.pop_opt() == nullptr);
+
+    // Variables are recycled in LIFO order.
+    auto v1 = ::rocket::make_refcnt<Variable>();
+    auto v2 = ::rocket::make_refcnt<Variable>();
+    ASTERIA_TEST_CHECK(pool.push(v1));
+    ASTERIA_TEST_CHECK(pool.push(v2));
+    ASTERIA_TEST_CHECK(v1.use_count() == 2);
+    ASTERIA_TEST_CHECK(pool.pop_opt() == v2);
+    ASTERIA_TEST_CHECK(v2.use_count() == 1);
+
+    // The pool is bounded.
+    ASTERIA_TEST_CHECK(pool.push(v2));
+    ASTERIA_TEST_CHECK(pool.push(::rocket::make_refcnt<Variable>()));
+    ASTERIA_TEST_CHECK(!pool.push(::rocket::make_refcnt<Variable>()));
+    ASTERIA_TEST_CHECK(pool.size() == 3);
+
+    // Trimming releases references.
+    pool.trim(1);
+    ASTERIA_TEST_CHECK(pool.size() == 1);
+    ASTERIA_TEST_CHECK(v1.use_count() == 2);
+    ASTERIA_TEST_CHECK(v2.use_count() == 1);
+    pool.set_limit(0);
+    ASTERIA_TEST_CHECK(pool.empty());
+    ASTERIA_TEST_CHECK(v1.use_count() == 1);
+
+    // Dead variables are reused by the collector.
+    Global_Context global;
+    auto gcoll = global.genius_collector();
+    auto var = gcoll->create_variable();
+    auto ptr = var.get();
+    var.reset();
+    gcoll->open_collector(gc_generation_newest).collect_single_opt();
+    ASTERIA_TEST_CHECK(gcoll->get_pool_size() != 0);
+    var = gcoll->create_variable();
+    ASTERIA_TEST_CHECK(var.get() == ptr);
+
+    gcoll->set_pool_limit(10);
+    ASTERIA_TEST_CHECK(gcoll->get_pool_size() <= 10);
+    gcoll->trim_pool(0);
+    ASTERIA_TEST_CHECK(gcoll->get_pool_size() == 0);
+  }